@@ -0,0 +1,121 @@
+#include "Array.h"
+#include "String.h"
+#include "VectorMap.h"
+#include "MemoryResource.h"
+
+#include <benchmark/benchmark.h>
+
+/**
+ * Create the memory resource used by a benchmark.
+ */
+template<class Resource>
+static Resource CreateResource()
+{
+	if constexpr (std::is_same_v<Resource, PoolAllocator>)
+		return PoolAllocator(256);
+	else
+		return Resource();
+}
+
+/**
+ * Release the allocations of a frame if the resource supports it.
+ *
+ * @param resource: The memory resource.
+ */
+template<class Resource>
+static void EndFrame(Resource& resource)
+{
+	if constexpr (std::is_same_v<Resource, LinearArena>)
+		resource.reset();
+}
+
+/**
+ * Create a large number of small arrays in a frame.
+ */
+template<class Resource>
+static void BM_ManySmallArrays(benchmark::State& state)
+{
+	Resource resource = CreateResource<Resource>();
+	ResourceArrayAllocator<int, alignof(int), Resource> allocator(&resource);
+
+	for (auto _ : state)
+	{
+		for (int outer = 0; outer < 256; outer++)
+		{
+			Array<int, 1, ResourceArrayAllocator<int, alignof(int), Resource>> array(allocator);
+			for (int index = 0; index < 16; index++)
+				array.pushBack(outer + index);
+
+			benchmark::DoNotOptimize(array.begin());
+		}
+
+		EndFrame(resource);
+	}
+
+	state.SetItemsProcessed(state.iterations() * 256);
+}
+
+BENCHMARK_TEMPLATE(BM_ManySmallArrays, DefaultMemoryResource);
+BENCHMARK_TEMPLATE(BM_ManySmallArrays, LinearArena);
+BENCHMARK_TEMPLATE(BM_ManySmallArrays, PoolAllocator);
+BENCHMARK_TEMPLATE(BM_ManySmallArrays, ThreadLocalCacheAllocator);
+
+/**
+ * Build a large number of short strings in a frame.
+ */
+template<class Resource>
+static void BM_ManyStrings(benchmark::State& state)
+{
+	Resource resource = CreateResource<Resource>();
+
+	for (auto _ : state)
+	{
+		for (int index = 0; index < 256; index++)
+		{
+			String string(TEXT("entity_"), &resource);
+			string += TEXT("transform");
+			string += TEXT(".position");
+
+			benchmark::DoNotOptimize(string.str());
+		}
+
+		EndFrame(resource);
+	}
+
+	state.SetItemsProcessed(state.iterations() * 256);
+}
+
+BENCHMARK_TEMPLATE(BM_ManyStrings, DefaultMemoryResource);
+BENCHMARK_TEMPLATE(BM_ManyStrings, LinearArena);
+BENCHMARK_TEMPLATE(BM_ManyStrings, PoolAllocator);
+BENCHMARK_TEMPLATE(BM_ManyStrings, ThreadLocalCacheAllocator);
+
+/**
+ * Build and tear down a vector map in a frame.
+ */
+template<class Resource>
+static void BM_VectorMapInsert(benchmark::State& state)
+{
+	using Map = VectorMap<int, int, std::less<int>, ResourceAllocator<std::pair<const int, int>, Resource>>;
+	Resource resource = CreateResource<Resource>();
+
+	for (auto _ : state)
+	{
+		{
+			Map map{ typename Map::allocator_type(&resource) };
+			for (int index = 0; index < 1024; index++)
+				map[(index * 7919) & 1023] = index;
+
+			benchmark::DoNotOptimize(map.begin());
+		}
+
+		EndFrame(resource);
+	}
+
+	state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+BENCHMARK_TEMPLATE(BM_VectorMapInsert, DefaultMemoryResource);
+BENCHMARK_TEMPLATE(BM_VectorMapInsert, LinearArena);
+BENCHMARK_TEMPLATE(BM_VectorMapInsert, PoolAllocator);
+BENCHMARK_TEMPLATE(BM_VectorMapInsert, ThreadLocalCacheAllocator);
@@ -1,8 +1,22 @@
 #pragma once
 #include <memory>
+#include <cstring>
+#include <utility>
 #include <type_traits>
 #include <initializer_list>
 
+#include "ArrayKernels.h"
+
+/**
+ * Check if a type can be relocated (moved to a new address and the old object discarded) using a simple memcpy.
+ * This is true for all trivially copyable types. Types which are known to be safe to relocate bitwise (for
+ * example types which only hold owning pointers) can specialize this to enable the fast path.
+ *
+ * @tparam Type: The type to be checked.
+ */
+template<class Type>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<Type> {};
+
 /**
  * Array allocator for the dynamic array.
  *
@@ -11,6 +25,8 @@
  */
 template<class Type, size_t Alignment>
 class ArrayAllocator {
+	static_assert(Alignment && (Alignment & (Alignment - 1)) == 0, "The alignment must be a power of two!");
+
 public:
 	/**
 	 * Default constructor.
@@ -35,27 +51,94 @@ public:
 
 	/**
 	 * Destroy an allocated block of memory.
-	 * This automatically calls the destructor of all the stored elements.
+	 * This does not call the destructors of the stored elements. They must be destroyed before calling this.
 	 *
 	 * @param pBlock: The block to be deallocated.
+	 * @param byteSize: The size of the block in bytes. This is not required by this allocator.
 	 */
-	static constexpr void DestroyBlock(Type* pBlock)
+	static constexpr void DestroyBlock(Type* pBlock, size_t /*byteSize*/ = 0)
 	{
 		operator delete[](static_cast<void*>(pBlock), std::align_val_t{ Alignment });
 	}
 };
 
+/**
+ * Geometric growth policy for the dynamic array.
+ * The capacity is multiplied by Numerator / Denominator every time the array runs out of space, which makes
+ * appending elements amortized O(1).
+ *
+ * @tparam Numerator: The numerator of the growth factor.
+ * @tparam Denominator: The denominator of the growth factor.
+ */
+template<size_t Numerator, size_t Denominator>
+struct GeometricGrowthPolicy {
+	static_assert(Numerator > Denominator, "The growth factor must be greater than 1!");
+
+	/**
+	 * Calculate the new capacity.
+	 *
+	 * @param capacity: The current capacity.
+	 * @param requiredCapacity: The minimum capacity needed.
+	 * @param sizeBias: The minimum number of slots to be allocated at a single instance.
+	 */
+	static constexpr size_t Calculate(size_t capacity, size_t requiredCapacity, size_t sizeBias)
+	{
+		size_t newCapacity = (capacity / Denominator) * Numerator + ((capacity % Denominator) * Numerator) / Denominator;
+
+		// Make sure that we allocate at least the size bias.
+		if (newCapacity < sizeBias)
+			newCapacity = sizeBias;
+
+		return newCapacity < requiredCapacity ? requiredCapacity : newCapacity;
+	}
+};
+
+/**
+ * Growth policy which grows the capacity by 1.5x.
+ */
+using GrowthPolicy1_5x = GeometricGrowthPolicy<3, 2>;
+
+/**
+ * Growth policy which doubles the capacity.
+ */
+using GrowthPolicy2x = GeometricGrowthPolicy<2, 1>;
+
+/**
+ * Fixed chunk growth policy for the dynamic array.
+ * The capacity is rounded up to the next multiple of the size bias. This keeps the memory overhead bounded but
+ * appending is O(n / SizeBias) per element.
+ */
+struct ChunkGrowthPolicy {
+	/**
+	 * Calculate the new capacity.
+	 *
+	 * @param capacity: The current capacity.
+	 * @param requiredCapacity: The minimum capacity needed.
+	 * @param sizeBias: The chunk size.
+	 */
+	static constexpr size_t Calculate(size_t /*capacity*/, size_t requiredCapacity, size_t sizeBias)
+	{
+		if (!sizeBias)
+			return requiredCapacity;
+
+		return ((requiredCapacity + sizeBias - 1) / sizeBias) * sizeBias;
+	}
+};
+
 /**
  * A simple dynamic array.
  *
  * @tparam Type: The type of the data stored in the array.
  * @tparam SizeBias: The number of slots to be allocated at a single instance.
- * @tparam Allocator: A custom allocator based on the ArrayAllocator class to allocate memory.
+ * @tparam Allocator: A custom allocator based on the ArrayAllocator class to allocate memory. The allocator is stored in
+ *	the array, so stateful allocators (like the ResourceArrayAllocator) can be used.
+ * @tparam GrowthPolicy: The policy used to calculate the new capacity when the array is full. Default is GrowthPolicy1_5x.
  */
-template<class Type, size_t SizeBias = 1, class Allocator = ArrayAllocator<Type, sizeof(Type)>>
-class Array {
+template<class Type, size_t SizeBias = 1, class Allocator = ArrayAllocator<Type, alignof(Type)>, class GrowthPolicy = GrowthPolicy1_5x>
+class Array : private Allocator // Empty base optimization
+{
 	// Check if the input template arguments are valid.
-	static_assert(!std::is_same<Type, Allocator>::value, "Invalid template arguments! Template parameters are Array<Type, SizeBias, Allocator>.");
+	static_assert(!std::is_same<Type, Allocator>::value, "Invalid template arguments! Template parameters are Array<Type, SizeBias, Allocator, GrowthPolicy>.");
 
 public:
 	/**
@@ -63,13 +146,20 @@ public:
 	 */
 	Array() : pBegin(nullptr), pNext(nullptr), pEnd(nullptr) {}
 
+	/**
+	 * Construct the array using an allocator.
+	 *
+	 * @param allocator: The allocator to allocate memory with.
+	 */
+	explicit Array(const Allocator& allocator) : Allocator(allocator), pBegin(nullptr), pNext(nullptr), pEnd(nullptr) {}
+
 	/**
 	 * Construct the array using another array (copy).
 	 *
 	 * @param other: The other array.
 	 */
-	Array(const Array<Type, SizeBias, Allocator>& other)
-		: pBegin(nullptr), pNext(nullptr), pEnd(nullptr)
+	Array(const Array<Type, SizeBias, Allocator, GrowthPolicy>& other)
+		: Allocator(other), pBegin(nullptr), pNext(nullptr), pEnd(nullptr)
 	{
 		// Check if the other array has data in it.
 		if (!other.size())
@@ -91,8 +181,8 @@ public:
 	 *
 	 * @param other: The other array.
 	 */
-	Array(Array<Type, SizeBias, Allocator>&& other)
-		: pBegin(nullptr), pNext(nullptr), pEnd(nullptr)
+	Array(Array<Type, SizeBias, Allocator, GrowthPolicy>&& other)
+		: Allocator(static_cast<Allocator&&>(other)), pBegin(nullptr), pNext(nullptr), pEnd(nullptr)
 	{
 		// Check if the other array has data in it.
 		if (!other.size())
@@ -115,9 +205,10 @@ public:
 	 *
 	 * @param size: The number of elements to be stored.
 	 * @param value: The value to initialize the elements with. Default is Type().
+	 * @param allocator: The allocator to allocate memory with. Default is Allocator().
 	 */
-	Array(size_t size, const Type& value = Type())
-		: pBegin(nullptr), pNext(nullptr), pEnd(nullptr)
+	Array(size_t size, const Type& value = Type(), const Allocator& allocator = Allocator())
+		: Allocator(allocator), pBegin(nullptr), pNext(nullptr), pEnd(nullptr)
 	{
 		// Check if the size is valid.
 		if (!size)
@@ -138,9 +229,10 @@ public:
 	 * Construct the array using an initializer list.
 	 *
 	 * @param list: The initializer list.
+	 * @param allocator: The allocator to allocate memory with. Default is Allocator().
 	 */
-	Array(std::initializer_list<Type> list)
-		: pBegin(nullptr), pNext(nullptr), pEnd(nullptr)
+	Array(std::initializer_list<Type> list, const Allocator& allocator = Allocator())
+		: Allocator(allocator), pBegin(nullptr), pNext(nullptr), pEnd(nullptr)
 	{
 		// Check if the initializer list contains data.
 		if (!list.size())
@@ -627,27 +719,35 @@ public:
 public:
 	/**
 	 * Extend the array by a certain size.
+	 * The new capacity is calculated using the growth policy so it will be able to store at least size more
+	 * elements.
 	 *
 	 * @param size: The size to be extended (element count). Default is SizeBias.
 	 */
 	void extend(size_t size = SizeBias)
 	{
-		// Create a new block to fit the required size.
-		size_t newCapacity = getNewCapacity(size);
-
-		// Allocate a new block.
-		Type* pBlock = Allocator::CreateNewBlock(typeSize() * newCapacity);
-
-		// Move existing data to the new block.
-		moveBlock(pBlock, pBegin, pNext);
+		reallocate(getNewCapacity(size));
+	}
 
-		// Clear the existing data.
-		clear();
+	/**
+	 * Reserve memory to store a number of elements.
+	 * This does nothing if the capacity is already large enough.
+	 *
+	 * @param count: The number of elements to reserve memory for.
+	 */
+	void reserve(size_t count)
+	{
+		if (count > capacity())
+			reallocate(count);
+	}
 
-		// Assign pointers.
-		pBegin = pBlock;
-		pNext = pBegin + (newCapacity - size);
-		pEnd = pBegin + newCapacity;
+	/**
+	 * Release the unused capacity of the array.
+	 */
+	void shrinkToFit()
+	{
+		if (pNext != pEnd)
+			reallocate(size());
 	}
 
 	/**
@@ -657,13 +757,7 @@ public:
 	 */
 	void pushBack(const Type& value)
 	{
-		// Check if the allocated block is full. 
-		if (pNext == pEnd)
-			extend();
-
-		// Assign data to the array.
-		*pNext = value;
-		pNext++;
+		emplaceBack(value);
 	}
 
 	/**
@@ -673,7 +767,31 @@ public:
 	 */
 	void pushBack(Type&& value)
 	{
-		pushBack(static_cast<const Type&>(value));
+		emplaceBack(std::move(value));
+	}
+
+	/**
+	 * Construct an element in place at the end of the array.
+	 *
+	 * @param arguments: The arguments to be passed to the constructor of the element.
+	 * @return: The newly constructed element.
+	 */
+	template<class... Arguments>
+	Type& emplaceBack(Arguments&&... arguments)
+	{
+		// Check if the allocated block is full. 
+		if (pNext == pEnd)
+		{
+			// The arguments might refer to an element in this array, so construct the element before reallocating.
+			Type value(std::forward<Arguments>(arguments)...);
+			extend();
+
+			new (pNext) Type(std::move(value));
+		}
+		else
+			new (pNext) Type(std::forward<Arguments>(arguments)...);
+
+		return *(pNext++);
 	}
 
 	/**
@@ -681,7 +799,13 @@ public:
 	 */
 	Type popBack()
 	{
-		return *(pNext--);
+		pNext--;
+
+		// Move the value out before destroying the element.
+		Type retValue = std::move(*pNext);
+		pNext->~Type();
+
+		return retValue;
 	}
 
 	/**
@@ -691,16 +815,7 @@ public:
 	 */
 	void pushFront(const Type& value)
 	{
-		// Check if the allocated block is full. 
-		if (pNext == pEnd)
-			extend();
-
-		// Move the array one block to the back to override the first element.
-		moveBlock(pBegin + 1, pBegin, pNext);
-
-		// Assign the value and increment the pointer.
-		pBegin[0] = value;
-		pNext++;
+		pushFront(Type(value));
 	}
 
 	/**
@@ -710,7 +825,24 @@ public:
 	 */
 	void pushFront(Type&& value)
 	{
-		pushFront(value);
+		// Check if the allocated block is full. 
+		if (pNext == pEnd)
+		{
+			// The value might be an element in this array, so take it out before reallocating.
+			Type temporary(std::move(value));
+			extend();
+
+			moveBlock(pBegin + 1, pBegin, pNext);
+			new (pBegin) Type(std::move(temporary));
+		}
+		else
+		{
+			// Move the array one block to the back to free the first element.
+			moveBlock(pBegin + 1, pBegin, pNext);
+			new (pBegin) Type(std::move(value));
+		}
+
+		pNext++;
 	}
 
 	/**
@@ -718,8 +850,9 @@ public:
 	 */
 	Type popFront()
 	{
-		// Get the first value before overriding it.
-		Type retValue = pBegin[0];
+		// Get the first value before destroying it.
+		Type retValue = std::move(pBegin[0]);
+		pBegin->~Type();
 
 		// Move the whole array one block back.
 		moveBlock(pBegin, pBegin + 1, pNext);
@@ -736,14 +869,9 @@ public:
 	 */
 	void clear()
 	{
-		// Terminate the block if already allocated.
-		if (pBegin)
-			Allocator::DestroyBlock(pBegin);
-
-		// Reset pointers.
-		pBegin = nullptr;
-		pNext = nullptr;
-		pEnd = nullptr;
+		// Destroy the stored elements and release the memory.
+		destroyBlock(pBegin, pNext);
+		releaseBlock();
 	}
 
 	/**
@@ -834,15 +962,31 @@ public:
 	 */
 	size_t find(const Type& value) const
 	{
-		// Iterate through the array to find the required value.
-		for (size_t index = 0; index < size(); index++)
-			if (pBegin[index] == value)
-				return index;
+		// Use the vectorized kernels for arithmetic types.
+		if constexpr (ArrayKernels::IsVectorizable<Type>)
+		{
+			const size_t index = ArrayKernels::Find(pBegin, size(), value);
+			return index == size() ? -1 : index;
+		}
+		else
+		{
+			// Iterate through the array to find the required value.
+			for (size_t index = 0; index < size(); index++)
+				if (pBegin[index] == value)
+					return index;
 
-		// Return if not found.
-		return -1;
+			// Return if not found.
+			return -1;
+		}
 	}
 
+	/**
+	 * Check if a value is present in the array.
+	 *
+	 * @param value: The value to be checked.
+	 */
+	bool contains(const Type& value) const { return find(value) != static_cast<size_t>(-1); }
+
 	/**
 	 * Return the memory location of a given index.
 	 *
@@ -865,17 +1009,54 @@ public:
 	 */
 	size_t occurence(const Type& value) const
 	{
+		// Use the vectorized kernels for arithmetic types.
+		if constexpr (ArrayKernels::IsVectorizable<Type>)
+			return ArrayKernels::Count(pBegin, size(), value);
+
 		size_t occur = 0;
 
 		// Iterate throught the array to find the occurances.
-		Type* itr = begin();
-		while (itr != end())
+		for (const Type* itr = begin(); itr != end(); itr++)
 			if (*itr == value)
 				occur++;
 
 		return occur;
 	}
 
+	/**
+	 * Get the smallest element of the array. The array must not be empty.
+	 */
+	Type min() const
+	{
+		if constexpr (ArrayKernels::IsVectorizable<Type>)
+			return ArrayKernels::Min(pBegin, size());
+		else
+			return ArrayKernels::Scalar::Min(pBegin, size());
+	}
+
+	/**
+	 * Get the largest element of the array. The array must not be empty.
+	 */
+	Type max() const
+	{
+		if constexpr (ArrayKernels::IsVectorizable<Type>)
+			return ArrayKernels::Max(pBegin, size());
+		else
+			return ArrayKernels::Scalar::Max(pBegin, size());
+	}
+
+	/**
+	 * Get the sum of all the elements in the array.
+	 * Integer sums wrap around on overflow. An empty array returns a default constructed value.
+	 */
+	Type sum() const
+	{
+		if constexpr (ArrayKernels::IsVectorizable<Type>)
+			return ArrayKernels::Sum(pBegin, size());
+		else
+			return ArrayKernels::Scalar::Sum(pBegin, size());
+	}
+
 public:
 	/**
 	 * Get the type size in bytes.
@@ -892,16 +1073,31 @@ public:
 	 */
 	const size_t capacity() const noexcept { return pEnd - pBegin; }
 
+	/**
+	 * Get the allocator of the array.
+	 */
+	const Allocator& getAllocator() const noexcept { return *this; }
+
 	/**
 	 * Get the maximum allocatable capacity of the array.
 	 */
 	constexpr size_t maximumCapacity() const { return -1; }
 
+	/**
+	 * Begin iterator of the array.
+	 */
+	Type* begin() noexcept { return pBegin; }
+
 	/**
 	 * Begin iterator of the array.
 	 */
 	const Type* begin() const noexcept { return pBegin; }
 
+	/**
+	 * End iterator of the array.
+	 */
+	Type* end() noexcept { return pNext; }
+
 	/**
 	 * End iterator of the array.
 	 */
@@ -958,15 +1154,19 @@ public:
 	 *
 	 * @param other: The other array.
 	 */
-	Array<Type, SizeBias, Allocator>& operator=(const Array<Type, SizeBias, Allocator>& other)
+	Array<Type, SizeBias, Allocator, GrowthPolicy>& operator=(const Array<Type, SizeBias, Allocator, GrowthPolicy>& other)
 	{
-		// Check if the other array has data in it.
-		if (!other.size())
-			return;
+		// Check if we are assigning to ourselves.
+		if (this == &other)
+			return *this;
 
 		// Clear the array if already allocated.
 		clear();
 
+		// Check if the other array has data in it.
+		if (!other.size())
+			return *this;
+
 		// Create a new memory block.
 		pBegin = Allocator::CreateNewBlock(typeSize() * other.size());
 
@@ -985,15 +1185,18 @@ public:
 	 *
 	 * @param other: The other array.
 	 */
-	Array<Type, SizeBias, Allocator>& operator=(Array<Type, SizeBias, Allocator>&& other)
+	Array<Type, SizeBias, Allocator, GrowthPolicy>& operator=(Array<Type, SizeBias, Allocator, GrowthPolicy>&& other)
 	{
-		// Check if the other array has data in it.
-		if (!other.size())
-			return;
+		// Check if we are assigning to ourselves.
+		if (this == &other)
+			return *this;
 
 		// Clear the array if already allocated.
 		clear();
 
+		// Take the other array's allocator along with its memory.
+		static_cast<Allocator&>(*this) = static_cast<Allocator&>(other);
+
 		// Copy contents of the other array.
 		pBegin = other.pBegin;
 		pNext = other.pNext;
@@ -1012,15 +1215,15 @@ public:
 	 *
 	 * @param list: The initializer list.
 	 */
-	Array<Type, SizeBias, Allocator>& operator=(std::initializer_list<Type> list)
+	Array<Type, SizeBias, Allocator, GrowthPolicy>& operator=(std::initializer_list<Type> list)
 	{
-		// Check if the initializer list contains data.
-		if (!list.size())
-			return;
-
 		// Clear the array if already allocated.
 		clear();
 
+		// Check if the initializer list contains data.
+		if (!list.size())
+			return *this;
+
 		// Create a new memory block.
 		pBegin = Allocator::CreateNewBlock(typeSize() * list.size());
 
@@ -1039,7 +1242,7 @@ public:
 	 *
 	 * @param other: The other array.
 	 */
-	bool operator==(const Array<Type, SizeBias, Allocator>& other)
+	bool operator==(const Array<Type, SizeBias, Allocator, GrowthPolicy>& other)
 	{
 		// Check if the sizes match. 
 		if (other.size() != size())
@@ -1056,18 +1259,29 @@ public:
 private:
 	/**
 	 * Copy a block of data from one address to another using the pointer range of the source.
+	 * The destination must be uninitialized memory.
 	 *
 	 * @param pDst: The destination address.
 	 * @param pSrcBegin: The begin address of the memory block.
 	 * @param pSrcEnd: The end address of the memory block.
 	 */
-	void copyBlock(Type* pDst, Type* pSrcBegin, Type* pSrcEnd)
+	void copyBlock(Type* pDst, const Type* pSrcBegin, const Type* pSrcEnd)
 	{
-		std::memcpy(pDst, pSrcBegin, (pSrcEnd - pSrcBegin) * typeSize());
+		if constexpr (std::is_trivially_copyable_v<Type>)
+		{
+			if (pSrcBegin != pSrcEnd)
+				std::memcpy(pDst, pSrcBegin, (pSrcEnd - pSrcBegin) * typeSize());
+		}
+		else
+		{
+			while (pSrcBegin != pSrcEnd) new (pDst) Type(*pSrcBegin), pDst++, pSrcBegin++;
+		}
 	}
 
 	/**
-	 * Move a block of data from one address to another using the pointer range of the source.
+	 * Relocate a block of data from one address to another using the pointer range of the source.
+	 * The destination must be uninitialized memory (apart from the overlapping region) and the source elements are
+	 * destroyed after this. The two ranges are allowed to overlap.
 	 *
 	 * @param pDst: The destination address.
 	 * @param pSrcBegin: The begin address of the memory block.
@@ -1075,11 +1289,36 @@ private:
 	 */
 	void moveBlock(Type* pDst, Type* pSrcBegin, Type* pSrcEnd)
 	{
-		std::memmove(pDst, pSrcBegin, (pSrcEnd - pSrcBegin) * typeSize());
+		if constexpr (IsTriviallyRelocatable<Type>::value)
+		{
+			if (pSrcBegin != pSrcEnd)
+				std::memmove(pDst, pSrcBegin, (pSrcEnd - pSrcBegin) * typeSize());
+		}
+		else if (pDst < pSrcBegin)
+		{
+			// Move forward so that we do not override elements which are not yet moved.
+			for (; pSrcBegin != pSrcEnd; pDst++, pSrcBegin++)
+			{
+				new (pDst) Type(std::move(*pSrcBegin));
+				pSrcBegin->~Type();
+			}
+		}
+		else if (pDst > pSrcBegin)
+		{
+			// Move backward so that we do not override elements which are not yet moved.
+			pDst += pSrcEnd - pSrcBegin;
+			while (pSrcEnd != pSrcBegin)
+			{
+				pDst--, pSrcEnd--;
+				new (pDst) Type(std::move(*pSrcEnd));
+				pSrcEnd->~Type();
+			}
+		}
 	}
 
 	/**
 	 * Initialize a block of memory with a value.
+	 * The destination must be uninitialized memory.
 	 *
 	 * @param pDst: The destination address.
 	 * @param value: The value to be initialized with.
@@ -1087,7 +1326,35 @@ private:
 	 */
 	void initializeBlock(Type* pDst, const Type& value, size_t count)
 	{
-		while (count--) *pDst = value, pDst++;
+		while (count--) new (pDst) Type(value), pDst++;
+	}
+
+	/**
+	 * Call the destructors of a range of elements.
+	 * This does nothing for trivially destructible types.
+	 *
+	 * @param pBlockBegin: The first element to be destroyed.
+	 * @param pBlockEnd: The end of the range.
+	 */
+	void destroyBlock(Type* pBlockBegin, Type* pBlockEnd)
+	{
+		if constexpr (!std::is_trivially_destructible_v<Type>)
+			while (pBlockBegin != pBlockEnd) pBlockBegin->~Type(), pBlockBegin++;
+	}
+
+	/**
+	 * Release the memory block without destroying the elements.
+	 */
+	void releaseBlock()
+	{
+		// Terminate the block if already allocated.
+		if (pBegin)
+			Allocator::DestroyBlock(pBegin, typeSize() * capacity());
+
+		// Reset pointers.
+		pBegin = nullptr;
+		pNext = nullptr;
+		pEnd = nullptr;
 	}
 
 	/**
@@ -1095,9 +1362,38 @@ private:
 	 *
 	 * @param newElementCount: The number of new elements.
 	 */
-	size_t getNewCapacity(size_t newElementCount)
+	size_t getNewCapacity(size_t newElementCount) const
 	{
-		return capacity() + newElementCount; // TODO
+		return GrowthPolicy::Calculate(capacity(), size() + newElementCount, SizeBias);
+	}
+
+	/**
+	 * Move the stored elements to a new block with a given capacity.
+	 *
+	 * @param newCapacity: The capacity of the new block. This must not be less than the size.
+	 */
+	void reallocate(size_t newCapacity)
+	{
+		const size_t count = size();
+
+		// Clear the array if there is nothing to be stored.
+		if (!newCapacity)
+		{
+			clear();
+			return;
+		}
+
+		// Allocate a new block.
+		Type* pBlock = Allocator::CreateNewBlock(typeSize() * newCapacity);
+
+		// Move existing data to the new block and release the old one.
+		moveBlock(pBlock, pBegin, pNext);
+		releaseBlock();
+
+		// Assign pointers.
+		pBegin = pBlock;
+		pNext = pBegin + count;
+		pEnd = pBegin + newCapacity;
 	}
 
 private:
@@ -0,0 +1,119 @@
+#include "Array.h"
+
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+/**
+ * Push back a number of elements to an array with a given growth policy.
+ * The complexity is reported per element count, so a linear result means that pushBack is amortized O(1).
+ */
+template<class GrowthPolicy, size_t SizeBias = 1>
+static void BM_ArrayPushBack(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		Array<int, SizeBias, ArrayAllocator<int, sizeof(int)>, GrowthPolicy> array;
+		for (size_t index = 0; index < count; index++)
+			array.pushBack(static_cast<int>(index));
+
+		benchmark::DoNotOptimize(array.begin());
+	}
+
+	state.SetComplexityN(state.range(0));
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_ArrayPushBack, GrowthPolicy1_5x)->RangeMultiplier(10)->Range(10, 10'000'000)->Complexity(benchmark::oN);
+BENCHMARK_TEMPLATE(BM_ArrayPushBack, GrowthPolicy2x)->RangeMultiplier(10)->Range(10, 10'000'000)->Complexity(benchmark::oN);
+BENCHMARK_TEMPLATE(BM_ArrayPushBack, ChunkGrowthPolicy, 1024)->RangeMultiplier(10)->Range(10, 100'000)->Complexity();
+
+/**
+ * Push back to an array which has reserved its memory beforehand.
+ */
+static void BM_ArrayPushBackReserved(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		Array<int> array;
+		array.reserve(count);
+
+		for (size_t index = 0; index < count; index++)
+			array.pushBack(static_cast<int>(index));
+
+		benchmark::DoNotOptimize(array.begin());
+	}
+
+	state.SetComplexityN(state.range(0));
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ArrayPushBackReserved)->RangeMultiplier(10)->Range(10, 10'000'000)->Complexity(benchmark::oN);
+
+/**
+ * The standard vector for reference.
+ */
+static void BM_VectorPushBack(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		std::vector<int> vector;
+		for (size_t index = 0; index < count; index++)
+			vector.push_back(static_cast<int>(index));
+
+		benchmark::DoNotOptimize(vector.data());
+	}
+
+	state.SetComplexityN(state.range(0));
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_VectorPushBack)->RangeMultiplier(10)->Range(10, 10'000'000)->Complexity(benchmark::oN);
+
+/**
+ * Push back strings which are built as a temporary and then moved into the array.
+ */
+static void BM_ArrayPushBackString(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		Array<std::string> array;
+		for (size_t index = 0; index < count; index++)
+			array.pushBack(std::string(32, 'x'));
+
+		benchmark::DoNotOptimize(array.begin());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ArrayPushBackString)->RangeMultiplier(10)->Range(10, 1'000'000);
+
+/**
+ * Construct the strings in place.
+ */
+static void BM_ArrayEmplaceBackString(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		Array<std::string> array;
+		for (size_t index = 0; index < count; index++)
+			array.emplaceBack(32, 'x');
+
+		benchmark::DoNotOptimize(array.begin());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ArrayEmplaceBackString)->RangeMultiplier(10)->Range(10, 1'000'000);
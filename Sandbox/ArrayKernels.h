@@ -0,0 +1,974 @@
+#pragma once
+#include "SIMD.h"
+
+#include <type_traits>
+
+/**
+ * Vectorized search, counting and reduction kernels used by the Array for arithmetic element types, and the sorted
+ * search used by the IntegralVectorMap.
+ * Every kernel has a scalar version and SSE4.2, AVX2 and AVX-512 versions which are selected at runtime.
+ *
+ * Floating point comparisons follow the IEEE rules (NaN is never equal to anything), and the results of Min and Max
+ * are unspecified if the data contains NaNs. Integer sums wrap around on overflow.
+ */
+namespace ArrayKernels {
+	/**
+	 * Check if a type can be processed by the vectorized kernels.
+	 */
+	template<class Type>
+	constexpr bool IsVectorizable = (std::is_integral_v<Type> && !std::is_same_v<Type, bool> && (sizeof(Type) == 1 || sizeof(Type) == 2 || sizeof(Type) == 4 || sizeof(Type) == 8))
+		|| std::is_same_v<Type, float> || std::is_same_v<Type, double>;
+
+	namespace Scalar {
+		/**
+		 * Find the index of the first element which is equal to a value.
+		 * Returns count if the value is not found.
+		 *
+		 * @param pData: The elements.
+		 * @param count: The number of elements.
+		 * @param value: The value to be searched for.
+		 */
+		template<class Type>
+		size_t Find(const Type* pData, size_t count, const Type& value)
+		{
+			for (size_t index = 0; index < count; index++)
+				if (pData[index] == value)
+					return index;
+
+			return count;
+		}
+
+		/**
+		 * Count the number of elements which are equal to a value.
+		 *
+		 * @param pData: The elements.
+		 * @param count: The number of elements.
+		 * @param value: The value to be counted.
+		 */
+		template<class Type>
+		size_t Count(const Type* pData, size_t count, const Type& value)
+		{
+			size_t occurences = 0;
+			for (size_t index = 0; index < count; index++)
+				if (pData[index] == value)
+					occurences++;
+
+			return occurences;
+		}
+
+		/**
+		 * Get the smallest element. The count must not be 0.
+		 *
+		 * @param pData: The elements.
+		 * @param count: The number of elements.
+		 */
+		template<class Type>
+		Type Min(const Type* pData, size_t count)
+		{
+			Type result = pData[0];
+			for (size_t index = 1; index < count; index++)
+				if (pData[index] < result)
+					result = pData[index];
+
+			return result;
+		}
+
+		/**
+		 * Get the largest element. The count must not be 0.
+		 *
+		 * @param pData: The elements.
+		 * @param count: The number of elements.
+		 */
+		template<class Type>
+		Type Max(const Type* pData, size_t count)
+		{
+			Type result = pData[0];
+			for (size_t index = 1; index < count; index++)
+				if (result < pData[index])
+					result = pData[index];
+
+			return result;
+		}
+
+		/**
+		 * Get the sum of the elements.
+		 *
+		 * @param pData: The elements.
+		 * @param count: The number of elements.
+		 */
+		template<class Type>
+		Type Sum(const Type* pData, size_t count)
+		{
+			Type result = Type();
+			for (size_t index = 0; index < count; index++)
+				result += pData[index];
+
+			return result;
+		}
+
+		/**
+		 * Find the index of the first element which is not less than a value, in sorted elements.
+		 * The search halves the range without branching on the comparison, so the compiler can use conditional moves.
+		 *
+		 * @param pData: The elements, sorted in ascending order.
+		 * @param count: The number of elements.
+		 * @param value: The value.
+		 */
+		template<class Type>
+		size_t LowerBound(const Type* pData, size_t count, const Type& value)
+		{
+			if (count == 0)
+				return 0;
+
+			const Type* pBase = pData;
+			for (size_t length = count; length > 1; )
+			{
+				const size_t half = length / 2;
+				pBase = pBase[half] < value ? pBase + half : pBase;
+				length -= half;
+			}
+
+			return (pBase - pData) + (*pBase < value);
+		}
+	}
+
+#ifdef SIMD_X86
+	SIMD_BEGIN_TARGET_SSE42
+
+	/**
+	 * SSE4.2 kernels. Comparisons produce one mask bit per byte.
+	 */
+	namespace SSE42 {
+		using Register = __m128i;
+		constexpr size_t Width = 16;
+
+		/**
+		 * Load a register from unaligned memory.
+		 */
+		template<class Type>
+		inline Register Load(const Type* pData) { return _mm_loadu_si128(reinterpret_cast<const Register*>(pData)); }
+
+		/**
+		 * Set all the lanes of a register to a value.
+		 */
+		template<class Type>
+		inline Register Broadcast(Type value)
+		{
+			if constexpr (std::is_same_v<Type, float>) return _mm_castps_si128(_mm_set1_ps(value));
+			else if constexpr (std::is_same_v<Type, double>) return _mm_castpd_si128(_mm_set1_pd(value));
+			else if constexpr (sizeof(Type) == 1) return _mm_set1_epi8(static_cast<char>(value));
+			else if constexpr (sizeof(Type) == 2) return _mm_set1_epi16(static_cast<short>(value));
+			else if constexpr (sizeof(Type) == 4) return _mm_set1_epi32(static_cast<int>(value));
+			else return _mm_set1_epi64x(static_cast<long long>(value));
+		}
+
+		/**
+		 * Compare the lanes for equality and return a mask with one bit per byte.
+		 */
+		template<class Type>
+		inline uint32_t EqualMask(Register a, Register b)
+		{
+			Register result;
+			if constexpr (std::is_same_v<Type, float>) { const auto a_ps = _mm_castsi128_ps(a), b_ps = _mm_castsi128_ps(b); result = _mm_castps_si128(_mm_cmpeq_ps(a_ps, b_ps)); }
+			else if constexpr (std::is_same_v<Type, double>) { const auto a_pd = _mm_castsi128_pd(a), b_pd = _mm_castsi128_pd(b); result = _mm_castpd_si128(_mm_cmpeq_pd(a_pd, b_pd)); }
+			else if constexpr (sizeof(Type) == 1) result = _mm_cmpeq_epi8(a, b);
+			else if constexpr (sizeof(Type) == 2) result = _mm_cmpeq_epi16(a, b);
+			else if constexpr (sizeof(Type) == 4) result = _mm_cmpeq_epi32(a, b);
+			else result = _mm_cmpeq_epi64(a, b);
+
+			return static_cast<uint32_t>(_mm_movemask_epi8(result));
+		}
+
+		/**
+		 * Compare the lanes of two integer registers (a < b) and return a mask with one bit per byte.
+		 */
+		template<class Type>
+		inline uint32_t LessMask(Register a, Register b)
+		{
+			// The comparisons are signed, so flip the sign bits of unsigned types.
+			if constexpr (std::is_unsigned_v<Type>)
+			{
+				const Register bias = Broadcast(static_cast<Type>(Type(1) << (sizeof(Type) * 8 - 1)));
+				a = _mm_xor_si128(a, bias);
+				b = _mm_xor_si128(b, bias);
+			}
+
+			Register result;
+			if constexpr (sizeof(Type) == 1) result = _mm_cmpgt_epi8(b, a);
+			else if constexpr (sizeof(Type) == 2) result = _mm_cmpgt_epi16(b, a);
+			else if constexpr (sizeof(Type) == 4) result = _mm_cmpgt_epi32(b, a);
+			else result = _mm_cmpgt_epi64(b, a);
+
+			return static_cast<uint32_t>(_mm_movemask_epi8(result));
+		}
+
+		/**
+		 * Get the lane wise minimum or maximum of two registers.
+		 */
+		template<class Type, bool Maximum>
+		inline Register Select(Register a, Register b)
+		{
+			if constexpr (std::is_same_v<Type, float>) return Maximum ? _mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b))) : _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+			else if constexpr (std::is_same_v<Type, double>) return Maximum ? _mm_castpd_si128(_mm_max_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))) : _mm_castpd_si128(_mm_min_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+			else if constexpr (sizeof(Type) == 1 && std::is_signed_v<Type>) return Maximum ? _mm_max_epi8(a, b) : _mm_min_epi8(a, b);
+			else if constexpr (sizeof(Type) == 1) return Maximum ? _mm_max_epu8(a, b) : _mm_min_epu8(a, b);
+			else if constexpr (sizeof(Type) == 2 && std::is_signed_v<Type>) return Maximum ? _mm_max_epi16(a, b) : _mm_min_epi16(a, b);
+			else if constexpr (sizeof(Type) == 2) return Maximum ? _mm_max_epu16(a, b) : _mm_min_epu16(a, b);
+			else if constexpr (sizeof(Type) == 4 && std::is_signed_v<Type>) return Maximum ? _mm_max_epi32(a, b) : _mm_min_epi32(a, b);
+			else if constexpr (sizeof(Type) == 4) return Maximum ? _mm_max_epu32(a, b) : _mm_min_epu32(a, b);
+			else
+			{
+				// There is no 64 bit min/max, so compare (flipping the sign bit for unsigned types) and blend.
+				const Register bias = std::is_signed_v<Type> ? _mm_setzero_si128() : _mm_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+				const Register greater = _mm_cmpgt_epi64(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+				return Maximum ? _mm_blendv_epi8(b, a, greater) : _mm_blendv_epi8(a, b, greater);
+			}
+		}
+
+		/**
+		 * Add the lanes of two registers.
+		 */
+		template<class Type>
+		inline Register Add(Register a, Register b)
+		{
+			if constexpr (std::is_same_v<Type, float>) return _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+			else if constexpr (std::is_same_v<Type, double>) return _mm_castpd_si128(_mm_add_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+			else if constexpr (sizeof(Type) == 1) return _mm_add_epi8(a, b);
+			else if constexpr (sizeof(Type) == 2) return _mm_add_epi16(a, b);
+			else if constexpr (sizeof(Type) == 4) return _mm_add_epi32(a, b);
+			else return _mm_add_epi64(a, b);
+		}
+
+		/**
+		 * Find the index of the first element which is equal to a value.
+		 */
+		template<class Type>
+		size_t Find(const Type* pData, size_t count, Type value)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			const Register needle = Broadcast(value);
+
+			size_t index = 0;
+			for (; index + Lanes <= count; index += Lanes)
+				if (const uint32_t mask = EqualMask<Type>(Load(pData + index), needle))
+					return index + SIMD::CountTrailingZeros(mask) / sizeof(Type);
+
+			return index + Scalar::Find(pData + index, count - index, value);
+		}
+
+		/**
+		 * Count the number of elements which are equal to a value.
+		 */
+		template<class Type>
+		size_t Count(const Type* pData, size_t count, Type value)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			const Register needle = Broadcast(value);
+
+			size_t matchingBytes = 0;
+			size_t index = 0;
+			for (; index + Lanes <= count; index += Lanes)
+				matchingBytes += SIMD::PopCount(EqualMask<Type>(Load(pData + index), needle));
+
+			return matchingBytes / sizeof(Type) + Scalar::Count(pData + index, count - index, value);
+		}
+
+		/**
+		 * Get the smallest or the largest element. The count must not be 0.
+		 */
+		template<class Type, bool Maximum>
+		Type Extreme(const Type* pData, size_t count)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			if (count < Lanes)
+				return Maximum ? Scalar::Max(pData, count) : Scalar::Min(pData, count);
+
+			Register result = Load(pData);
+			size_t index = Lanes;
+			for (; index + Lanes <= count; index += Lanes)
+				result = Select<Type, Maximum>(result, Load(pData + index));
+
+			// Reduce the lanes and the remaining elements.
+			alignas(Width) Type lanes[Lanes];
+			_mm_store_si128(reinterpret_cast<Register*>(lanes), result);
+
+			Type extreme = Maximum ? Scalar::Max(lanes, Lanes) : Scalar::Min(lanes, Lanes);
+			for (; index < count; index++)
+				if (Maximum ? (extreme < pData[index]) : (pData[index] < extreme))
+					extreme = pData[index];
+
+			return extreme;
+		}
+
+		/**
+		 * Get the sum of the elements.
+		 */
+		template<class Type>
+		Type Sum(const Type* pData, size_t count)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+
+			// Use two accumulators to hide the latency of the additions.
+			Register first = _mm_setzero_si128(), second = _mm_setzero_si128();
+			size_t index = 0;
+			for (; index + 2 * Lanes <= count; index += 2 * Lanes)
+			{
+				first = Add<Type>(first, Load(pData + index));
+				second = Add<Type>(second, Load(pData + index + Lanes));
+			}
+
+			alignas(Width) Type lanes[Lanes];
+			_mm_store_si128(reinterpret_cast<Register*>(lanes), Add<Type>(first, second));
+
+			return Scalar::Sum(lanes, Lanes) + Scalar::Sum(pData + index, count - index);
+		}
+
+		/**
+		 * Find the index of the first integer which is not less than a value, in sorted integers.
+		 * The range is halved down to a window of a cache line, and the integers less than the value in the window are
+		 * then counted in whole registers.
+		 */
+		template<class Type>
+		size_t LowerBound(const Type* pData, size_t count, Type value)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			constexpr size_t Window = 64 / sizeof(Type) > Lanes ? 64 / sizeof(Type) : Lanes;
+			if (count < Window)
+				return Scalar::LowerBound(pData, count, value);
+
+			// The lower bound is in [pBase, pBase + length], and the element at pBase + length is not less than the value.
+			const Type* pBase = pData;
+			for (size_t length = count; length > Window; )
+			{
+				const size_t half = length / 2;
+				pBase = pBase[half] < value ? pBase + half : pBase;
+				length -= half;
+			}
+
+			// Count a whole window, moved back if it would end past the elements. The elements before pBase are less
+			// than the value and the elements after the range are not, so they do not change the result.
+			const Type* pWindow = pBase + Window <= pData + count ? pBase : pData + count - Window;
+			const Register needle = Broadcast(value);
+
+			size_t less = 0;
+			for (size_t index = 0; index < Window; index += Lanes)
+				less += SIMD::PopCount(LessMask<Type>(Load(pWindow + index), needle));
+
+			return (pWindow - pData) + less / sizeof(Type);
+		}
+	}
+
+	SIMD_END_TARGET
+
+	SIMD_BEGIN_TARGET_AVX2
+
+	/**
+	 * AVX2 kernels. Comparisons produce one mask bit per byte.
+	 */
+	namespace AVX2 {
+		using Register = __m256i;
+		constexpr size_t Width = 32;
+
+		/**
+		 * Load a register from unaligned memory.
+		 */
+		template<class Type>
+		inline Register Load(const Type* pData) { return _mm256_loadu_si256(reinterpret_cast<const Register*>(pData)); }
+
+		/**
+		 * Set all the lanes of a register to a value.
+		 */
+		template<class Type>
+		inline Register Broadcast(Type value)
+		{
+			if constexpr (std::is_same_v<Type, float>) return _mm256_castps_si256(_mm256_set1_ps(value));
+			else if constexpr (std::is_same_v<Type, double>) return _mm256_castpd_si256(_mm256_set1_pd(value));
+			else if constexpr (sizeof(Type) == 1) return _mm256_set1_epi8(static_cast<char>(value));
+			else if constexpr (sizeof(Type) == 2) return _mm256_set1_epi16(static_cast<short>(value));
+			else if constexpr (sizeof(Type) == 4) return _mm256_set1_epi32(static_cast<int>(value));
+			else return _mm256_set1_epi64x(static_cast<long long>(value));
+		}
+
+		/**
+		 * Compare the lanes for equality and return a mask with one bit per byte.
+		 */
+		template<class Type>
+		inline uint32_t EqualMask(Register a, Register b)
+		{
+			Register result;
+			if constexpr (std::is_same_v<Type, float>) { const auto a_ps = _mm256_castsi256_ps(a), b_ps = _mm256_castsi256_ps(b); result = _mm256_castps_si256(_mm256_cmp_ps(a_ps, b_ps, _CMP_EQ_OQ)); }
+			else if constexpr (std::is_same_v<Type, double>) { const auto a_pd = _mm256_castsi256_pd(a), b_pd = _mm256_castsi256_pd(b); result = _mm256_castpd_si256(_mm256_cmp_pd(a_pd, b_pd, _CMP_EQ_OQ)); }
+			else if constexpr (sizeof(Type) == 1) result = _mm256_cmpeq_epi8(a, b);
+			else if constexpr (sizeof(Type) == 2) result = _mm256_cmpeq_epi16(a, b);
+			else if constexpr (sizeof(Type) == 4) result = _mm256_cmpeq_epi32(a, b);
+			else result = _mm256_cmpeq_epi64(a, b);
+
+			return static_cast<uint32_t>(_mm256_movemask_epi8(result));
+		}
+
+		/**
+		 * Compare the lanes of two integer registers (a < b) and return a mask with one bit per byte.
+		 */
+		template<class Type>
+		inline uint32_t LessMask(Register a, Register b)
+		{
+			// The comparisons are signed, so flip the sign bits of unsigned types.
+			if constexpr (std::is_unsigned_v<Type>)
+			{
+				const Register bias = Broadcast(static_cast<Type>(Type(1) << (sizeof(Type) * 8 - 1)));
+				a = _mm256_xor_si256(a, bias);
+				b = _mm256_xor_si256(b, bias);
+			}
+
+			Register result;
+			if constexpr (sizeof(Type) == 1) result = _mm256_cmpgt_epi8(b, a);
+			else if constexpr (sizeof(Type) == 2) result = _mm256_cmpgt_epi16(b, a);
+			else if constexpr (sizeof(Type) == 4) result = _mm256_cmpgt_epi32(b, a);
+			else result = _mm256_cmpgt_epi64(b, a);
+
+			return static_cast<uint32_t>(_mm256_movemask_epi8(result));
+		}
+
+		/**
+		 * Get the lane wise minimum or maximum of two registers.
+		 */
+		template<class Type, bool Maximum>
+		inline Register Select(Register a, Register b)
+		{
+			if constexpr (std::is_same_v<Type, float>) return Maximum ? _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))) : _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+			else if constexpr (std::is_same_v<Type, double>) return Maximum ? _mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b))) : _mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+			else if constexpr (sizeof(Type) == 1 && std::is_signed_v<Type>) return Maximum ? _mm256_max_epi8(a, b) : _mm256_min_epi8(a, b);
+			else if constexpr (sizeof(Type) == 1) return Maximum ? _mm256_max_epu8(a, b) : _mm256_min_epu8(a, b);
+			else if constexpr (sizeof(Type) == 2 && std::is_signed_v<Type>) return Maximum ? _mm256_max_epi16(a, b) : _mm256_min_epi16(a, b);
+			else if constexpr (sizeof(Type) == 2) return Maximum ? _mm256_max_epu16(a, b) : _mm256_min_epu16(a, b);
+			else if constexpr (sizeof(Type) == 4 && std::is_signed_v<Type>) return Maximum ? _mm256_max_epi32(a, b) : _mm256_min_epi32(a, b);
+			else if constexpr (sizeof(Type) == 4) return Maximum ? _mm256_max_epu32(a, b) : _mm256_min_epu32(a, b);
+			else
+			{
+				// There is no 64 bit min/max, so compare (flipping the sign bit for unsigned types) and blend.
+				const Register bias = std::is_signed_v<Type> ? _mm256_setzero_si256() : _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+				const Register greater = _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+				return Maximum ? _mm256_blendv_epi8(b, a, greater) : _mm256_blendv_epi8(a, b, greater);
+			}
+		}
+
+		/**
+		 * Add the lanes of two registers.
+		 */
+		template<class Type>
+		inline Register Add(Register a, Register b)
+		{
+			if constexpr (std::is_same_v<Type, float>) return _mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+			else if constexpr (std::is_same_v<Type, double>) return _mm256_castpd_si256(_mm256_add_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+			else if constexpr (sizeof(Type) == 1) return _mm256_add_epi8(a, b);
+			else if constexpr (sizeof(Type) == 2) return _mm256_add_epi16(a, b);
+			else if constexpr (sizeof(Type) == 4) return _mm256_add_epi32(a, b);
+			else return _mm256_add_epi64(a, b);
+		}
+
+		/**
+		 * Find the index of the first element which is equal to a value.
+		 */
+		template<class Type>
+		size_t Find(const Type* pData, size_t count, Type value)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			const Register needle = Broadcast(value);
+
+			size_t index = 0;
+			for (; index + Lanes <= count; index += Lanes)
+				if (const uint32_t mask = EqualMask<Type>(Load(pData + index), needle))
+					return index + SIMD::CountTrailingZeros(mask) / sizeof(Type);
+
+			return index + Scalar::Find(pData + index, count - index, value);
+		}
+
+		/**
+		 * Count the number of elements which are equal to a value.
+		 */
+		template<class Type>
+		size_t Count(const Type* pData, size_t count, Type value)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			const Register needle = Broadcast(value);
+
+			size_t matchingBytes = 0;
+			size_t index = 0;
+			for (; index + Lanes <= count; index += Lanes)
+				matchingBytes += SIMD::PopCount(EqualMask<Type>(Load(pData + index), needle));
+
+			return matchingBytes / sizeof(Type) + Scalar::Count(pData + index, count - index, value);
+		}
+
+		/**
+		 * Get the smallest or the largest element. The count must not be 0.
+		 */
+		template<class Type, bool Maximum>
+		Type Extreme(const Type* pData, size_t count)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			if (count < Lanes)
+				return Maximum ? Scalar::Max(pData, count) : Scalar::Min(pData, count);
+
+			Register result = Load(pData);
+			size_t index = Lanes;
+			for (; index + Lanes <= count; index += Lanes)
+				result = Select<Type, Maximum>(result, Load(pData + index));
+
+			// Reduce the lanes and the remaining elements.
+			alignas(Width) Type lanes[Lanes];
+			_mm256_store_si256(reinterpret_cast<Register*>(lanes), result);
+
+			Type extreme = Maximum ? Scalar::Max(lanes, Lanes) : Scalar::Min(lanes, Lanes);
+			for (; index < count; index++)
+				if (Maximum ? (extreme < pData[index]) : (pData[index] < extreme))
+					extreme = pData[index];
+
+			return extreme;
+		}
+
+		/**
+		 * Get the sum of the elements.
+		 */
+		template<class Type>
+		Type Sum(const Type* pData, size_t count)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+
+			// Use two accumulators to hide the latency of the additions.
+			Register first = _mm256_setzero_si256(), second = _mm256_setzero_si256();
+			size_t index = 0;
+			for (; index + 2 * Lanes <= count; index += 2 * Lanes)
+			{
+				first = Add<Type>(first, Load(pData + index));
+				second = Add<Type>(second, Load(pData + index + Lanes));
+			}
+
+			alignas(Width) Type lanes[Lanes];
+			_mm256_store_si256(reinterpret_cast<Register*>(lanes), Add<Type>(first, second));
+
+			return Scalar::Sum(lanes, Lanes) + Scalar::Sum(pData + index, count - index);
+		}
+
+		/**
+		 * Find the index of the first integer which is not less than a value, in sorted integers.
+		 * The range is halved down to a window of a cache line, and the integers less than the value in the window are
+		 * then counted in whole registers.
+		 */
+		template<class Type>
+		size_t LowerBound(const Type* pData, size_t count, Type value)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			constexpr size_t Window = 64 / sizeof(Type) > Lanes ? 64 / sizeof(Type) : Lanes;
+			if (count < Window)
+				return Scalar::LowerBound(pData, count, value);
+
+			// The lower bound is in [pBase, pBase + length], and the element at pBase + length is not less than the value.
+			const Type* pBase = pData;
+			for (size_t length = count; length > Window; )
+			{
+				const size_t half = length / 2;
+				pBase = pBase[half] < value ? pBase + half : pBase;
+				length -= half;
+			}
+
+			// Count a whole window, moved back if it would end past the elements. The elements before pBase are less
+			// than the value and the elements after the range are not, so they do not change the result.
+			const Type* pWindow = pBase + Window <= pData + count ? pBase : pData + count - Window;
+			const Register needle = Broadcast(value);
+
+			size_t less = 0;
+			for (size_t index = 0; index < Window; index += Lanes)
+				less += SIMD::PopCount(LessMask<Type>(Load(pWindow + index), needle));
+
+			return (pWindow - pData) + less / sizeof(Type);
+		}
+	}
+
+	SIMD_END_TARGET
+
+	SIMD_BEGIN_TARGET_AVX512
+
+	/**
+	 * AVX-512 kernels (F and BW). Comparisons produce one mask bit per element.
+	 */
+	namespace AVX512 {
+		using Register = __m512i;
+		constexpr size_t Width = 64;
+
+		/**
+		 * Load a register from unaligned memory.
+		 */
+		template<class Type>
+		inline Register Load(const Type* pData) { return _mm512_loadu_si512(pData); }
+
+		/**
+		 * Set all the lanes of a register to a value.
+		 */
+		template<class Type>
+		inline Register Broadcast(Type value)
+		{
+			if constexpr (std::is_same_v<Type, float>) return _mm512_castps_si512(_mm512_set1_ps(value));
+			else if constexpr (std::is_same_v<Type, double>) return _mm512_castpd_si512(_mm512_set1_pd(value));
+			else if constexpr (sizeof(Type) == 1) return _mm512_set1_epi8(static_cast<char>(value));
+			else if constexpr (sizeof(Type) == 2) return _mm512_set1_epi16(static_cast<short>(value));
+			else if constexpr (sizeof(Type) == 4) return _mm512_set1_epi32(static_cast<int>(value));
+			else return _mm512_set1_epi64(static_cast<long long>(value));
+		}
+
+		/**
+		 * Compare the lanes for equality and return a mask with one bit per element.
+		 */
+		template<class Type>
+		inline uint64_t EqualMask(Register a, Register b)
+		{
+			if constexpr (std::is_same_v<Type, float>) return _mm512_cmp_ps_mask(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b), _CMP_EQ_OQ);
+			else if constexpr (std::is_same_v<Type, double>) return _mm512_cmp_pd_mask(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b), _CMP_EQ_OQ);
+			else if constexpr (sizeof(Type) == 1) return _mm512_cmpeq_epi8_mask(a, b);
+			else if constexpr (sizeof(Type) == 2) return _mm512_cmpeq_epi16_mask(a, b);
+			else if constexpr (sizeof(Type) == 4) return _mm512_cmpeq_epi32_mask(a, b);
+			else return _mm512_cmpeq_epi64_mask(a, b);
+		}
+
+		/**
+		 * Compare the lanes of two integer registers (a < b) and return a mask with one bit per element.
+		 */
+		template<class Type>
+		inline uint64_t LessMask(Register a, Register b)
+		{
+			if constexpr (sizeof(Type) == 1 && std::is_signed_v<Type>) return _mm512_cmplt_epi8_mask(a, b);
+			else if constexpr (sizeof(Type) == 1) return _mm512_cmplt_epu8_mask(a, b);
+			else if constexpr (sizeof(Type) == 2 && std::is_signed_v<Type>) return _mm512_cmplt_epi16_mask(a, b);
+			else if constexpr (sizeof(Type) == 2) return _mm512_cmplt_epu16_mask(a, b);
+			else if constexpr (sizeof(Type) == 4 && std::is_signed_v<Type>) return _mm512_cmplt_epi32_mask(a, b);
+			else if constexpr (sizeof(Type) == 4) return _mm512_cmplt_epu32_mask(a, b);
+			else if constexpr (std::is_signed_v<Type>) return _mm512_cmplt_epi64_mask(a, b);
+			else return _mm512_cmplt_epu64_mask(a, b);
+		}
+
+		/**
+		 * Get the lane wise minimum or maximum of two registers.
+		 */
+		template<class Type, bool Maximum>
+		inline Register Select(Register a, Register b)
+		{
+			if constexpr (std::is_same_v<Type, float>) return Maximum ? _mm512_castps_si512(_mm512_max_ps(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b))) : _mm512_castps_si512(_mm512_min_ps(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b)));
+			else if constexpr (std::is_same_v<Type, double>) return Maximum ? _mm512_castpd_si512(_mm512_max_pd(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b))) : _mm512_castpd_si512(_mm512_min_pd(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b)));
+			else if constexpr (sizeof(Type) == 1 && std::is_signed_v<Type>) return Maximum ? _mm512_max_epi8(a, b) : _mm512_min_epi8(a, b);
+			else if constexpr (sizeof(Type) == 1) return Maximum ? _mm512_max_epu8(a, b) : _mm512_min_epu8(a, b);
+			else if constexpr (sizeof(Type) == 2 && std::is_signed_v<Type>) return Maximum ? _mm512_max_epi16(a, b) : _mm512_min_epi16(a, b);
+			else if constexpr (sizeof(Type) == 2) return Maximum ? _mm512_max_epu16(a, b) : _mm512_min_epu16(a, b);
+			else if constexpr (sizeof(Type) == 4 && std::is_signed_v<Type>) return Maximum ? _mm512_max_epi32(a, b) : _mm512_min_epi32(a, b);
+			else if constexpr (sizeof(Type) == 4) return Maximum ? _mm512_max_epu32(a, b) : _mm512_min_epu32(a, b);
+			else if constexpr (std::is_signed_v<Type>) return Maximum ? _mm512_max_epi64(a, b) : _mm512_min_epi64(a, b);
+			else return Maximum ? _mm512_max_epu64(a, b) : _mm512_min_epu64(a, b);
+		}
+
+		/**
+		 * Add the lanes of two registers.
+		 */
+		template<class Type>
+		inline Register Add(Register a, Register b)
+		{
+			if constexpr (std::is_same_v<Type, float>) return _mm512_castps_si512(_mm512_add_ps(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b)));
+			else if constexpr (std::is_same_v<Type, double>) return _mm512_castpd_si512(_mm512_add_pd(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b)));
+			else if constexpr (sizeof(Type) == 1) return _mm512_add_epi8(a, b);
+			else if constexpr (sizeof(Type) == 2) return _mm512_add_epi16(a, b);
+			else if constexpr (sizeof(Type) == 4) return _mm512_add_epi32(a, b);
+			else return _mm512_add_epi64(a, b);
+		}
+
+		/**
+		 * Find the index of the first element which is equal to a value.
+		 */
+		template<class Type>
+		size_t Find(const Type* pData, size_t count, Type value)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			const Register needle = Broadcast(value);
+
+			size_t index = 0;
+			for (; index + Lanes <= count; index += Lanes)
+				if (const uint64_t mask = EqualMask<Type>(Load(pData + index), needle))
+					return index + SIMD::CountTrailingZeros(mask);
+
+			return index + Scalar::Find(pData + index, count - index, value);
+		}
+
+		/**
+		 * Count the number of elements which are equal to a value.
+		 */
+		template<class Type>
+		size_t Count(const Type* pData, size_t count, Type value)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			const Register needle = Broadcast(value);
+
+			size_t matches = 0;
+			size_t index = 0;
+			for (; index + Lanes <= count; index += Lanes)
+				matches += SIMD::PopCount(EqualMask<Type>(Load(pData + index), needle));
+
+			return matches + Scalar::Count(pData + index, count - index, value);
+		}
+
+		/**
+		 * Get the smallest or the largest element. The count must not be 0.
+		 */
+		template<class Type, bool Maximum>
+		Type Extreme(const Type* pData, size_t count)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			if (count < Lanes)
+				return Maximum ? Scalar::Max(pData, count) : Scalar::Min(pData, count);
+
+			Register result = Load(pData);
+			size_t index = Lanes;
+			for (; index + Lanes <= count; index += Lanes)
+				result = Select<Type, Maximum>(result, Load(pData + index));
+
+			// Reduce the lanes and the remaining elements.
+			alignas(Width) Type lanes[Lanes];
+			_mm512_store_si512(lanes, result);
+
+			Type extreme = Maximum ? Scalar::Max(lanes, Lanes) : Scalar::Min(lanes, Lanes);
+			for (; index < count; index++)
+				if (Maximum ? (extreme < pData[index]) : (pData[index] < extreme))
+					extreme = pData[index];
+
+			return extreme;
+		}
+
+		/**
+		 * Get the sum of the elements.
+		 */
+		template<class Type>
+		Type Sum(const Type* pData, size_t count)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+
+			// Use two accumulators to hide the latency of the additions.
+			Register first = _mm512_setzero_si512(), second = _mm512_setzero_si512();
+			size_t index = 0;
+			for (; index + 2 * Lanes <= count; index += 2 * Lanes)
+			{
+				first = Add<Type>(first, Load(pData + index));
+				second = Add<Type>(second, Load(pData + index + Lanes));
+			}
+
+			alignas(Width) Type lanes[Lanes];
+			_mm512_store_si512(lanes, Add<Type>(first, second));
+
+			return Scalar::Sum(lanes, Lanes) + Scalar::Sum(pData + index, count - index);
+		}
+
+		/**
+		 * Find the index of the first integer which is not less than a value, in sorted integers.
+		 * The range is halved down to a window of a cache line, and the integers less than the value in the window are
+		 * then counted in whole registers.
+		 */
+		template<class Type>
+		size_t LowerBound(const Type* pData, size_t count, Type value)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			constexpr size_t Window = 64 / sizeof(Type) > Lanes ? 64 / sizeof(Type) : Lanes;
+			if (count < Window)
+				return Scalar::LowerBound(pData, count, value);
+
+			// The lower bound is in [pBase, pBase + length], and the element at pBase + length is not less than the value.
+			const Type* pBase = pData;
+			for (size_t length = count; length > Window; )
+			{
+				const size_t half = length / 2;
+				pBase = pBase[half] < value ? pBase + half : pBase;
+				length -= half;
+			}
+
+			// Count a whole window, moved back if it would end past the elements. The elements before pBase are less
+			// than the value and the elements after the range are not, so they do not change the result.
+			const Type* pWindow = pBase + Window <= pData + count ? pBase : pData + count - Window;
+			const Register needle = Broadcast(value);
+
+			size_t less = 0;
+			for (size_t index = 0; index < Window; index += Lanes)
+				less += SIMD::PopCount(LessMask<Type>(Load(pWindow + index), needle));
+
+			return (pWindow - pData) + less;
+		}
+	}
+
+	SIMD_END_TARGET
+
+#endif // SIMD_X86
+
+	/**
+	 * Find the index of the first element which is equal to a value. Returns count if the value is not found.
+	 * The implementation is selected at runtime.
+	 */
+	template<class Type>
+	size_t Find(const Type* pData, size_t count, Type value)
+	{
+#ifdef SIMD_X86
+		switch (SIMD::GetLevel())
+		{
+		case SIMD::Level::AVX512:
+			return AVX512::Find(pData, count, value);
+
+		case SIMD::Level::AVX2:
+			return AVX2::Find(pData, count, value);
+
+		case SIMD::Level::SSE42:
+			return SSE42::Find(pData, count, value);
+
+		default:
+			break;
+		}
+
+#endif // SIMD_X86
+
+		return Scalar::Find(pData, count, value);
+	}
+
+	/**
+	 * Count the number of elements which are equal to a value.
+	 * The implementation is selected at runtime.
+	 */
+	template<class Type>
+	size_t Count(const Type* pData, size_t count, Type value)
+	{
+#ifdef SIMD_X86
+		switch (SIMD::GetLevel())
+		{
+		case SIMD::Level::AVX512:
+			return AVX512::Count(pData, count, value);
+
+		case SIMD::Level::AVX2:
+			return AVX2::Count(pData, count, value);
+
+		case SIMD::Level::SSE42:
+			return SSE42::Count(pData, count, value);
+
+		default:
+			break;
+		}
+
+#endif // SIMD_X86
+
+		return Scalar::Count(pData, count, value);
+	}
+
+	/**
+	 * Get the smallest element. The count must not be 0.
+	 * The implementation is selected at runtime.
+	 */
+	template<class Type>
+	Type Min(const Type* pData, size_t count)
+	{
+#ifdef SIMD_X86
+		switch (SIMD::GetLevel())
+		{
+		case SIMD::Level::AVX512:
+			return AVX512::Extreme<Type, false>(pData, count);
+
+		case SIMD::Level::AVX2:
+			return AVX2::Extreme<Type, false>(pData, count);
+
+		case SIMD::Level::SSE42:
+			return SSE42::Extreme<Type, false>(pData, count);
+
+		default:
+			break;
+		}
+
+#endif // SIMD_X86
+
+		return Scalar::Min(pData, count);
+	}
+
+	/**
+	 * Get the largest element. The count must not be 0.
+	 * The implementation is selected at runtime.
+	 */
+	template<class Type>
+	Type Max(const Type* pData, size_t count)
+	{
+#ifdef SIMD_X86
+		switch (SIMD::GetLevel())
+		{
+		case SIMD::Level::AVX512:
+			return AVX512::Extreme<Type, true>(pData, count);
+
+		case SIMD::Level::AVX2:
+			return AVX2::Extreme<Type, true>(pData, count);
+
+		case SIMD::Level::SSE42:
+			return SSE42::Extreme<Type, true>(pData, count);
+
+		default:
+			break;
+		}
+
+#endif // SIMD_X86
+
+		return Scalar::Max(pData, count);
+	}
+
+	/**
+	 * Get the sum of the elements.
+	 * The implementation is selected at runtime.
+	 */
+	template<class Type>
+	Type Sum(const Type* pData, size_t count)
+	{
+#ifdef SIMD_X86
+		switch (SIMD::GetLevel())
+		{
+		case SIMD::Level::AVX512:
+			return AVX512::Sum(pData, count);
+
+		case SIMD::Level::AVX2:
+			return AVX2::Sum(pData, count);
+
+		case SIMD::Level::SSE42:
+			return SSE42::Sum(pData, count);
+
+		default:
+			break;
+		}
+
+#endif // SIMD_X86
+
+		return Scalar::Sum(pData, count);
+	}
+
+	/**
+	 * Find the index of the first integer which is not less than a value, in sorted integers. Returns count if every
+	 * integer is less than the value.
+	 * The implementation is selected at runtime.
+	 */
+	template<class Type>
+	size_t LowerBound(const Type* pData, size_t count, Type value)
+	{
+		static_assert(std::is_integral_v<Type> && IsVectorizable<Type>, "The elements must be integers!");
+
+#ifdef SIMD_X86
+		switch (SIMD::GetLevel())
+		{
+		case SIMD::Level::AVX512:
+			return AVX512::LowerBound(pData, count, value);
+
+		case SIMD::Level::AVX2:
+			return AVX2::LowerBound(pData, count, value);
+
+		case SIMD::Level::SSE42:
+			return SSE42::LowerBound(pData, count, value);
+
+		default:
+			break;
+		}
+
+#endif // SIMD_X86
+
+		return Scalar::LowerBound(pData, count, value);
+	}
+}
@@ -0,0 +1,114 @@
+#include "Array.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+/**
+ * Create an array of random values in the range [0, 100), so that the value 127 is never found.
+ *
+ * @param count: The number of elements.
+ */
+template<class Type>
+static Array<Type> CreateRandomArray(size_t count)
+{
+	Array<Type> array;
+	array.reserve(count);
+
+	std::mt19937 engine(count);
+	std::uniform_int_distribution<int> distribution(0, 99);
+	for (size_t index = 0; index < count; index++)
+		array.pushBack(static_cast<Type>(distribution(engine)));
+
+	return array;
+}
+
+/**
+ * Run a kernel over an array at a given instruction set level.
+ * The first argument is the instruction set level (see SIMD::Level) and the second is the element count.
+ */
+template<class Type, class Function>
+static void RunKernel(benchmark::State& state, Function&& function)
+{
+	const SIMD::Level previous = SIMD::LevelOverride();
+	SIMD::LevelOverride() = static_cast<SIMD::Level>(state.range(0));
+	if (SIMD::GetLevel() != SIMD::LevelOverride())
+	{
+		SIMD::LevelOverride() = previous;
+		state.SkipWithError("The instruction set level is not supported by this CPU.");
+		return;
+	}
+
+	const Array<Type> array = CreateRandomArray<Type>(static_cast<size_t>(state.range(1)));
+	for (auto _ : state)
+		benchmark::DoNotOptimize(function(array));
+
+	SIMD::LevelOverride() = previous;
+	state.SetBytesProcessed(state.iterations() * state.range(1) * sizeof(Type));
+}
+
+/**
+ * Arguments: every instruction set level with element counts from 16 to 64M.
+ */
+static void KernelArguments(benchmark::internal::Benchmark* pBenchmark)
+{
+	pBenchmark->ArgNames({ "level", "count" });
+	for (int64_t level = 0; level <= static_cast<int64_t>(SIMD::Level::AVX512); level++)
+		for (int64_t count = 16; count <= (64 << 20); count *= 4)
+			pBenchmark->Args({ level, count });
+}
+
+/**
+ * Search for a value which is not present, so the whole array is scanned.
+ */
+template<class Type>
+static void BM_ArrayFind(benchmark::State& state)
+{
+	RunKernel<Type>(state, [](const Array<Type>& array) { return array.find(static_cast<Type>(127)); });
+}
+
+BENCHMARK_TEMPLATE(BM_ArrayFind, int8_t)->Apply(KernelArguments);
+BENCHMARK_TEMPLATE(BM_ArrayFind, int16_t)->Apply(KernelArguments);
+BENCHMARK_TEMPLATE(BM_ArrayFind, int32_t)->Apply(KernelArguments);
+BENCHMARK_TEMPLATE(BM_ArrayFind, int64_t)->Apply(KernelArguments);
+BENCHMARK_TEMPLATE(BM_ArrayFind, float)->Apply(KernelArguments);
+BENCHMARK_TEMPLATE(BM_ArrayFind, double)->Apply(KernelArguments);
+
+/**
+ * Count the occurences of a value.
+ */
+template<class Type>
+static void BM_ArrayOccurence(benchmark::State& state)
+{
+	RunKernel<Type>(state, [](const Array<Type>& array) { return array.occurence(static_cast<Type>(42)); });
+}
+
+BENCHMARK_TEMPLATE(BM_ArrayOccurence, int8_t)->Apply(KernelArguments);
+BENCHMARK_TEMPLATE(BM_ArrayOccurence, int32_t)->Apply(KernelArguments);
+BENCHMARK_TEMPLATE(BM_ArrayOccurence, float)->Apply(KernelArguments);
+
+/**
+ * Get the smallest element.
+ */
+template<class Type>
+static void BM_ArrayMin(benchmark::State& state)
+{
+	RunKernel<Type>(state, [](const Array<Type>& array) { return array.min(); });
+}
+
+BENCHMARK_TEMPLATE(BM_ArrayMin, int8_t)->Apply(KernelArguments);
+BENCHMARK_TEMPLATE(BM_ArrayMin, int32_t)->Apply(KernelArguments);
+BENCHMARK_TEMPLATE(BM_ArrayMin, int64_t)->Apply(KernelArguments);
+BENCHMARK_TEMPLATE(BM_ArrayMin, float)->Apply(KernelArguments);
+
+/**
+ * Get the sum of the elements.
+ */
+template<class Type>
+static void BM_ArraySum(benchmark::State& state)
+{
+	RunKernel<Type>(state, [](const Array<Type>& array) { return array.sum(); });
+}
+
+BENCHMARK_TEMPLATE(BM_ArraySum, int32_t)->Apply(KernelArguments);
+BENCHMARK_TEMPLATE(BM_ArraySum, float)->Apply(KernelArguments);
+BENCHMARK_TEMPLATE(BM_ArraySum, double)->Apply(KernelArguments);
@@ -1,7 +1,42 @@
 #include "Compute.h"
 
-int main()
+#include <benchmark/benchmark.h>
+#include <cstring>
+
+/**
+ * Run the tests of Tests.cpp.
+ *
+ * @return The number of failed tests.
+ */
+int RunTests();
+
+/**
+ * Run the benchmarks which are compiled into the project.
+ * The arguments following "--benchmark" are forwarded to the benchmark library (--benchmark_filter and so on).
+ */
+static int RunBenchmarks(int argc, char** argv)
+{
+	// Drop the "--benchmark" switch so that the library only sees its own flags.
+	argv[1] = argv[0];
+	argc--;
+	argv++;
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	benchmark::RunSpecifiedBenchmarks();
+	return 0;
+}
+
+int main(int argc, char** argv)
 {
+	if (argc > 1 && std::strcmp(argv[1], "--benchmark") == 0)
+		return RunBenchmarks(argc, argv);
+
+	if (argc > 1 && std::strcmp(argv[1], "--test") == 0)
+		return RunTests() == 0 ? 0 : 1;
+
 	Handle pInstance = create_compute_instance();
 	Handle pDevice = create_compute_device(pInstance);
 	Handle pBuffer = create_compute_storage_buffer(pDevice, 1024);
@@ -14,4 +49,4 @@ int main()
 	destroy_compute_storage_buffer(pDevice, pBuffer);
 	destroy_compute_device(pDevice);
 	destroy_compute_instance(pInstance);
-}
\ No newline at end of file
+}
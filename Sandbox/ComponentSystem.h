@@ -1,7 +1,8 @@
 #pragma once
+#include "InternedString.h"
+
 #include <unordered_map>
 #include <vector>
-#include <string>
 #include <typeinfo>
 
 /**
@@ -75,25 +76,24 @@ public:
 		clear();
 	}
 
+	/**
+	 * Get the interned type name of a type.
+	 * The name is interned once per type, after which the registry compares and hashes it as a pointer.
+	 */
+	template<class Type>
+	static BasicInternedString<char> GetTypeName()
+	{
+		static const BasicInternedString<char> typeName(typeid(Type).name());
+		return typeName;
+	}
+
 	/**
 	 * Check if a certain type is registered in the registry.
 	 */
 	template<class Type>
 	bool isRegistered()
 	{
-		// Return false if there are no type names stored.
-		if (!typeNames.size())
-			return false;
-
-		// Get the type ID as a string.
-		std::string typeName = typeid(Type).name();
-
-		// Iterate through the vector to check if the type name is registered.
-		for (size_t index = 0; index < typeNames.size(); index++)
-			if (typeNames[index] == typeName)
-				return true;
-
-		return false;
+		return containerMap.find(GetTypeName<Type>()) != containerMap.end();
 	}
 
 	/**
@@ -103,16 +103,10 @@ public:
 	template<class Type>
 	void registerType()
 	{
-		// Return if the type is already registered.
-		if (isRegistered<Type>())
-			return;
-
-		// Get the type ID as a string.
-		std::string typeName = typeid(Type).name();
-
-		// Register the new type.
-		containerMap[typeName] = new Container<Type>;
-		typeNames.push_back(std::move(typeName));
+		// Register the new type if it was not registered.
+		ContainerBase*& pContainer = containerMap[GetTypeName<Type>()];
+		if (!pContainer)
+			pContainer = new Container<Type>;
 	}
 
 	/**
@@ -126,7 +120,7 @@ public:
 		registerType<Type>();
 
 		// Return the casted container.
-		return dynamic_cast<Container<Type>*>(containerMap[typeid(Type).name()]);
+		return dynamic_cast<Container<Type>*>(containerMap[GetTypeName<Type>()]);
 	}
 
 	/**
@@ -139,12 +133,10 @@ public:
 			delete iterator.second;
 
 		containerMap.clear();
-		typeNames.clear();
 	}
 
 private:
-	std::vector<std::string> typeNames;								// Vector containing all the registered type names.
-	std::unordered_map<std::string, ContainerBase*> containerMap;	// Unordered map containing all the containers.
+	std::unordered_map<BasicInternedString<char>, ContainerBase*> containerMap;	// Unordered map containing all the containers, keyed by the type name.
 };
 
 /**
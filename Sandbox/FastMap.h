@@ -1,52 +1,659 @@
 #pragma once
 
-#include <vector>
-#include <xxhash.h>
+#include "Hash.h"
+#include "MemoryResource.h"
+#include "SIMD.h"
+
 #include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
 
-template<class Key, class Value, class HashCompare = std::less<size_t>>
-class HashMap : private HashCompare {
-	struct Entry {
-		Entry(Key key = Key(), Value value = Value(), size_t hash = 0)
-			: key(key), value(value), hash(hash) {}
+/**
+ * Control bytes of the hash map.
+ * Every slot of the table has a control byte: full slots store the low 7 bits of the hash of their key, and empty
+ * and deleted slots store negative markers. Lookups compare a group of 16 control bytes at once, so most of the
+ * slots which cannot hold the key are skipped without touching the slots themselves.
+ */
+namespace FastMapControl {
+	constexpr int8_t Empty = -128;		// The slot has never been used since the last rehash. Ends the probing.
+	constexpr int8_t Deleted = -2;		// The slot held an entry which was erased (tombstone).
 
-		Key key = Key();
-		Value value = Value();
-		size_t hash = 0;
-	};
+	/**
+	 * The number of control bytes compared at once.
+	 */
+	constexpr size_t GroupWidth = 16;
 
-	typedef std::vector<Entry> EntryVector;
+	/**
+	 * A group of control bytes.
+	 * The masks have one bit per control byte, with the first byte in the lowest bit.
+	 */
+	struct Group {
+#ifdef SIMD_SSE2
+		/**
+		 * Load a group.
+		 *
+		 * @param pControl: The first control byte of the group.
+		 */
+		explicit Group(const int8_t* pControl) noexcept : mBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pControl))) {}
 
-	class FirstLess
-	{
-	public:
-		FirstLess(const HashCompare& comp) : mCompare(comp) {}
+		/**
+		 * Get the bytes which are equal to the hash bits of a key.
+		 *
+		 * @param hashBits: The low 7 bits of the hash.
+		 */
+		uint32_t match(int8_t hashBits) const noexcept { return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(mBytes, _mm_set1_epi8(hashBits)))); }
+
+		/**
+		 * Get the empty bytes.
+		 */
+		uint32_t matchEmpty() const noexcept { return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(mBytes, _mm_set1_epi8(Empty)))); }
+
+		/**
+		 * Get the empty and the deleted bytes. These are the negative bytes, so this is just their sign bits.
+		 */
+		uint32_t matchEmptyOrDeleted() const noexcept { return static_cast<uint32_t>(_mm_movemask_epi8(mBytes)); }
+
+		/**
+		 * Get the full bytes.
+		 */
+		uint32_t matchFull() const noexcept { return matchEmptyOrDeleted() ^ 0xFFFF; }
+
+	private:
+		__m128i mBytes;
+
+#else
+		explicit Group(const int8_t* pControl) noexcept { std::memcpy(mBytes, pControl, GroupWidth); }
+
+		uint32_t match(int8_t hashBits) const noexcept { return matchIf([hashBits](int8_t byte) { return byte == hashBits; }); }
+		uint32_t matchEmpty() const noexcept { return matchIf([](int8_t byte) { return byte == Empty; }); }
+		uint32_t matchEmptyOrDeleted() const noexcept { return matchIf([](int8_t byte) { return byte < 0; }); }
+		uint32_t matchFull() const noexcept { return matchEmptyOrDeleted() ^ 0xFFFF; }
 
-		bool operator()(const Entry& left, const Entry& right) const
+	private:
+		template<class Predicate>
+		uint32_t matchIf(Predicate&& predicate) const noexcept
 		{
-			return mCompare(left.hash, right.hash);
+			uint32_t mask = 0;
+			for (size_t index = 0; index < GroupWidth; index++)
+				mask |= static_cast<uint32_t>(predicate(mBytes[index])) << index;
+
+			return mask;
 		}
 
+		int8_t mBytes[GroupWidth];
+
+#endif // SIMD_SSE2
+	};
+}
+
+/**
+ * Open addressing hash map (Swiss table).
+ * The entries are stored in a flat table with a control byte per slot (see FastMapControl). A key is hashed once:
+ * the high bits select the first group of slots to probe, and the low 7 bits are stored in the control byte, so a
+ * lookup compares the key of a slot only when those 7 bits match, which is about once in 128 slots for other keys.
+ * The groups are probed in triangular order, which visits every group of a power of two table.
+ *
+ * Erased entries leave a tombstone unless their group has an empty slot (so no probe ever continued past it). The
+ * table is rehashed when the entries and the tombstones fill 7/8 of it, into a table of twice the size unless most
+ * of the used slots are tombstones.
+ *
+ * Inserting or erasing may move the entries, so pointers and iterators to them are only valid until the next
+ * modification. Like the VectorMap, the entries are exposed as pairs with a non-const key which must not be modified.
+ *
+ * @tparam Key: The key type.
+ * @tparam Value: The value type.
+ * @tparam Hash: The hash function object. Hashing::Hasher supports integers, enums, pointers, the strings and any
+ *	type with a std::hash specialization.
+ * @tparam Equal: The key equality function object.
+ */
+template<class Key, class Value, class Hash = Hashing::Hasher<Key>, class Equal = std::equal_to<Key>>
+class HashMap : private Hash, private Equal {
+public:
+	// Entry type.
+	using Entry = std::pair<Key, Value>;
+
+	/**
+	 * Iterator over the entries of the map, in table order.
+	 *
+	 * @tparam Const: Whether the entries are read only.
+	 */
+	template<bool Const>
+	class Iterator {
+		using Map = std::conditional_t<Const, const HashMap, HashMap>;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Entry;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<Const, const Entry&, Entry&>;
+		using pointer = std::conditional_t<Const, const Entry*, Entry*>;
+
+	public:
+		/**
+		 * Default constructor.
+		 */
+		Iterator() noexcept = default;
+
+		/**
+		 * Construct the iterator, skipping to the first full slot from an index.
+		 *
+		 * @param pMap: The map.
+		 * @param index: The index of the slot.
+		 */
+		Iterator(Map* pMap, size_t index) noexcept : pMap(pMap), mIndex(pMap->nextFullSlot(index)) {}
+
+		/**
+		 * Convert the iterator to a const iterator.
+		 */
+		operator Iterator<true>() const noexcept requires (!Const) { return Iterator<true>(pMap, mIndex); }
+
+		reference operator*() const noexcept { return pMap->pSlots[mIndex]; }
+		pointer operator->() const noexcept { return pMap->pSlots + mIndex; }
+
+		Iterator& operator++() noexcept { mIndex = pMap->nextFullSlot(mIndex + 1); return *this; }
+		Iterator operator++(int) noexcept { Iterator previous = *this; ++*this; return previous; }
+
+		bool operator==(const Iterator& other) const noexcept { return mIndex == other.mIndex; }
+
 	private:
-		const HashCompare& mCompare;
+		Map* pMap = nullptr;
+		size_t mIndex = 0;
 	};
 
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
 public:
-	HashMap() = default;
-	~HashMap() {}
+	/**
+	 * Construct the map.
+	 *
+	 * @param pResource: The memory resource to allocate the table from.
+	 * @param hash: The hash function object.
+	 * @param equal: The key equality function object.
+	 */
+	explicit HashMap(MemoryResource* pResource = GetDefaultMemoryResource(), const Hash& hash = Hash(), const Equal& equal = Equal())
+		: Hash(hash), Equal(equal), pResource(pResource) {}
 
-	void Insert(const Key& key, const Value& value)
+	/**
+	 * Copy constructor. The table is copied slot by slot, without rehashing.
+	 *
+	 * @param other: The other map.
+	 */
+	HashMap(const HashMap& other) : Hash(other), Equal(other), pResource(other.pResource)
 	{
-		uint64_t hash = XXH64(&key, sizeof(Key), 0);
-		uint32_t block = hash >> 32;	// We take the first 32 bits (0x|00000000|00000000) as the block index.
-		uint32_t maxBlock = -1;
+		if (!other.mCapacity)
+			return;
+
+		allocateTable(other.mCapacity);
+		std::memcpy(pControl, other.pControl, mCapacity);
+		for (size_t index = 0; index < mCapacity; index++)
+			if (pControl[index] >= 0)
+				new (pSlots + index) Entry(other.pSlots[index]);
+
+		mSize = other.mSize;
+		mGrowthLeft = other.mGrowthLeft;
 	}
 
-	Value Get(const Key& key)
+	/**
+	 * Move constructor.
+	 *
+	 * @param other: The other map.
+	 */
+	HashMap(HashMap&& other) noexcept
+		: Hash(std::move(other)), Equal(std::move(other)), pResource(other.pResource),
+		pControl(std::exchange(other.pControl, nullptr)), pSlots(std::exchange(other.pSlots, nullptr)),
+		mCapacity(std::exchange(other.mCapacity, 0)), mSize(std::exchange(other.mSize, 0)), mGrowthLeft(std::exchange(other.mGrowthLeft, 0)) {}
+
+	/**
+	 * Default destructor.
+	 */
+	~HashMap() { destroyTable(); }
+
+	/**
+	 * Insert a value, replacing the value of the key if the key is already in the map.
+	 * Returns true if the key was inserted.
+	 *
+	 * @param key: The key.
+	 * @param value: The value.
+	 */
+	bool Insert(const Key& key, const Value& value)
 	{
-		return Value();
+		InsertPosition position = findOrPrepareInsert(key);
+		if (!position.bInserted)
+		{
+			pSlots[position.index].second = value;
+			return false;
+		}
+
+		constructEntry(position, key, value);
+		return true;
+	}
+
+	/**
+	 * Get the value of a key, inserting a default value if the key is not in the map.
+	 *
+	 * @param key: The key.
+	 */
+	Value& Get(const Key& key)
+	{
+		InsertPosition position = findOrPrepareInsert(key);
+		if (position.bInserted)
+			constructEntry(position, key, Value());
+
+		return pSlots[position.index].second;
+	}
+
+	/**
+	 * Find the value of a key. Returns nullptr if the key is not in the map.
+	 *
+	 * @param key: The key.
+	 */
+	Value* Find(const Key& key)
+	{
+		const size_t index = findSlot(key);
+		return index != mCapacity ? &pSlots[index].second : nullptr;
+	}
+
+	/**
+	 * Find the value of a key. Returns nullptr if the key is not in the map.
+	 *
+	 * @param key: The key.
+	 */
+	const Value* Find(const Key& key) const
+	{
+		const size_t index = findSlot(key);
+		return index != mCapacity ? &pSlots[index].second : nullptr;
+	}
+
+	/**
+	 * Check if a key is in the map.
+	 *
+	 * @param key: The key.
+	 */
+	bool Contains(const Key& key) const { return findSlot(key) != mCapacity; }
+
+	/**
+	 * Erase the entry of a key. Returns false if the key is not in the map.
+	 *
+	 * @param key: The key.
+	 */
+	bool Erase(const Key& key)
+	{
+		const size_t index = findSlot(key);
+		if (index == mCapacity)
+			return false;
+
+		pSlots[index].~Entry();
+		mSize--;
+
+		// A probe which reached a group with an empty slot stopped there, so if this slot's group has one, no key was
+		// placed after this slot because of it and the slot can become empty again rather than a tombstone.
+		const size_t group = index & ~(FastMapControl::GroupWidth - 1);
+		if (FastMapControl::Group(pControl + group).matchEmpty())
+		{
+			pControl[index] = FastMapControl::Empty;
+			mGrowthLeft++;
+		}
+		else
+		{
+			pControl[index] = FastMapControl::Deleted;
+		}
+
+		return true;
+	}
+
+	/**
+	 * Erase all the entries, keeping the table.
+	 */
+	void Clear()
+	{
+		for (size_t index = 0; index < mCapacity; index++)
+			if (pControl[index] >= 0)
+				pSlots[index].~Entry();
+
+		if (mCapacity)
+			std::memset(pControl, FastMapControl::Empty, mCapacity);
+
+		mSize = 0;
+		mGrowthLeft = MaxLoad(mCapacity);
+	}
+
+	/**
+	 * Make sure that a number of entries can be stored without rehashing.
+	 *
+	 * @param count: The number of entries.
+	 */
+	void Reserve(size_t count)
+	{
+		if (count > mSize + mGrowthLeft)
+			rehash(CapacityFor(count));
+	}
+
+	/**
+	 * Get the number of entries.
+	 */
+	size_t Size() const noexcept { return mSize; }
+
+	/**
+	 * Check if the map is empty.
+	 */
+	bool Empty() const noexcept { return mSize == 0; }
+
+	/**
+	 * Get the number of slots of the table.
+	 */
+	size_t Capacity() const noexcept { return mCapacity; }
+
+	iterator begin() noexcept { return iterator(this, 0); }
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+	iterator end() noexcept { return iterator(this, mCapacity); }
+	const_iterator end() const noexcept { return const_iterator(this, mCapacity); }
+
+public:
+	/**
+	 * Copy assignment operator.
+	 *
+	 * @param other: The other map.
+	 */
+	HashMap& operator=(const HashMap& other)
+	{
+		if (this != &other)
+		{
+			HashMap copy(other);
+			*this = std::move(copy);
+		}
+
+		return *this;
+	}
+
+	/**
+	 * Move assignment operator.
+	 *
+	 * @param other: The other map.
+	 */
+	HashMap& operator=(HashMap&& other) noexcept
+	{
+		if (this != &other)
+		{
+			destroyTable();
+			static_cast<Hash&>(*this) = std::move(static_cast<Hash&>(other));
+			static_cast<Equal&>(*this) = std::move(static_cast<Equal&>(other));
+			pResource = other.pResource;
+			pControl = std::exchange(other.pControl, nullptr);
+			pSlots = std::exchange(other.pSlots, nullptr);
+			mCapacity = std::exchange(other.mCapacity, 0);
+			mSize = std::exchange(other.mSize, 0);
+			mGrowthLeft = std::exchange(other.mGrowthLeft, 0);
+		}
+
+		return *this;
+	}
+
+private:
+	/**
+	 * Get the number of entries and tombstones a table can hold (7/8 of the slots).
+	 *
+	 * @param capacity: The number of slots.
+	 */
+	static constexpr size_t MaxLoad(size_t capacity) noexcept { return capacity - capacity / 8; }
+
+	/**
+	 * Get the smallest table capacity which holds a number of entries.
+	 *
+	 * @param count: The number of entries.
+	 */
+	static size_t CapacityFor(size_t count) noexcept
+	{
+		size_t capacity = FastMapControl::GroupWidth;
+		while (MaxLoad(capacity) < count)
+			capacity *= 2;
+
+		return capacity;
+	}
+
+	/**
+	 * Get the index of the first full slot at or after an index, or the capacity if there is none.
+	 *
+	 * @param index: The index.
+	 */
+	size_t nextFullSlot(size_t index) const noexcept
+	{
+		while (index < mCapacity)
+		{
+			// Check the rest of the group at once.
+			const size_t group = index & ~(FastMapControl::GroupWidth - 1);
+			const uint32_t mask = FastMapControl::Group(pControl + group).matchFull() >> (index - group);
+			if (mask)
+				return index + SIMD::CountTrailingZeros(mask);
+
+			index = group + FastMapControl::GroupWidth;
+		}
+
+		return mCapacity;
+	}
+
+	/**
+	 * Find the slot of a key. Returns the capacity if the key is not in the map.
+	 *
+	 * @param key: The key.
+	 */
+	size_t findSlot(const Key& key) const
+	{
+		return mSize ? findSlot(key, Hash::operator()(key)) : mCapacity;
+	}
+
+	/**
+	 * Find the slot of a key using its hash. Returns the capacity if the key is not in the map.
+	 * There must be a table.
+	 *
+	 * @param key: The key.
+	 * @param hash: The hash of the key.
+	 */
+	size_t findSlot(const Key& key, uint64_t hash) const
+	{
+		const int8_t hashBits = static_cast<int8_t>(hash & 0x7F);
+		const size_t groupMask = mCapacity / FastMapControl::GroupWidth - 1;
+
+		size_t group = static_cast<size_t>(hash >> 7) & groupMask;
+		for (size_t step = 1;; step++)
+		{
+			const size_t first = group * FastMapControl::GroupWidth;
+			const FastMapControl::Group control(pControl + first);
+			for (uint32_t mask = control.match(hashBits); mask; mask &= mask - 1)
+			{
+				const size_t index = first + SIMD::CountTrailingZeros(mask);
+				if (Equal::operator()(pSlots[index].first, key))
+					return index;
+			}
+
+			if (control.matchEmpty())
+				return mCapacity;
+
+			group = (group + step) & groupMask;
+		}
+	}
+
+	/**
+	 * Slot found by findOrPrepareInsert.
+	 */
+	struct InsertPosition {
+		size_t index = 0;		// The slot.
+		uint64_t hash = 0;		// The hash of the key.
+		bool bInserted = false;	// Whether the key is not in the map and its entry must be constructed in the slot.
+		bool bRehash = false;	// Whether the table must be rehashed first. The slot is then found after the rehash.
+	};
+
+	/**
+	 * Find the slot of a key, or prepare a slot to insert it in.
+	 * Nothing is changed: the table is rehashed and the slot is marked as used by constructEntry(), so an exception
+	 * thrown by the constructor of the entry leaves the map unchanged.
+	 *
+	 * @param key: The key.
+	 */
+	InsertPosition findOrPrepareInsert(const Key& key) const
+	{
+		const uint64_t hash = Hash::operator()(key);
+		if (mSize)
+		{
+			const size_t existing = findSlot(key, hash);
+			if (existing != mCapacity)
+				return { existing, hash, false, false };
+		}
+
+		// Rehash if this would take an empty slot (rather than reuse a tombstone) and the table is full.
+		const size_t index = findFreeSlot(hash);
+		const bool bRehash = mGrowthLeft == 0 && (mCapacity == 0 || pControl[index] == FastMapControl::Empty);
+		return { index, hash, true, bRehash };
+	}
+
+	/**
+	 * Construct the entry of a key at the slot prepared by findOrPrepareInsert, and mark the slot as used.
+	 * The arguments might refer to entries of this map (map.Insert(key, map.Get(other))), so if the table must be
+	 * rehashed, the entry is constructed before the old table is freed and then moved to the new one.
+	 *
+	 * @param position: The position returned by findOrPrepareInsert. The slot is updated if the table is rehashed.
+	 * @param arguments: The arguments to be passed to the constructor of the entry.
+	 */
+	template<class... Arguments>
+	void constructEntry(InsertPosition& position, Arguments&&... arguments)
+	{
+		if (position.bRehash)
+		{
+			Entry entry(std::forward<Arguments>(arguments)...);
+
+			// Drop the tombstones without growing if they take most of the used slots.
+			rehash(mSize * 2 < MaxLoad(mCapacity) ? mCapacity : std::max(mCapacity * 2, CapacityFor(mSize + 1)));
+			position.index = findFreeSlot(position.hash);
+			position.bRehash = false;
+
+			new (pSlots + position.index) Entry(std::move(entry));
+		}
+		else
+			new (pSlots + position.index) Entry(std::forward<Arguments>(arguments)...);
+
+		if (pControl[position.index] == FastMapControl::Empty)
+			mGrowthLeft--;
+
+		pControl[position.index] = static_cast<int8_t>(position.hash & 0x7F);
+		mSize++;
+	}
+
+	/**
+	 * Find the first empty or deleted slot in the probe sequence of a hash. Returns 0 if there is no table.
+	 *
+	 * @param hash: The hash.
+	 */
+	size_t findFreeSlot(uint64_t hash) const noexcept
+	{
+		if (!mCapacity)
+			return 0;
+
+		const size_t groupMask = mCapacity / FastMapControl::GroupWidth - 1;
+		size_t group = static_cast<size_t>(hash >> 7) & groupMask;
+		for (size_t step = 1;; step++)
+		{
+			const size_t first = group * FastMapControl::GroupWidth;
+			if (const uint32_t mask = FastMapControl::Group(pControl + first).matchEmptyOrDeleted())
+				return first + SIMD::CountTrailingZeros(mask);
+
+			group = (group + step) & groupMask;
+		}
+	}
+
+	/**
+	 * Move the entries to a new table.
+	 *
+	 * @param capacity: The number of slots of the new table. This must be a power of two and hold the entries.
+	 */
+	void rehash(size_t capacity)
+	{
+		int8_t* pOldControl = pControl;
+		Entry* pOldSlots = pSlots;
+		const size_t oldCapacity = mCapacity;
+
+		allocateTable(capacity);
+		mGrowthLeft = MaxLoad(capacity) - mSize;
+
+		for (size_t index = 0; index < oldCapacity; index++)
+		{
+			if (pOldControl[index] < 0)
+				continue;
+
+			const uint64_t hash = Hash::operator()(pOldSlots[index].first);
+			const size_t slot = findFreeSlot(hash);
+			pControl[slot] = static_cast<int8_t>(hash & 0x7F);
+			new (pSlots + slot) Entry(std::move(pOldSlots[index]));
+			pOldSlots[index].~Entry();
+		}
+
+		if (oldCapacity)
+			pResource->deallocate(pOldControl, TableSize(oldCapacity), alignof(Entry) > FastMapControl::GroupWidth ? alignof(Entry) : FastMapControl::GroupWidth);
+	}
+
+	/**
+	 * Get the size of the block of a table, which holds the control bytes followed by the slots.
+	 *
+	 * @param capacity: The number of slots.
+	 */
+	static constexpr size_t TableSize(size_t capacity) noexcept { return SlotOffset(capacity) + capacity * sizeof(Entry); }
+
+	/**
+	 * Get the offset of the slots in the block of a table.
+	 *
+	 * @param capacity: The number of slots.
+	 */
+	static constexpr size_t SlotOffset(size_t capacity) noexcept { return (capacity + alignof(Entry) - 1) & ~(alignof(Entry) - 1); }
+
+	/**
+	 * Allocate an empty table. This does not release the current table.
+	 *
+	 * @param capacity: The number of slots.
+	 */
+	void allocateTable(size_t capacity)
+	{
+		uint8_t* pBlock = static_cast<uint8_t*>(pResource->allocate(TableSize(capacity), alignof(Entry) > FastMapControl::GroupWidth ? alignof(Entry) : FastMapControl::GroupWidth));
+		pControl = reinterpret_cast<int8_t*>(pBlock);
+		pSlots = reinterpret_cast<Entry*>(pBlock + SlotOffset(capacity));
+		mCapacity = capacity;
+
+		std::memset(pControl, FastMapControl::Empty, capacity);
+	}
+
+	/**
+	 * Destroy the entries and release the table.
+	 */
+	void destroyTable() noexcept
+	{
+		if (!mCapacity)
+			return;
+
+		for (size_t index = 0; index < mCapacity; index++)
+			if (pControl[index] >= 0)
+				pSlots[index].~Entry();
+
+		pResource->deallocate(pControl, TableSize(mCapacity), alignof(Entry) > FastMapControl::GroupWidth ? alignof(Entry) : FastMapControl::GroupWidth);
+		pControl = nullptr;
+		pSlots = nullptr;
+		mCapacity = mSize = mGrowthLeft = 0;
 	}
 
 private:
+	MemoryResource* pResource = nullptr;	// The memory resource the table is allocated from.
+	int8_t* pControl = nullptr;				// The control bytes, one per slot.
+	Entry* pSlots = nullptr;				// The slots, following the control bytes in the same block.
 
+	size_t mCapacity = 0;		// The number of slots (a power of two, and at least a group), or 0 without a table.
+	size_t mSize = 0;			// The number of entries.
+	size_t mGrowthLeft = 0;		// The number of empty slots which can be used before rehashing.
 };
+
+/**
+ * Find the index of a hash in a vector of hashes, or -1 if the hash is not in the vector.
+ * This uses ArrayKernels::Find, which compares 2 to 8 hashes per instruction with unaligned loads depending on the
+ * instruction set selected at runtime, so the vector does not need padding.
+ *
+ * @param hashVector: The hashes.
+ * @param hash: The hash to be searched for.
+ */
+long long FindIndex(const std::vector<uint64_t>& hashVector, const uint64_t& hash);
@@ -0,0 +1,195 @@
+#include "FastMap.h"
+#include "VectorMap.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <unordered_map>
+
+/**
+ * Create random 64 bit keys.
+ *
+ * @param count: The number of keys.
+ * @param seed: The seed of the random engine.
+ */
+static std::vector<uint64_t> CreateKeys(size_t count, uint64_t seed = 0)
+{
+	std::mt19937_64 engine(seed);
+	std::vector<uint64_t> keys(count);
+	for (auto& key : keys)
+		key = engine();
+
+	return keys;
+}
+
+/**
+ * Insert keys into a map, one at a time. The VectorMap is loaded using insertUnsorted, as inserting one key at a
+ * time is quadratic.
+ */
+static void InsertKeys(HashMap<uint64_t, uint64_t>& map, const std::vector<uint64_t>& keys)
+{
+	for (const auto key : keys)
+		map.Insert(key, key);
+}
+
+static void InsertKeys(std::unordered_map<uint64_t, uint64_t>& map, const std::vector<uint64_t>& keys)
+{
+	for (const auto key : keys)
+		map.insert_or_assign(key, key);
+}
+
+static void InsertKeys(VectorMap<uint64_t, uint64_t>& map, const std::vector<uint64_t>& keys)
+{
+	std::vector<std::pair<uint64_t, uint64_t>> entries(keys.size());
+	for (size_t index = 0; index < keys.size(); index++)
+		entries[index] = { keys[index], keys[index] };
+
+	map.insertUnsorted(entries.begin(), entries.end());
+}
+
+/**
+ * Look up a key in a map. Returns the value or 0 if the key is not in the map.
+ */
+static uint64_t LookUp(const HashMap<uint64_t, uint64_t>& map, uint64_t key)
+{
+	const uint64_t* pValue = map.Find(key);
+	return pValue ? *pValue : 0;
+}
+
+static uint64_t LookUp(const std::unordered_map<uint64_t, uint64_t>& map, uint64_t key)
+{
+	const auto iterator = map.find(key);
+	return iterator != map.end() ? iterator->second : 0;
+}
+
+static uint64_t LookUp(const VectorMap<uint64_t, uint64_t>& map, uint64_t key)
+{
+	const auto iterator = map.find(key);
+	return iterator != map.end() ? iterator->second : 0;
+}
+
+/**
+ * Insert random keys into an empty map.
+ */
+template<class Map>
+static void BM_MapInsert(benchmark::State& state)
+{
+	const auto keys = CreateKeys(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		Map map;
+		InsertKeys(map, keys);
+		benchmark::DoNotOptimize(LookUp(map, keys.front()));
+	}
+
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+BENCHMARK_TEMPLATE(BM_MapInsert, HashMap<uint64_t, uint64_t>)->ArgName("size")->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapInsert, std::unordered_map<uint64_t, uint64_t>)->ArgName("size")->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapInsert, VectorMap<uint64_t, uint64_t>)->ArgName("size")->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+/**
+ * Look up random keys which are in the map (hit = 1) or not (hit = 0).
+ */
+template<class Map>
+static void BM_MapLookup(benchmark::State& state)
+{
+	const auto keys = CreateKeys(static_cast<size_t>(state.range(0)));
+	Map map;
+	InsertKeys(map, keys);
+
+	std::vector<uint64_t> queries = state.range(1) ? keys : CreateKeys(keys.size(), 1);
+	std::shuffle(queries.begin(), queries.end(), std::mt19937_64(2));
+	queries.resize(std::min<size_t>(queries.size(), 1 << 12));
+
+	for (auto _ : state)
+	{
+		for (const auto query : queries)
+			benchmark::DoNotOptimize(LookUp(map, query));
+	}
+
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+BENCHMARK_TEMPLATE(BM_MapLookup, HashMap<uint64_t, uint64_t>)->ArgNames({ "size", "hit" })->ArgsProduct({ { 1 << 10, 1 << 15, 1 << 20 }, { 0, 1 } });
+BENCHMARK_TEMPLATE(BM_MapLookup, std::unordered_map<uint64_t, uint64_t>)->ArgNames({ "size", "hit" })->ArgsProduct({ { 1 << 10, 1 << 15, 1 << 20 }, { 0, 1 } });
+BENCHMARK_TEMPLATE(BM_MapLookup, VectorMap<uint64_t, uint64_t>)->ArgNames({ "size", "hit" })->ArgsProduct({ { 1 << 10, 1 << 15, 1 << 20 }, { 0, 1 } });
+
+/**
+ * Replace a key of a map with another key.
+ */
+static void ReplaceKey(HashMap<uint64_t, uint64_t>& map, uint64_t oldKey, uint64_t newKey)
+{
+	map.Erase(oldKey);
+	map.Insert(newKey, newKey);
+}
+
+static void ReplaceKey(std::unordered_map<uint64_t, uint64_t>& map, uint64_t oldKey, uint64_t newKey)
+{
+	map.erase(oldKey);
+	map.insert_or_assign(newKey, newKey);
+}
+
+/**
+ * Erase and insert random keys in a map of a fixed size, which leaves tombstones in the hash map.
+ */
+template<class Map>
+static void BM_MapChurn(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+	auto keys = CreateKeys(count * 2);
+
+	Map map;
+	InsertKeys(map, std::vector<uint64_t>(keys.begin(), keys.begin() + count));
+
+	// Replace the oldest key with one which is not in the map, and reuse the replaced key later.
+	size_t next = 0;
+	for (auto _ : state)
+	{
+		ReplaceKey(map, keys[next], keys[next + count]);
+		std::swap(keys[next], keys[next + count]);
+		next = next + 1 < count ? next + 1 : 0;
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_MapChurn, HashMap<uint64_t, uint64_t>)->ArgName("size")->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapChurn, std::unordered_map<uint64_t, uint64_t>)->ArgName("size")->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+/**
+ * Set the instruction set level of a benchmark (the first argument). Returns false if the CPU does not support it.
+ *
+ * @param state: The benchmark state.
+ * @param previous: The variable to store the previous level in.
+ */
+static bool SetLevel(benchmark::State& state, SIMD::Level& previous)
+{
+	previous = SIMD::LevelOverride();
+	SIMD::LevelOverride() = static_cast<SIMD::Level>(state.range(0));
+	if (SIMD::GetLevel() == SIMD::LevelOverride())
+		return true;
+
+	SIMD::LevelOverride() = previous;
+	state.SkipWithError("The instruction set level is not supported by this CPU.");
+	return false;
+}
+
+/**
+ * Find the last hash of a vector using FindIndex at the scalar, SSE4.2, AVX2 and AVX-512 levels.
+ */
+static void BM_FindIndex(benchmark::State& state)
+{
+	SIMD::Level previous;
+	if (!SetLevel(state, previous))
+		return;
+
+	const auto hashes = CreateKeys(static_cast<size_t>(state.range(1)));
+	for (auto _ : state)
+		benchmark::DoNotOptimize(FindIndex(hashes, hashes.back()));
+
+	SIMD::LevelOverride() = previous;
+	state.SetBytesProcessed(state.iterations() * hashes.size() * sizeof(uint64_t));
+}
+
+BENCHMARK(BM_FindIndex)->ArgNames({ "level", "size" })->ArgsProduct({ { 0, 1, 2, 3 }, { 64, 1024, 65536 } });
@@ -1,8 +1,18 @@
 #pragma once
+#include "String.h"
+
+#include <bit>
+#include <cassert>
 
 /**
  * Fast string class.
- * This object stores strings in stack.
+ * This object stores short strings in place (small string optimization), so identifier sized strings never touch the
+ * heap. Up to InlineCapacity characters (23 for char, 11 for a 2 byte wchar_t) are stored inside the object itself,
+ * longer strings are allocated from the memory resource of the string.
+ *
+ * The characters take as much space as three pointers. In the inline mode, the last character of the inline buffer
+ * stores the number of unused inline characters, which becomes the null terminator when the buffer is full. In the heap
+ * mode the most significant bit of the capacity is set, which lands in the same byte on little endian machines.
  */
 class FastString {
 public:
@@ -10,23 +20,533 @@ public:
 	// Primitive type.
 	using Type = wchar_t;
 
-#else 
+#else
 	// Primitive type.
 	using Type = char;
 
 #endif // USE_WCHAR
 
+	// String standard type.
+	using TypeSTD = std::basic_string<Type, std::char_traits<Type>, std::allocator<Type>>;
+
+	// String view type.
+	using View = BasicStringView<Type>;
+
+private:
+	/**
+	 * Heap representation.
+	 */
+	struct HeapData {
+		Type* pData;		// The allocated characters.
+		size_t length;		// The number of characters.
+		size_t capacity;	// The number of characters which fit in the allocation (excluding '\0'), with the HeapFlag set.
+	};
+
+	static_assert(std::endian::native == std::endian::little, "The FastString layout requires a little endian machine!");
+
+	static constexpr size_t HeapFlag = static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1);
+
+public:
+	/**
+	 * The number of characters which can be stored without allocating.
+	 */
+	static constexpr size_t InlineCapacity = sizeof(HeapData) / sizeof(Type) - 1;
+
 public:
 	/**
 	 * Default constructor.
 	 */
-	FastString() : pString(nullptr) {}
+	FastString() noexcept { setInlineSize(0); }
+
+	/**
+	 * Construct the string object using a memory resource.
+	 *
+	 * @param pResource: The memory resource to allocate memory from.
+	 */
+	explicit FastString(MemoryResource* pResource) noexcept : pResource(pResource) { setInlineSize(0); }
+
+	/**
+	 * Construct the string object using a primitive string.
+	 *
+	 * @param pString: The primitive string.
+	 */
+	FastString(const Type* pString) : FastString(pString, GetDefaultMemoryResource()) {}
+
+	/**
+	 * Construct the string object using a primitive string.
+	 *
+	 * @param pString: The primitive string.
+	 * @param pResource: The memory resource to allocate memory from.
+	 */
+	FastString(const Type* pString, MemoryResource* pResource) : FastString(pString, String::GetStrLength(pString), pResource) {}
+
+	/**
+	 * Construct the string object using a number of characters from a primitive string.
+	 *
+	 * @param pString: The primitive string.
+	 * @param length: The number of characters to copy.
+	 * @param pResource: The memory resource to allocate memory from.
+	 */
+	FastString(const Type* pString, size_t length, MemoryResource* pResource = GetDefaultMemoryResource()) : pResource(pResource)
+	{
+		setInlineSize(0);
+		append(pString, length);
+	}
+
+	/**
+	 * Construct the string object using a String.
+	 *
+	 * @param str: The string.
+	 * @param pResource: The memory resource to allocate memory from.
+	 */
+	explicit FastString(const String& str, MemoryResource* pResource = GetDefaultMemoryResource()) : FastString(str.str(), str.size(), pResource) {}
+
+	/**
+	 * The copy constructor.
+	 * The copy allocates from the same memory resource.
+	 *
+	 * @param str: The other string.
+	 */
+	FastString(const FastString& str) : FastString(str.str(), str.size(), str.pResource) {}
+
+	/**
+	 * The move constructor.
+	 *
+	 * @param str: The other string.
+	 */
+	FastString(FastString&& str) noexcept
+	{
+		// Both representations can be moved by copying the bytes.
+		std::memcpy(static_cast<void*>(this), &str, sizeof(FastString));
+		str.setInlineSize(0);
+	}
 
 	/**
 	 * Default destructor.
 	 */
-	~FastString() {}
+	~FastString()
+	{
+		releaseHeap();
+	}
+
+	/**
+	 * Get the stored primitive string. This is always null terminated.
+	 */
+	const Type* str() const noexcept { return isInline() ? mInline : mHeap.pData; }
+
+	/**
+	 * Get the stored characters.
+	 */
+	Type* data() noexcept { return isInline() ? mInline : mHeap.pData; }
+
+	/**
+	 * Get the stored characters.
+	 */
+	const Type* data() const noexcept { return str(); }
+
+	/**
+	 * Get a view of the characters.
+	 */
+	View view() const noexcept { return View(data(), size()); }
+
+	/**
+	 * Get the size of the primitive type in bytes.
+	 */
+	static constexpr size_t typeSize() noexcept { return sizeof(Type); }
+
+	/**
+	 * Get the number of characteres stored in the object.
+	 */
+	size_t size() const noexcept { return isInline() ? InlineCapacity - static_cast<size_t>(mInline[InlineCapacity]) : mHeap.length; }
+
+	/**
+	 * Get the number of characters which can be stored without reallocating.
+	 */
+	size_t capacity() const noexcept { return isInline() ? InlineCapacity : mHeap.capacity & ~HeapFlag; }
+
+	/**
+	 * Check if the string is empty.
+	 */
+	bool empty() const noexcept { return size() == 0; }
+
+	/**
+	 * Get the memory resource the string allocates from.
+	 */
+	MemoryResource* getMemoryResource() const noexcept { return pResource; }
+
+	/**
+	 * Check if the characters are stored inside the object.
+	 */
+	bool isInline() const noexcept { return !(reinterpret_cast<const unsigned char*>(this)[sizeof(HeapData) - 1] & 0x80); }
+
+	/**
+	 * Clear all the values of the string and release the allocation.
+	 */
+	void clear() noexcept
+	{
+		releaseHeap();
+		setInlineSize(0);
+	}
+
+	/**
+	 * Make sure that a number of characters can be stored without reallocating.
+	 *
+	 * @param count: The number of characters.
+	 */
+	void reserve(size_t count)
+	{
+		if (count > capacity())
+			reallocate(count);
+	}
+
+	/**
+	 * Append a number of characters.
+	 *
+	 * @param pString: The characters to be appended.
+	 * @param count: The number of characters.
+	 */
+	void append(const Type* pString, size_t count)
+	{
+		const size_t oldSize = size();
+		const size_t newSize = oldSize + count;
+
+		// Grow geometrically so that repeated appends are amortized O(1).
+		if (newSize > capacity())
+		{
+			// The source could be a part of this string, which moves when reallocating.
+			const Type* pOld = data();
+			const bool bAliases = pString >= pOld && pString < pOld + oldSize;
+			const size_t offset = bAliases ? static_cast<size_t>(pString - pOld) : 0;
+
+			const size_t doubled = capacity() * 2;
+			reallocate(newSize > doubled ? newSize : doubled);
+
+			if (bAliases)
+				pString = data() + offset;
+		}
+
+		// The source could be a part of this string, so use memmove.
+		std::memmove(data() + oldSize, pString, count * typeSize());
+		setSize(newSize);
+	}
+
+	/**
+	 * Append a character to the string.
+	 *
+	 * @param character: The character to be appended.
+	 */
+	void append(Type character)
+	{
+		append(&character, 1);
+	}
+
+	/**
+	 * Begin iterator method.
+	 */
+	Type* begin() noexcept { return data(); }
+
+	/**
+	 * Begin iterator method.
+	 */
+	const Type* begin() const noexcept { return data(); }
+
+	/**
+	 * The end iterator method.
+	 */
+	Type* end() noexcept { return data() + size(); }
+
+	/**
+	 * The end iterator method.
+	 */
+	const Type* end() const noexcept { return data() + size(); }
+
+	/**
+	 * Access a character in a given index.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	Type& at(long long index)
+	{
+		// Process negative indexes.
+		if (index < 0)
+			index = static_cast<long long>(size()) + index;
+
+		return data()[index];
+	}
+
+	/**
+	 * Access a character in a given index.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	const Type at(long long index) const
+	{
+		// Process negative indexes.
+		if (index < 0)
+			index = static_cast<long long>(size()) + index;
+
+		return data()[index];
+	}
+
+	/**
+	 * Create a sub string using the current string.
+	 *
+	 * The sub string is made using String[startIndex] and String[endIndex - 1] inclusive.
+	 *
+	 * @param startIndex: The start index to copy data from.
+	 * @param endIndex: The end index to copy data.
+	 */
+	FastString subString(long long startIndex, long long endIndex) const
+	{
+		// Process the indexes.
+		if (startIndex < 0)
+			startIndex = static_cast<long long>(size()) + startIndex;
+
+		if (endIndex < 0)
+			endIndex = static_cast<long long>(size()) + endIndex;
+
+		return FastString(data() + startIndex, static_cast<size_t>(endIndex - startIndex), pResource);
+	}
+
+	/**
+	 * Find if a character is present in the string and return its index if found.
+	 * The method returns -1 if the character is not found.
+	 *
+	 * @param character: The character to be searched.
+	 */
+	long long find(Type character) const
+	{
+		return view().find(character);
+	}
+
+	/**
+	 * Find if a string is present in this string and return the index of the first character if found.
+	 * The method returns -1 if the string is not found or if it is empty.
+	 *
+	 * @param str: The string to be searched for.
+	 */
+	long long find(View str) const
+	{
+		return view().find(str);
+	}
+
+	/**
+	 * Generate a hash using the current string. This is equal to the hash of a String or a view with the same
+	 * characters.
+	 */
+	size_t hash() const noexcept { return view().hash(); }
+
+	/**
+	 * Convert this object's data to a String.
+	 */
+	String toString() const { return String(data(), size()); }
+
+	/**
+	 * Convert this object's data to the standard template string object.
+	 */
+	TypeSTD toStandard() const { return TypeSTD(data(), size()); }
+
+public:
+	/**
+	 * Assignment operator (primitive string).
+	 *
+	 * @param pString: The primitive string.
+	 */
+	FastString& operator=(const Type* pString)
+	{
+		setSize(0);
+		append(pString, String::GetStrLength(pString));
+
+		return *this;
+	}
+
+	/**
+	 * Assignment operator (copy).
+	 * The existing allocation is reused if it is large enough.
+	 *
+	 * @param str: The other string.
+	 */
+	FastString& operator=(const FastString& str)
+	{
+		if (this != &str)
+		{
+			setSize(0);
+			append(str.data(), str.size());
+		}
+
+		return *this;
+	}
+
+	/**
+	 * Assignment operator (move).
+	 *
+	 * @param str: The other string.
+	 */
+	FastString& operator=(FastString&& str) noexcept
+	{
+		if (this != &str)
+		{
+			releaseHeap();
+			std::memcpy(static_cast<void*>(this), &str, sizeof(FastString));
+			str.setInlineSize(0);
+		}
+
+		return *this;
+	}
+
+	/**
+	 * Concatenate a primitive string to the stored string.
+	 *
+	 * @param pString: The primitive string.
+	 */
+	FastString& operator+=(const Type* pString)
+	{
+		append(pString, String::GetStrLength(pString));
+		return *this;
+	}
+
+	/**
+	 * Concatenate a string to the stored string.
+	 *
+	 * @param str: The other string.
+	 */
+	FastString& operator+=(const FastString& str)
+	{
+		append(str.data(), str.size());
+		return *this;
+	}
+
+	/**
+	 * Concatenate a character to the stored string.
+	 *
+	 * @param character: The character.
+	 */
+	FastString& operator+=(Type character)
+	{
+		append(character);
+		return *this;
+	}
+
+	/**
+	 * Is equal operator.
+	 *
+	 * @param pString: The primitive string.
+	 */
+	bool operator==(const Type* pString) const
+	{
+		const size_t length = size();
+		return length == String::GetStrLength(pString) && StringKernels::Equal(data(), pString, length);
+	}
+
+	/**
+	 * Is equal operator.
+	 *
+	 * @param other: The other string.
+	 */
+	bool operator==(const FastString& other) const
+	{
+		const size_t length = size();
+		return length == other.size() && StringKernels::Equal(data(), other.data(), length);
+	}
+
+	/**
+	 * Convert the string to a view.
+	 */
+	operator View() const noexcept { return view(); }
+
+	/**
+	 * Index operator.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	Type& operator[](long long index)
+	{
+		return at(index);
+	}
+
+	/**
+	 * Index operator.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	const Type operator[](long long index) const
+	{
+		return at(index);
+	}
+
+private:
+	/**
+	 * Switch to the inline mode with a number of characters, without touching the characters before it.
+	 *
+	 * @param length: The number of characters. This must not be greater than InlineCapacity.
+	 */
+	void setInlineSize(size_t length) noexcept
+	{
+		assert(length <= InlineCapacity);
+
+		mInline[length] = 0;
+		mInline[InlineCapacity] = static_cast<Type>(InlineCapacity - length);
+	}
+
+	/**
+	 * Set the number of characters and write the null terminator.
+	 *
+	 * @param length: The number of characters. This must not be greater than the capacity.
+	 */
+	void setSize(size_t length) noexcept
+	{
+		assert(length <= capacity());
+
+		// An inline string never holds more than InlineCapacity characters. Checking the length first lets the
+		// compiler see that the inline write stays inside the buffer.
+		if (length <= InlineCapacity && isInline())
+			setInlineSize(length);
+		else
+		{
+			mHeap.length = length;
+			mHeap.pData[length] = 0;
+		}
+	}
+
+	/**
+	 * Move the characters to a new heap block.
+	 *
+	 * @param newCapacity: The number of characters the block should fit (excluding '\0').
+	 */
+	void reallocate(size_t newCapacity)
+	{
+		const size_t length = size();
+		Type* pBlock = static_cast<Type*>(pResource->allocate((newCapacity + 1) * typeSize(), alignof(Type)));
+		std::memcpy(pBlock, data(), (length + 1) * typeSize());
+
+		releaseHeap();
+		mHeap.pData = pBlock;
+		mHeap.length = length;
+		mHeap.capacity = newCapacity | HeapFlag;
+	}
+
+	/**
+	 * Release the heap block if the string is in the heap mode.
+	 */
+	void releaseHeap() noexcept
+	{
+		if (!isInline())
+			pResource->deallocate(mHeap.pData, (capacity() + 1) * typeSize(), alignof(Type));
+	}
 
 private:
-	Type* pString = nullptr;	// The primitive string pointer.
-};
\ No newline at end of file
+	union {
+		HeapData mHeap;									// Heap representation.
+		Type mInline[sizeof(HeapData) / sizeof(Type)];	// Inline representation.
+	};
+
+	MemoryResource* pResource = GetDefaultMemoryResource();	// The memory resource used to allocate memory.
+};
+
+/**
+ * Standard hash specialization, so that the string can be used as a key of the standard containers.
+ */
+template<>
+struct std::hash<FastString> {
+	size_t operator()(const FastString& str) const noexcept { return str.hash(); }
+};
@@ -0,0 +1,153 @@
+#include "FastString.h"
+
+#include <benchmark/benchmark.h>
+
+/**
+ * Memory resource which counts the allocations it forwards to the default resource.
+ */
+class CountingMemoryResource final : public MemoryResource {
+public:
+	/**
+	 * Allocate a block of memory and count it.
+	 *
+	 * @param byteSize: The size of the block in bytes.
+	 * @param alignment: The alignment of the block.
+	 */
+	void* allocate(size_t byteSize, size_t alignment) override
+	{
+		mAllocationCount++;
+		return GetDefaultMemoryResource()->allocate(byteSize, alignment);
+	}
+
+	/**
+	 * Deallocate a block of memory.
+	 *
+	 * @param pBlock: The block to be deallocated.
+	 * @param byteSize: The size of the block in bytes.
+	 * @param alignment: The alignment of the block.
+	 */
+	void deallocate(void* pBlock, size_t byteSize, size_t alignment) override
+	{
+		GetDefaultMemoryResource()->deallocate(pBlock, byteSize, alignment);
+	}
+
+	size_t mAllocationCount = 0;	// The number of allocations made.
+};
+
+/**
+ * Identifier sized strings, as found in component, uniform and asset names.
+ */
+static const char* const Identifiers[] = {
+	"id", "name", "position", "velocity", "Transform", "uModelMatrix", "uViewProjection", "m_vertexBuffer",
+	"ComponentRegistry", "diffuseTexture", "shadowMapSampler", "gl_Position", "normalMatrix", "boneWeights",
+	"PlayerController", "MeshRendererComponent", "uLightDirection[0]", "assets/textures/rock_diffuse.png",
+};
+
+constexpr size_t IdentifierCount = sizeof(Identifiers) / sizeof(Identifiers[0]);
+
+/**
+ * Construct, copy and compare identifier strings using String.
+ */
+static void BM_StringIdentifiers(benchmark::State& state)
+{
+	CountingMemoryResource resource;
+
+	for (auto _ : state)
+	{
+		for (size_t index = 0; index < IdentifierCount; index++)
+		{
+			String name(Identifiers[index], &resource);
+			String copy(name);
+			benchmark::DoNotOptimize(copy == name);
+		}
+	}
+
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(resource.mAllocationCount) / (state.iterations() * IdentifierCount));
+	state.SetItemsProcessed(state.iterations() * IdentifierCount);
+}
+
+BENCHMARK(BM_StringIdentifiers);
+
+/**
+ * Construct, copy and compare identifier strings using FastString.
+ */
+static void BM_FastStringIdentifiers(benchmark::State& state)
+{
+	CountingMemoryResource resource;
+
+	for (auto _ : state)
+	{
+		for (size_t index = 0; index < IdentifierCount; index++)
+		{
+			FastString name(Identifiers[index], &resource);
+			FastString copy(name);
+			benchmark::DoNotOptimize(copy == name);
+		}
+	}
+
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(resource.mAllocationCount) / (state.iterations() * IdentifierCount));
+	state.SetItemsProcessed(state.iterations() * IdentifierCount);
+}
+
+BENCHMARK(BM_FastStringIdentifiers);
+
+/**
+ * Build short qualified names by concatenation using String.
+ */
+static void BM_StringConcatenate(benchmark::State& state)
+{
+	CountingMemoryResource resource;
+
+	for (auto _ : state)
+	{
+		String name(&resource);
+		name += "Entity";
+		name += ".";
+		name += "Transform";
+
+		benchmark::DoNotOptimize(name.str());
+	}
+
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(resource.mAllocationCount) / state.iterations());
+}
+
+BENCHMARK(BM_StringConcatenate);
+
+/**
+ * Build short qualified names by concatenation using FastString.
+ */
+static void BM_FastStringConcatenate(benchmark::State& state)
+{
+	CountingMemoryResource resource;
+
+	for (auto _ : state)
+	{
+		FastString name(&resource);
+		name += "Entity";
+		name += ".";
+		name += "Transform";
+
+		benchmark::DoNotOptimize(name.str());
+	}
+
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(resource.mAllocationCount) / state.iterations());
+}
+
+BENCHMARK(BM_FastStringConcatenate);
+
+/**
+ * Convert between String and FastString.
+ */
+static void BM_FastStringConversion(benchmark::State& state)
+{
+	const String source("uViewProjection");
+
+	for (auto _ : state)
+	{
+		FastString fast(source);
+		String back = fast.toString();
+		benchmark::DoNotOptimize(back.str());
+	}
+}
+
+BENCHMARK(BM_FastStringConversion);
@@ -0,0 +1,227 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+	#include <intrin.h>
+
+#endif // _MSC_VER
+
+/**
+ * Hash algorithms for byte ranges.
+ * Every algorithm is a policy type with a static Calculate function, so the containers and strings can be
+ * parameterized with the algorithm to use. DefaultHash is used when no algorithm is given.
+ *
+ * The hashes are meant for hash tables, not for cryptography, and they are not stable across machines with
+ * different endianness.
+ */
+namespace Hashing {
+	/**
+	 * Multiply two 64 bit values and return the low and high halves of the 128 bit product.
+	 *
+	 * @param low: The first value, replaced by the low half of the product.
+	 * @param high: The second value, replaced by the high half of the product.
+	 */
+	inline void Multiply128(uint64_t& low, uint64_t& high) noexcept
+	{
+#if defined(__SIZEOF_INT128__)
+		const __uint128_t product = static_cast<__uint128_t>(low) * high;
+		low = static_cast<uint64_t>(product);
+		high = static_cast<uint64_t>(product >> 64);
+
+#elif defined(_MSC_VER) && defined(_M_X64)
+		low = _umul128(low, high, &high);
+
+#else
+		const uint64_t lowLow = (low & 0xFFFFFFFF) * (high & 0xFFFFFFFF);
+		const uint64_t highLow = (low >> 32) * (high & 0xFFFFFFFF);
+		const uint64_t lowHigh = (low & 0xFFFFFFFF) * (high >> 32);
+		const uint64_t highHigh = (low >> 32) * (high >> 32);
+		const uint64_t middle = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + lowHigh;
+
+		low = (middle << 32) | (lowLow & 0xFFFFFFFF);
+		high = highHigh + (highLow >> 32) + (middle >> 32);
+
+#endif // __SIZEOF_INT128__
+	}
+
+	/**
+	 * Multiply two values and fold the 128 bit product into 64 bits.
+	 *
+	 * @param first: The first value.
+	 * @param second: The second value.
+	 */
+	inline uint64_t MultiplyMix(uint64_t first, uint64_t second) noexcept
+	{
+		Multiply128(first, second);
+		return first ^ second;
+	}
+
+	/**
+	 * Read an unaligned 64 bit value.
+	 *
+	 * @param pData: The bytes to read.
+	 */
+	inline uint64_t Read64(const uint8_t* pData) noexcept
+	{
+		uint64_t value;
+		std::memcpy(&value, pData, sizeof(value));
+		return value;
+	}
+
+	/**
+	 * Read an unaligned 32 bit value.
+	 *
+	 * @param pData: The bytes to read.
+	 */
+	inline uint64_t Read32(const uint8_t* pData) noexcept
+	{
+		uint32_t value;
+		std::memcpy(&value, pData, sizeof(value));
+		return value;
+	}
+
+	/**
+	 * Hash algorithm based on the wyhash construction.
+	 * The input is consumed 48 bytes at a time using three independent 128 bit multiply and fold lanes, and inputs
+	 * of up to 16 bytes are read using at most four overlapping loads without a loop, so short keys such as
+	 * identifiers are hashed in a few cycles.
+	 */
+	struct WyHash {
+		static constexpr uint64_t Secret[4] = { 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull };
+
+		/**
+		 * Calculate the hash of a byte range.
+		 *
+		 * @param pData: The bytes.
+		 * @param size: The number of bytes.
+		 * @param seed: The seed.
+		 */
+		static uint64_t Calculate(const void* pData, size_t size, uint64_t seed = 0) noexcept
+		{
+			const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+			seed ^= MultiplyMix(seed ^ Secret[0], Secret[1]);
+
+			uint64_t first = 0, second = 0;
+			if (size <= 16)
+			{
+				if (size >= 4)
+				{
+					// Two pairs of overlapping 4 byte reads cover 4 to 16 bytes.
+					const size_t offset = (size >> 3) << 2;
+					first = (Read32(pBytes) << 32) | Read32(pBytes + offset);
+					second = (Read32(pBytes + size - 4) << 32) | Read32(pBytes + size - 4 - offset);
+				}
+				else if (size > 0)
+				{
+					first = (static_cast<uint64_t>(pBytes[0]) << 16) | (static_cast<uint64_t>(pBytes[size >> 1]) << 8) | pBytes[size - 1];
+				}
+			}
+			else
+			{
+				size_t remaining = size;
+				if (remaining > 48)
+				{
+					uint64_t lane1 = seed, lane2 = seed;
+					do
+					{
+						seed = MultiplyMix(Read64(pBytes) ^ Secret[1], Read64(pBytes + 8) ^ seed);
+						lane1 = MultiplyMix(Read64(pBytes + 16) ^ Secret[2], Read64(pBytes + 24) ^ lane1);
+						lane2 = MultiplyMix(Read64(pBytes + 32) ^ Secret[3], Read64(pBytes + 40) ^ lane2);
+						pBytes += 48;
+						remaining -= 48;
+					} while (remaining > 48);
+
+					seed ^= lane1 ^ lane2;
+				}
+
+				while (remaining > 16)
+				{
+					seed = MultiplyMix(Read64(pBytes) ^ Secret[1], Read64(pBytes + 8) ^ seed);
+					pBytes += 16;
+					remaining -= 16;
+				}
+
+				// The last 16 bytes may overlap the bytes which were already consumed.
+				first = Read64(pBytes + remaining - 16);
+				second = Read64(pBytes + remaining - 8);
+			}
+
+			first ^= Secret[1];
+			second ^= seed;
+			Multiply128(first, second);
+
+			return MultiplyMix(first ^ Secret[0] ^ size, second ^ Secret[1]);
+		}
+	};
+
+	/**
+	 * The 64 bit FNV-1a hash algorithm.
+	 * This processes a single byte at a time, so it is much slower than WyHash for anything but the shortest keys.
+	 * It does not avalanche either: the high bits mix poorly for keys which only differ in their last bytes.
+	 */
+	struct FNV1aHash {
+		/**
+		 * Calculate the hash of a byte range.
+		 *
+		 * @param pData: The bytes.
+		 * @param size: The number of bytes.
+		 * @param seed: The seed.
+		 */
+		static uint64_t Calculate(const void* pData, size_t size, uint64_t seed = 0) noexcept
+		{
+			const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+
+			uint64_t hash = 14695981039346656037ull ^ seed;
+			for (size_t index = 0; index < size; index++)
+				hash = (hash ^ pBytes[index]) * 1099511628211ull;
+
+			return hash;
+		}
+	};
+
+	/**
+	 * The hash algorithm used when none is specified.
+	 */
+	using DefaultHash = WyHash;
+
+	/**
+	 * Calculate the hash of a byte range.
+	 *
+	 * @tparam Algorithm: The hash algorithm.
+	 * @param pData: The bytes.
+	 * @param size: The number of bytes.
+	 * @param seed: The seed.
+	 */
+	template<class Algorithm = DefaultHash>
+	inline uint64_t HashBytes(const void* pData, size_t size, uint64_t seed = 0) noexcept
+	{
+		return Algorithm::Calculate(pData, size, seed);
+	}
+
+	/**
+	 * Hash function object for the keys of hash tables.
+	 * Keys with a hash() member function (the strings and views) use it, and keys whose bytes are their value
+	 * (integers, enums and pointers) are hashed using the algorithm. Other keys use std::hash with the result mixed,
+	 * as the standard hashes of many types are the identity and the tables take bits from both ends of the hash.
+	 *
+	 * @tparam Key: The key type.
+	 * @tparam Algorithm: The hash algorithm.
+	 */
+	template<class Key, class Algorithm = DefaultHash>
+	struct Hasher {
+		uint64_t operator()(const Key& key) const noexcept
+		{
+			if constexpr (requires { { key.hash() } -> std::convertible_to<uint64_t>; })
+				return key.hash();
+			else if constexpr (std::has_unique_object_representations_v<Key>)
+				return Algorithm::Calculate(&key, sizeof(Key));
+			else
+				return MultiplyMix(std::hash<Key>()(key), 0x9e3779b97f4a7c15ull);
+		}
+	};
+}
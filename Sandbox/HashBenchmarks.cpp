@@ -0,0 +1,99 @@
+#include "FastString.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Create a block of random bytes.
+ *
+ * @param size: The number of bytes.
+ */
+static std::vector<uint8_t> CreateRandomBytes(size_t size)
+{
+	std::vector<uint8_t> bytes(size);
+
+	std::mt19937 engine(static_cast<uint32_t>(size));
+	for (auto& byte : bytes)
+		byte = static_cast<uint8_t>(engine());
+
+	return bytes;
+}
+
+/**
+ * Hash a byte range using an algorithm.
+ */
+template<class Algorithm>
+static void BM_HashBytes(benchmark::State& state)
+{
+	const std::vector<uint8_t> bytes = CreateRandomBytes(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+		benchmark::DoNotOptimize(Hashing::HashBytes<Algorithm>(bytes.data(), bytes.size()));
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_HashBytes, Hashing::WyHash)->RangeMultiplier(4)->Range(4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_HashBytes, Hashing::FNV1aHash)->RangeMultiplier(4)->Range(4, 1 << 16);
+
+/**
+ * Hash a byte range using std::hash<std::string_view> for reference.
+ */
+static void BM_HashBytesStandard(benchmark::State& state)
+{
+	const std::vector<uint8_t> bytes = CreateRandomBytes(static_cast<size_t>(state.range(0)));
+	const std::string_view view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+	for (auto _ : state)
+		benchmark::DoNotOptimize(std::hash<std::string_view>()(view));
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_HashBytesStandard)->RangeMultiplier(4)->Range(4, 1 << 16);
+
+/**
+ * Hash the same String repeatedly. This measures the cache when STRING_CACHE_HASH is defined.
+ */
+static void BM_StringHashRepeated(benchmark::State& state)
+{
+	const String string(String::TypeSTD(static_cast<size_t>(state.range(0)), TEXT('x')).c_str());
+	for (auto _ : state)
+		benchmark::DoNotOptimize(string.hash());
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_StringHashRepeated)->RangeMultiplier(16)->Range(16, 1 << 12);
+
+/**
+ * Build a set of identifier like keys ("entity_<n>") keyed by the String hash.
+ * The old hash (XOR of every character times its index) collided heavily on such keys.
+ */
+static void BM_StringHashSetInsert(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	std::vector<String> keys(count);
+	for (size_t index = 0; index < count; index++)
+	{
+		keys[index] = TEXT("entity_");
+		for (size_t value = index; value; value /= 10)
+			keys[index].append(static_cast<String::Type>(TEXT('0') + value % 10));
+	}
+
+	for (auto _ : state)
+	{
+		std::unordered_set<String, StringHasher, std::equal_to<>> set;
+		set.reserve(count);
+		for (const auto& key : keys)
+			set.insert(key);
+
+		benchmark::DoNotOptimize(set.size());
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_StringHashSetInsert)->RangeMultiplier(16)->Range(256, 1 << 16);
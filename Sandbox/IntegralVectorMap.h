@@ -0,0 +1,369 @@
+#pragma once
+#include "ArrayKernels.h"
+#include "VectorMap.h"
+
+#include <span>
+
+/**
+ * Sorted vector map for integer keys.
+ * Unlike the VectorMap, the keys are stored in their own column, separate from the values, so a search never pulls
+ * values into the cache and a cache line holds 16 32 bit keys rather than a few key value pairs. Lookups use
+ * ArrayKernels::LowerBound, which halves the range down to a cache line of keys and then counts the keys less than
+ * the searched key with SIMD comparisons.
+ *
+ * The interface follows the VectorMap, but as the keys and the values are not stored together the iterators return
+ * proxies: dereferencing gives a pair of references (first is the key and second is the value) and operator-> can
+ * be used to access them.
+ *
+ * @tparam K: The key type. This must be an integer type.
+ * @tparam V: The value type.
+ * @tparam A: The allocator type, which is rebound for the key and the value columns.
+ */
+template<typename K, typename V, typename A = std::allocator<std::pair<const K, V>>>
+class IntegralVectorMap {
+	static_assert(std::is_integral_v<K> && ArrayKernels::IsVectorizable<K>, "The keys must be integers!");
+
+	/**
+	 * Iterator over the entries of the map.
+	 *
+	 * @tparam Const: Whether the values are read only.
+	 */
+	template<bool Const>
+	class Iterator {
+		using Map = std::conditional_t<Const, const IntegralVectorMap, IntegralVectorMap>;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::pair<K, V>;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::pair<const K&, std::conditional_t<Const, const V&, V&>>;
+
+		/**
+		 * Proxy returned by operator->, holding the references of an entry.
+		 */
+		struct pointer {
+			reference entry;
+
+			const reference* operator->() const noexcept { return &entry; }
+		};
+
+	public:
+		/**
+		 * Default constructor.
+		 */
+		Iterator() noexcept = default;
+
+		/**
+		 * Construct the iterator.
+		 *
+		 * @param pMap: The map.
+		 * @param index: The index of the entry.
+		 */
+		Iterator(Map* pMap, size_t index) noexcept : pMap(pMap), mIndex(index) {}
+
+		/**
+		 * Convert the iterator to a const iterator.
+		 */
+		operator Iterator<true>() const noexcept requires (!Const) { return Iterator<true>(pMap, mIndex); }
+
+		/**
+		 * Get the index of the entry.
+		 */
+		size_t index() const noexcept { return mIndex; }
+
+		reference operator*() const noexcept { return reference(pMap->mKeys[mIndex], pMap->mValues[mIndex]); }
+		pointer operator->() const noexcept { return pointer{ **this }; }
+		reference operator[](difference_type offset) const noexcept { return *(*this + offset); }
+
+		Iterator& operator++() noexcept { mIndex++; return *this; }
+		Iterator& operator--() noexcept { mIndex--; return *this; }
+		Iterator operator++(int) noexcept { Iterator previous = *this; mIndex++; return previous; }
+		Iterator operator--(int) noexcept { Iterator previous = *this; mIndex--; return previous; }
+		Iterator& operator+=(difference_type offset) noexcept { mIndex += offset; return *this; }
+		Iterator& operator-=(difference_type offset) noexcept { mIndex -= offset; return *this; }
+		Iterator operator+(difference_type offset) const noexcept { return Iterator(pMap, mIndex + offset); }
+		Iterator operator-(difference_type offset) const noexcept { return Iterator(pMap, mIndex - offset); }
+		difference_type operator-(const Iterator& other) const noexcept { return static_cast<difference_type>(mIndex - other.mIndex); }
+
+		bool operator==(const Iterator& other) const noexcept { return mIndex == other.mIndex; }
+		auto operator<=>(const Iterator& other) const noexcept { return mIndex <=> other.mIndex; }
+
+	private:
+		Map* pMap = nullptr;
+		size_t mIndex = 0;
+	};
+
+public:
+	using key_type = K;
+	using mapped_type = V;
+	using allocator_type = A;
+	using value_type = std::pair<const key_type, mapped_type>;
+	using size_type = size_t;
+
+	using key_container_type = std::vector<key_type, typename std::allocator_traits<A>::template rebind_alloc<key_type>>;
+	using mapped_container_type = std::vector<mapped_type, typename std::allocator_traits<A>::template rebind_alloc<mapped_type>>;
+
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
+public:
+	/**
+	 * Default constructor.
+	 */
+	IntegralVectorMap() = default;
+
+	/**
+	 * Construct the map using an allocator.
+	 *
+	 * @param alloc: The allocator.
+	 */
+	explicit IntegralVectorMap(const allocator_type& alloc) : mKeys(alloc), mValues(alloc) {}
+
+	/**
+	 * Construct the map from entries in any order. The first entry with a key is kept.
+	 *
+	 * @param first: The first entry.
+	 * @param last: The end of the entries.
+	 * @param alloc: The allocator.
+	 */
+	template<class InputIterator>
+	IntegralVectorMap(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type())
+		: mKeys(alloc), mValues(alloc)
+	{
+		assignFromUnsorted(first, last);
+	}
+
+	/**
+	 * Replace the entries with entries in any order. The entries are sorted once.
+	 *
+	 * @param first: The first entry.
+	 * @param last: The end of the entries.
+	 * @param policy: The duplicate policy, called with the value which is kept and the value of a later entry with
+	 *	the same key (see VectorMap::assignFromUnsorted).
+	 */
+	template<class InputIterator, class Policy = KeepFirstDuplicate>
+	void assignFromUnsorted(InputIterator first, InputIterator last, Policy policy = Policy())
+	{
+		std::vector<std::pair<key_type, mapped_type>> entries(first, last);
+		std::stable_sort(entries.begin(), entries.end(), [](const auto& left, const auto& right) { return left.first < right.first; });
+
+		clear();
+		mKeys.reserve(entries.size());
+		mValues.reserve(entries.size());
+		for (auto& entry : entries)
+		{
+			if (!mKeys.empty() && mKeys.back() == entry.first)
+			{
+				policy(mValues.back(), entry.second);
+			}
+			else
+			{
+				mKeys.push_back(entry.first);
+				mValues.push_back(std::move(entry.second));
+			}
+		}
+	}
+
+	iterator begin() noexcept { return iterator(this, 0); }
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+	iterator end() noexcept { return iterator(this, size()); }
+	const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+	/**
+	 * Get the keys, in ascending order.
+	 */
+	std::span<const key_type> keys() const noexcept { return { mKeys.data(), mKeys.size() }; }
+
+	/**
+	 * Get the values, in the order of their keys.
+	 */
+	std::span<mapped_type> values() noexcept { return { mValues.data(), mValues.size() }; }
+
+	/**
+	 * Get the values, in the order of their keys.
+	 */
+	std::span<const mapped_type> values() const noexcept { return { mValues.data(), mValues.size() }; }
+
+	/**
+	 * Get the number of entries.
+	 */
+	size_type size() const noexcept { return mKeys.size(); }
+
+	/**
+	 * Check if the map is empty.
+	 */
+	bool empty() const noexcept { return mKeys.empty(); }
+
+	/**
+	 * Remove all the entries.
+	 */
+	void clear() noexcept
+	{
+		mKeys.clear();
+		mValues.clear();
+	}
+
+	/**
+	 * Make sure that a number of entries can be stored without reallocating.
+	 *
+	 * @param count: The number of entries.
+	 */
+	void reserve(size_type count)
+	{
+		mKeys.reserve(count);
+		mValues.reserve(count);
+	}
+
+	/**
+	 * Find the first entry whose key is not less than a key.
+	 *
+	 * @param key: The key.
+	 */
+	iterator lower_bound(key_type key) noexcept { return iterator(this, lowerBoundIndex(key)); }
+
+	/**
+	 * Find the first entry whose key is not less than a key.
+	 *
+	 * @param key: The key.
+	 */
+	const_iterator lower_bound(key_type key) const noexcept { return const_iterator(this, lowerBoundIndex(key)); }
+
+	/**
+	 * Find the first entry whose key is greater than a key.
+	 *
+	 * @param key: The key.
+	 */
+	iterator upper_bound(key_type key) noexcept { return iterator(this, upperBoundIndex(key)); }
+
+	/**
+	 * Find the first entry whose key is greater than a key.
+	 *
+	 * @param key: The key.
+	 */
+	const_iterator upper_bound(key_type key) const noexcept { return const_iterator(this, upperBoundIndex(key)); }
+
+	/**
+	 * Find the entry of a key. Returns end() if the key is not in the map.
+	 *
+	 * @param key: The key.
+	 */
+	iterator find(key_type key) noexcept { return iterator(this, findIndex(key)); }
+
+	/**
+	 * Find the entry of a key. Returns end() if the key is not in the map.
+	 *
+	 * @param key: The key.
+	 */
+	const_iterator find(key_type key) const noexcept { return const_iterator(this, findIndex(key)); }
+
+	/**
+	 * Count the entries of a key (0 or 1).
+	 *
+	 * @param key: The key.
+	 */
+	size_type count(key_type key) const noexcept { return findIndex(key) != size(); }
+
+	/**
+	 * Insert an entry if its key is not in the map.
+	 * Returns the entry of the key and whether the entry was inserted.
+	 *
+	 * @param entry: The entry.
+	 */
+	std::pair<iterator, bool> insert(const value_type& entry)
+	{
+		const size_type index = lowerBoundIndex(entry.first);
+		if (index != size() && mKeys[index] == entry.first)
+			return std::make_pair(iterator(this, index), false);
+
+		mKeys.insert(mKeys.begin() + index, entry.first);
+		mValues.insert(mValues.begin() + index, entry.second);
+		return std::make_pair(iterator(this, index), true);
+	}
+
+	/**
+	 * Remove an entry.
+	 * Returns the entry after the removed one.
+	 *
+	 * @param where: The entry.
+	 */
+	iterator erase(const_iterator where)
+	{
+		mKeys.erase(mKeys.begin() + where.index());
+		mValues.erase(mValues.begin() + where.index());
+		return iterator(this, where.index());
+	}
+
+	/**
+	 * Remove the entry of a key, if the key is in the map.
+	 *
+	 * @param key: The key.
+	 */
+	void erase(key_type key)
+	{
+		const size_type index = findIndex(key);
+		if (index != size())
+			erase(const_iterator(this, index));
+	}
+
+	/**
+	 * Swap the entries with another map.
+	 *
+	 * @param other: The other map.
+	 */
+	void swap(IntegralVectorMap& other) noexcept
+	{
+		mKeys.swap(other.mKeys);
+		mValues.swap(other.mValues);
+	}
+
+	/**
+	 * Access the value of a key, inserting a default value if the key is not in the map.
+	 *
+	 * @param key: The key.
+	 */
+	mapped_type& operator[](key_type key)
+	{
+		const size_type index = lowerBoundIndex(key);
+		if (index == size() || mKeys[index] != key)
+		{
+			mKeys.insert(mKeys.begin() + index, key);
+			mValues.insert(mValues.begin() + index, mapped_type());
+		}
+
+		return mValues[index];
+	}
+
+private:
+	/**
+	 * Get the index of the first key which is not less than a key.
+	 *
+	 * @param key: The key.
+	 */
+	size_type lowerBoundIndex(key_type key) const noexcept { return ArrayKernels::LowerBound(mKeys.data(), mKeys.size(), key); }
+
+	/**
+	 * Get the index of the first key which is greater than a key.
+	 *
+	 * @param key: The key.
+	 */
+	size_type upperBoundIndex(key_type key) const noexcept
+	{
+		const size_type index = lowerBoundIndex(key);
+		return index != size() && mKeys[index] == key ? index + 1 : index;
+	}
+
+	/**
+	 * Get the index of a key, or the size if the key is not in the map.
+	 *
+	 * @param key: The key.
+	 */
+	size_type findIndex(key_type key) const noexcept
+	{
+		const size_type index = lowerBoundIndex(key);
+		return index != size() && mKeys[index] == key ? index : size();
+	}
+
+private:
+	key_container_type mKeys;		// The keys, in ascending order.
+	mapped_container_type mValues;	// The values, in the order of their keys.
+};
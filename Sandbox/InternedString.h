@@ -0,0 +1,329 @@
+#pragma once
+#include "String.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+template<class Type>
+class BasicStringPool;
+
+/**
+ * Entry of the string pool. The null terminated characters are stored right after the entry.
+ *
+ * @tparam Type: The character type.
+ */
+template<class Type>
+struct InternedStringEntry {
+	size_t hash = 0;		// The hash of the characters (BasicStringView::hash).
+	uint32_t length = 0;	// The number of characters.
+	uint32_t id = 0;		// The id of the string, unique within its pool.
+
+	/**
+	 * Get the characters of the entry.
+	 */
+	const Type* characters() const noexcept { return reinterpret_cast<const Type*>(this + 1); }
+};
+
+/**
+ * Interned string.
+ * An interned string is a handle to the single copy of its characters stored in a string pool, so two interned
+ * strings of the same pool are equal exactly when they point to the same entry. Comparing and hashing is O(1) and
+ * the handle is as large as a pointer. The characters stay valid until the pool is destroyed.
+ *
+ * The default constructed interned string is the empty string.
+ *
+ * @tparam Type: The character type.
+ */
+template<class Type>
+class BasicInternedString {
+	friend class BasicStringPool<Type>;
+
+	/**
+	 * Construct the interned string using a pool entry.
+	 *
+	 * @param pEntry: The entry.
+	 */
+	explicit BasicInternedString(const InternedStringEntry<Type>* pEntry) noexcept : pEntry(pEntry) {}
+
+public:
+	// String view type.
+	using View = BasicStringView<Type>;
+
+public:
+	/**
+	 * Default constructor.
+	 */
+	BasicInternedString() noexcept = default;
+
+	/**
+	 * Intern a view in the default pool.
+	 *
+	 * @param view: The characters.
+	 */
+	explicit BasicInternedString(View view);
+
+	/**
+	 * Get the null terminated characters.
+	 */
+	const Type* str() const noexcept
+	{
+		static constexpr Type Empty[1] = {};
+		return pEntry ? pEntry->characters() : Empty;
+	}
+
+	/**
+	 * Get the number of characters.
+	 */
+	size_t size() const noexcept { return pEntry ? pEntry->length : 0; }
+
+	/**
+	 * Check if the string is empty.
+	 */
+	bool empty() const noexcept { return pEntry == nullptr; }
+
+	/**
+	 * Get a view of the characters.
+	 */
+	View view() const noexcept { return View(str(), size()); }
+
+	/**
+	 * Get the id of the string. Every string of a pool has a unique id, counting up from 1. The empty string is 0.
+	 */
+	uint32_t id() const noexcept { return pEntry ? pEntry->id : 0; }
+
+	/**
+	 * Get the hash of the characters. This is equal to the hash of a view with the same characters and is not
+	 * calculated again.
+	 */
+	size_t hash() const noexcept { return pEntry ? pEntry->hash : View().hash(); }
+
+public:
+	/**
+	 * Convert the string to a view.
+	 */
+	operator View() const noexcept { return view(); }
+
+	/**
+	 * Is equal operator.
+	 *
+	 * @param other: The other interned string. This must be from the same pool.
+	 */
+	bool operator==(const BasicInternedString<Type>& other) const noexcept { return pEntry == other.pEntry; }
+
+	/**
+	 * Is not equal operator.
+	 *
+	 * @param other: The other interned string. This must be from the same pool.
+	 */
+	bool operator!=(const BasicInternedString<Type>& other) const noexcept { return pEntry != other.pEntry; }
+
+private:
+	const InternedStringEntry<Type>* pEntry = nullptr;	// The pool entry, or nullptr for the empty string.
+};
+
+/**
+ * Thread safe string interning pool.
+ * The entries are stored in a linear arena, so they never move. They are indexed by an open addressing hash table
+ * of atomic entry pointers.
+ *
+ * Looking up a string which is already interned does not lock: the readers load the current table and probe it
+ * using acquire loads. Inserting locks a mutex, and publishes the fully initialized entry with a release store.
+ * When the table grows, the entries are copied to a new table which then replaces the current one. The old tables
+ * are kept until the pool is destroyed, because readers might still be probing them. Their size adds up to less
+ * than the size of the current table.
+ *
+ * @tparam Type: The character type.
+ */
+template<class Type>
+class BasicStringPool {
+	using Entry = InternedStringEntry<Type>;
+
+	/**
+	 * Hash table of entry pointers. The capacity is a power of two.
+	 */
+	struct Table {
+		/**
+		 * Construct the table.
+		 *
+		 * @param capacity: The number of slots. This must be a power of two.
+		 */
+		explicit Table(size_t capacity) : mask(capacity - 1), pSlots(new std::atomic<const Entry*>[capacity]()) {}
+
+		size_t mask = 0;
+		std::unique_ptr<std::atomic<const Entry*>[]> pSlots;
+	};
+
+public:
+	// String view type.
+	using View = BasicStringView<Type>;
+
+public:
+	/**
+	 * Default constructor.
+	 *
+	 * @param initialCapacity: The number of strings which can be interned before the table grows.
+	 */
+	explicit BasicStringPool(size_t initialCapacity = 512)
+	{
+		size_t capacity = 16;
+		while (capacity < initialCapacity * 2)
+			capacity *= 2;
+
+		mTables.emplace_back(std::make_unique<Table>(capacity));
+		pTable.store(mTables.back().get(), std::memory_order_release);
+	}
+
+	BasicStringPool(const BasicStringPool&) = delete;
+	BasicStringPool& operator=(const BasicStringPool&) = delete;
+
+	/**
+	 * Find an interned string without interning it. This does not lock.
+	 * Returns the empty interned string if the characters were not interned.
+	 *
+	 * @param view: The characters.
+	 */
+	BasicInternedString<Type> find(View view) const noexcept
+	{
+		if (view.empty())
+			return BasicInternedString<Type>();
+
+		return BasicInternedString<Type>(lookup(pTable.load(std::memory_order_acquire), view, view.hash()));
+	}
+
+	/**
+	 * Intern a string.
+	 * Strings which are already interned are found without locking.
+	 *
+	 * @param view: The characters.
+	 */
+	BasicInternedString<Type> intern(View view)
+	{
+		if (view.empty())
+			return BasicInternedString<Type>();
+
+		const size_t hash = view.hash();
+		if (const Entry* pEntry = lookup(pTable.load(std::memory_order_acquire), view, hash))
+			return BasicInternedString<Type>(pEntry);
+
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		// Another thread might have interned the string after the lookup.
+		Table* pCurrent = pTable.load(std::memory_order_relaxed);
+		if (const Entry* pEntry = lookup(pCurrent, view, hash))
+			return BasicInternedString<Type>(pEntry);
+
+		// Keep the load factor at or below 0.5.
+		if ((mCount + 1) * 2 > pCurrent->mask + 1)
+			pCurrent = grow(pCurrent);
+
+		// Copy the characters to the arena.
+		void* pBlock = mArena.allocate(sizeof(Entry) + (view.size() + 1) * sizeof(Type), alignof(Entry));
+		Entry* pEntry = new (pBlock) Entry{ hash, static_cast<uint32_t>(view.size()), static_cast<uint32_t>(++mCount) };
+
+		Type* pCharacters = const_cast<Type*>(pEntry->characters());
+		std::memcpy(pCharacters, view.data(), view.size() * sizeof(Type));
+		pCharacters[view.size()] = 0;
+
+		// Publish the entry. The release store makes the characters visible to the readers which load it.
+		pCurrent->pSlots[findFreeSlot(pCurrent, hash)].store(pEntry, std::memory_order_release);
+		return BasicInternedString<Type>(pEntry);
+	}
+
+	/**
+	 * Get the number of interned strings.
+	 */
+	size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mCount;
+	}
+
+private:
+	/**
+	 * Find an entry in a table.
+	 *
+	 * @param pCurrent: The table to search in.
+	 * @param view: The characters.
+	 * @param hash: The hash of the characters.
+	 */
+	static const Entry* lookup(const Table* pCurrent, View view, size_t hash) noexcept
+	{
+		for (size_t slot = hash & pCurrent->mask;; slot = (slot + 1) & pCurrent->mask)
+		{
+			const Entry* pEntry = pCurrent->pSlots[slot].load(std::memory_order_acquire);
+			if (!pEntry)
+				return nullptr;
+
+			if (pEntry->hash == hash && pEntry->length == view.size() && View(pEntry->characters(), pEntry->length) == view)
+				return pEntry;
+		}
+	}
+
+	/**
+	 * Find the first empty slot of a hash. Only called while holding the mutex.
+	 *
+	 * @param pCurrent: The table.
+	 * @param hash: The hash.
+	 */
+	static size_t findFreeSlot(const Table* pCurrent, size_t hash) noexcept
+	{
+		size_t slot = hash & pCurrent->mask;
+		while (pCurrent->pSlots[slot].load(std::memory_order_relaxed))
+			slot = (slot + 1) & pCurrent->mask;
+
+		return slot;
+	}
+
+	/**
+	 * Copy the entries to a table twice as large and publish it. Only called while holding the mutex.
+	 *
+	 * @param pCurrent: The current table.
+	 */
+	Table* grow(Table* pCurrent)
+	{
+		mTables.emplace_back(std::make_unique<Table>((pCurrent->mask + 1) * 2));
+		Table* pNew = mTables.back().get();
+
+		for (size_t index = 0; index <= pCurrent->mask; index++)
+			if (const Entry* pEntry = pCurrent->pSlots[index].load(std::memory_order_relaxed))
+				pNew->pSlots[findFreeSlot(pNew, pEntry->hash)].store(pEntry, std::memory_order_relaxed);
+
+		pTable.store(pNew, std::memory_order_release);
+		return pNew;
+	}
+
+private:
+	std::atomic<Table*> pTable = nullptr;		// The current table.
+	std::vector<std::unique_ptr<Table>> mTables;	// The current table and the tables it replaced.
+	LinearArena mArena;							// The storage of the entries.
+	mutable std::mutex mMutex;					// The mutex guarding the insertions.
+	size_t mCount = 0;							// The number of interned strings.
+};
+
+/**
+ * Get the default string pool of a character type.
+ */
+template<class Type = String::Type>
+inline BasicStringPool<Type>& GetDefaultStringPool()
+{
+	static BasicStringPool<Type> pool;
+	return pool;
+}
+
+template<class Type>
+inline BasicInternedString<Type>::BasicInternedString(View view) : BasicInternedString(GetDefaultStringPool<Type>().intern(view)) {}
+
+/**
+ * Standard hash specialization, so that interned strings can be used as keys of the standard containers.
+ */
+template<class Type>
+struct std::hash<BasicInternedString<Type>> {
+	size_t operator()(const BasicInternedString<Type>& str) const noexcept { return str.hash(); }
+};
+
+// Interned string using the primitive type of the String.
+using InternedString = BasicInternedString<String::Type>;
+
+// String pool using the primitive type of the String.
+using StringPool = BasicStringPool<String::Type>;
@@ -0,0 +1,189 @@
+#include "ComponentSystem.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <utility>
+
+/**
+ * Component types used to fill the registries.
+ */
+template<size_t Index>
+struct BenchmarkComponent {
+	float values[4] = {};
+};
+
+static constexpr size_t ComponentTypeCount = 64;
+
+/**
+ * Registry as it was before the type names were interned: the type names are stored as std::string and searched
+ * linearly.
+ */
+class StringKeyedRegistry {
+public:
+	template<class Type>
+	bool isRegistered() const
+	{
+		const std::string typeName = typeid(Type).name();
+		for (const auto& name : typeNames)
+			if (name == typeName)
+				return true;
+
+		return false;
+	}
+
+	template<class Type>
+	void registerType()
+	{
+		if (!isRegistered<Type>())
+			typeNames.push_back(typeid(Type).name());
+	}
+
+private:
+	std::vector<std::string> typeNames;
+};
+
+/**
+ * Register all the component types.
+ */
+template<class Registry, size_t... Indices>
+static void RegisterAll(Registry& registry, std::index_sequence<Indices...>)
+{
+	(registry.template registerType<BenchmarkComponent<Indices>>(), ...);
+}
+
+/**
+ * Check all the component types.
+ */
+template<class Registry, size_t... Indices>
+static size_t CheckAll(Registry& registry, std::index_sequence<Indices...>)
+{
+	return (static_cast<size_t>(registry.template isRegistered<BenchmarkComponent<Indices>>()) + ...);
+}
+
+/**
+ * Check every registered type using the std::string keyed registry.
+ */
+static void BM_RegistryLookupStringKeyed(benchmark::State& state)
+{
+	StringKeyedRegistry registry;
+	RegisterAll(registry, std::make_index_sequence<ComponentTypeCount>());
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(CheckAll(registry, std::make_index_sequence<ComponentTypeCount>()));
+
+	state.SetItemsProcessed(state.iterations() * ComponentTypeCount);
+}
+
+BENCHMARK(BM_RegistryLookupStringKeyed);
+
+/**
+ * Check every registered type using the interned type names of the ComponentRegistry.
+ */
+static void BM_RegistryLookupInterned(benchmark::State& state)
+{
+	ComponentRegistry registry;
+	RegisterAll(registry, std::make_index_sequence<ComponentTypeCount>());
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(CheckAll(registry, std::make_index_sequence<ComponentTypeCount>()));
+
+	state.SetItemsProcessed(state.iterations() * ComponentTypeCount);
+}
+
+BENCHMARK(BM_RegistryLookupInterned);
+
+/**
+ * Look up uniform attribute names in a std::string keyed map, constructing the key for every lookup.
+ */
+static void BM_UniformLookupStringKeyed(benchmark::State& state)
+{
+	const char* pNames[] = { "model", "view", "projection", "lightDirection", "lightColor", "cameraPosition", "time", "exposure" };
+
+	std::unordered_map<std::string, size_t> attributes;
+	for (size_t index = 0; index < 8; index++)
+		attributes[pNames[index]] = index * 64;
+
+	for (auto _ : state)
+	{
+		size_t offset = 0;
+		for (const char* pName : pNames)
+			offset += attributes.find(pName)->second;
+
+		benchmark::DoNotOptimize(offset);
+	}
+
+	state.SetItemsProcessed(state.iterations() * 8);
+}
+
+BENCHMARK(BM_UniformLookupStringKeyed);
+
+/**
+ * Look up uniform attribute names in an interned string keyed map, using names which were interned up front.
+ */
+static void BM_UniformLookupInterned(benchmark::State& state)
+{
+	const char* pNames[] = { "model", "view", "projection", "lightDirection", "lightColor", "cameraPosition", "time", "exposure" };
+
+	BasicInternedString<char> names[8];
+	std::unordered_map<BasicInternedString<char>, size_t> attributes;
+	for (size_t index = 0; index < 8; index++)
+	{
+		names[index] = BasicInternedString<char>(pNames[index]);
+		attributes[names[index]] = index * 64;
+	}
+
+	for (auto _ : state)
+	{
+		size_t offset = 0;
+		for (const auto& name : names)
+			offset += attributes.find(name)->second;
+
+		benchmark::DoNotOptimize(offset);
+	}
+
+	state.SetItemsProcessed(state.iterations() * 8);
+}
+
+BENCHMARK(BM_UniformLookupInterned);
+
+/**
+ * Intern strings which are already interned, from multiple threads. This only takes the lock free path.
+ */
+static void BM_StringPoolInternExisting(benchmark::State& state)
+{
+	static BasicStringPool<char> pool;
+	static const std::string keys[] = { "position", "normal", "uv", "tangent", "bitangent", "color", "boneIndices", "boneWeights" };
+
+	if (state.thread_index() == 0)
+		for (const auto& key : keys)
+			pool.intern(key);
+
+	size_t index = 0;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(pool.intern(keys[index++ & 7]));
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_StringPoolInternExisting)->ThreadRange(1, 8);
+
+/**
+ * Intern new strings, which takes the lock and allocates from the arena.
+ */
+static void BM_StringPoolInternNew(benchmark::State& state)
+{
+	std::vector<std::string> keys(static_cast<size_t>(state.range(0)));
+	for (size_t index = 0; index < keys.size(); index++)
+		keys[index] = "identifier_" + std::to_string(index);
+
+	for (auto _ : state)
+	{
+		BasicStringPool<char> pool;
+		for (const auto& key : keys)
+			benchmark::DoNotOptimize(pool.intern(key));
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StringPoolInternNew)->RangeMultiplier(16)->Range(256, 1 << 16);
@@ -0,0 +1,618 @@
+#pragma once
+#include <new>
+#include <cstddef>
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Memory resource interface.
+ * A memory resource is the object which actually owns the memory used by the containers. Containers receive a
+ * pointer to a resource through an allocator adapter (ResourceArrayAllocator for Array, ResourceAllocator for the
+ * standard containers and VectorMap) or directly (String).
+ */
+class MemoryResource {
+public:
+	/**
+	 * Default constructor.
+	 */
+	MemoryResource() {}
+
+	/**
+	 * Default destructor.
+	 */
+	virtual ~MemoryResource() {}
+
+	/**
+	 * Allocate a block of memory.
+	 *
+	 * @param byteSize: The size of the block in bytes.
+	 * @param alignment: The alignment of the block.
+	 */
+	virtual void* allocate(size_t byteSize, size_t alignment) = 0;
+
+	/**
+	 * Deallocate a block of memory.
+	 *
+	 * @param pBlock: The block to be deallocated.
+	 * @param byteSize: The size of the block in bytes. This must be the same as the allocated size.
+	 * @param alignment: The alignment of the block. This must be the same as the allocated alignment.
+	 */
+	virtual void deallocate(void* pBlock, size_t byteSize, size_t alignment) = 0;
+};
+
+/**
+ * Default memory resource.
+ * This uses the global aligned operator new and delete.
+ */
+class DefaultMemoryResource final : public MemoryResource {
+public:
+	/**
+	 * Allocate a block of memory using the global operator new.
+	 *
+	 * @param byteSize: The size of the block in bytes.
+	 * @param alignment: The alignment of the block.
+	 */
+	void* allocate(size_t byteSize, size_t alignment) override final
+	{
+		return operator new[](byteSize, std::align_val_t{ alignment });
+	}
+
+	/**
+	 * Deallocate a block of memory using the global operator delete.
+	 *
+	 * @param pBlock: The block to be deallocated.
+	 * @param byteSize: The size of the block in bytes.
+	 * @param alignment: The alignment of the block.
+	 */
+	void deallocate(void* pBlock, size_t /*byteSize*/, size_t alignment) override final
+	{
+		operator delete[](pBlock, std::align_val_t{ alignment });
+	}
+};
+
+/**
+ * Get the default memory resource.
+ */
+inline DefaultMemoryResource* GetDefaultMemoryResource()
+{
+	static DefaultMemoryResource resource;
+	return &resource;
+}
+
+/**
+ * Round an address or a size up to an alignment.
+ *
+ * @param value: The value to be aligned.
+ * @param alignment: The alignment. This must be a power of two.
+ */
+constexpr size_t AlignUp(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * Linear (bump) arena.
+ * Allocations are made by bumping a pointer in a chunk of memory and individual deallocations are ignored. All the
+ * memory is released at once using reset(), which makes it suitable for per-frame or per-request allocations.
+ * This object is not thread safe.
+ */
+class LinearArena final : public MemoryResource {
+	/**
+	 * Header stored at the beginning of every chunk.
+	 */
+	struct Chunk {
+		Chunk* pNext = nullptr;		// The previously allocated chunk.
+		size_t byteSize = 0;		// The size of the chunk including the header.
+	};
+
+public:
+	/**
+	 * Default constructor.
+	 *
+	 * @param chunkSize: The size of a single chunk in bytes. Default is 64 KiB.
+	 * @param pUpstream: The resource used to allocate the chunks. Default is the default memory resource.
+	 */
+	explicit LinearArena(size_t chunkSize = 64 * 1024, MemoryResource* pUpstream = GetDefaultMemoryResource())
+		: pUpstream(pUpstream), chunkSize(chunkSize) {}
+
+	/**
+	 * Default destructor.
+	 * This releases all the chunks.
+	 */
+	~LinearArena() { release(); }
+
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+	/**
+	 * Allocate a block of memory by bumping the pointer.
+	 *
+	 * @param byteSize: The size of the block in bytes.
+	 * @param alignment: The alignment of the block.
+	 */
+	void* allocate(size_t byteSize, size_t alignment) override final
+	{
+		size_t address = AlignUp(reinterpret_cast<size_t>(pCurrent), alignment);
+
+		// Create a new chunk if the current one cannot hold the block.
+		if (!pCurrent || address + byteSize > reinterpret_cast<size_t>(pChunkEnd))
+		{
+			createChunk(byteSize + alignment);
+			address = AlignUp(reinterpret_cast<size_t>(pCurrent), alignment);
+		}
+
+		pCurrent = reinterpret_cast<std::byte*>(address + byteSize);
+		return reinterpret_cast<void*>(address);
+	}
+
+	/**
+	 * Deallocations are ignored by the arena. The memory is released using reset().
+	 */
+	void deallocate(void* /*pBlock*/, size_t /*byteSize*/, size_t /*alignment*/) override final {}
+
+	/**
+	 * Release all the allocations made by the arena.
+	 * The first chunk is kept so that the next frame does not need to allocate it again.
+	 */
+	void reset()
+	{
+		if (!pChunks)
+			return;
+
+		// Release all the chunks but the first one (the last in the list).
+		while (pChunks->pNext)
+		{
+			Chunk* pChunk = pChunks;
+			pChunks = pChunk->pNext;
+			pUpstream->deallocate(pChunk, pChunk->byteSize, alignof(std::max_align_t));
+		}
+
+		pCurrent = reinterpret_cast<std::byte*>(pChunks + 1);
+		pChunkEnd = reinterpret_cast<std::byte*>(pChunks) + pChunks->byteSize;
+	}
+
+	/**
+	 * Release all the chunks back to the upstream resource.
+	 */
+	void release()
+	{
+		while (pChunks)
+		{
+			Chunk* pChunk = pChunks;
+			pChunks = pChunk->pNext;
+			pUpstream->deallocate(pChunk, pChunk->byteSize, alignof(std::max_align_t));
+		}
+
+		pCurrent = nullptr;
+		pChunkEnd = nullptr;
+	}
+
+private:
+	/**
+	 * Allocate a new chunk and make it the current chunk.
+	 *
+	 * @param minimumSize: The minimum number of usable bytes in the chunk.
+	 */
+	void createChunk(size_t minimumSize)
+	{
+		const size_t byteSize = sizeof(Chunk) + (minimumSize > chunkSize ? minimumSize : chunkSize);
+
+		Chunk* pChunk = static_cast<Chunk*>(pUpstream->allocate(byteSize, alignof(std::max_align_t)));
+		pChunk->pNext = pChunks;
+		pChunk->byteSize = byteSize;
+		pChunks = pChunk;
+
+		pCurrent = reinterpret_cast<std::byte*>(pChunk + 1);
+		pChunkEnd = reinterpret_cast<std::byte*>(pChunk) + byteSize;
+	}
+
+private:
+	MemoryResource* pUpstream = nullptr;	// The resource used to allocate the chunks.
+	Chunk* pChunks = nullptr;				// The most recently allocated chunk.
+	std::byte* pCurrent = nullptr;			// The next free byte in the current chunk.
+	std::byte* pChunkEnd = nullptr;			// The end of the current chunk.
+	size_t chunkSize = 0;					// The default chunk size.
+};
+
+/**
+ * Fixed size block pool.
+ * Blocks which fit in the pool's block size are served from a free list, which makes allocation and deallocation
+ * O(1). Larger or over aligned blocks are forwarded to the upstream resource.
+ * This object is not thread safe.
+ */
+class PoolAllocator final : public MemoryResource {
+	/**
+	 * Free list node stored inside a free block.
+	 */
+	struct FreeBlock {
+		FreeBlock* pNext = nullptr;
+	};
+
+	/**
+	 * Header stored at the beginning of every chunk.
+	 */
+	struct Chunk {
+		Chunk* pNext = nullptr;
+	};
+
+public:
+	/**
+	 * Default constructor.
+	 *
+	 * @param blockSize: The size of a single block in bytes.
+	 * @param blocksPerChunk: The number of blocks allocated at a single instance. Default is 256.
+	 * @param pUpstream: The resource used to allocate the chunks. Default is the default memory resource.
+	 */
+	explicit PoolAllocator(size_t blockSize, size_t blocksPerChunk = 256, MemoryResource* pUpstream = GetDefaultMemoryResource())
+		: pUpstream(pUpstream), blockSize(AlignUp(blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize, alignof(std::max_align_t))), blocksPerChunk(blocksPerChunk) {}
+
+	/**
+	 * Default destructor.
+	 * This releases all the chunks.
+	 */
+	~PoolAllocator() { release(); }
+
+	PoolAllocator(const PoolAllocator&) = delete;
+	PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+	/**
+	 * Allocate a block from the pool.
+	 *
+	 * @param byteSize: The size of the block in bytes.
+	 * @param alignment: The alignment of the block.
+	 */
+	void* allocate(size_t byteSize, size_t alignment) override final
+	{
+		// Forward the allocation if the pool cannot serve it.
+		if (byteSize > blockSize || alignment > alignof(std::max_align_t))
+			return pUpstream->allocate(byteSize, alignment);
+
+		if (!pFreeList)
+			createChunk();
+
+		FreeBlock* pBlock = pFreeList;
+		pFreeList = pBlock->pNext;
+
+		return pBlock;
+	}
+
+	/**
+	 * Return a block to the pool.
+	 *
+	 * @param pBlock: The block to be deallocated.
+	 * @param byteSize: The size of the block in bytes.
+	 * @param alignment: The alignment of the block.
+	 */
+	void deallocate(void* pBlock, size_t byteSize, size_t alignment) override final
+	{
+		if (byteSize > blockSize || alignment > alignof(std::max_align_t))
+			return pUpstream->deallocate(pBlock, byteSize, alignment);
+
+		FreeBlock* pFreeBlock = static_cast<FreeBlock*>(pBlock);
+		pFreeBlock->pNext = pFreeList;
+		pFreeList = pFreeBlock;
+	}
+
+	/**
+	 * Release all the chunks back to the upstream resource.
+	 * All the blocks allocated by the pool are invalid after this.
+	 */
+	void release()
+	{
+		while (pChunks)
+		{
+			Chunk* pChunk = pChunks;
+			pChunks = pChunk->pNext;
+			pUpstream->deallocate(pChunk, chunkByteSize(), alignof(std::max_align_t));
+		}
+
+		pFreeList = nullptr;
+	}
+
+	/**
+	 * Get the size of a single block in bytes.
+	 */
+	size_t getBlockSize() const noexcept { return blockSize; }
+
+private:
+	/**
+	 * Get the size of a chunk in bytes.
+	 */
+	size_t chunkByteSize() const noexcept { return AlignUp(sizeof(Chunk), alignof(std::max_align_t)) + blockSize * blocksPerChunk; }
+
+	/**
+	 * Allocate a new chunk and add its blocks to the free list.
+	 */
+	void createChunk()
+	{
+		Chunk* pChunk = static_cast<Chunk*>(pUpstream->allocate(chunkByteSize(), alignof(std::max_align_t)));
+		pChunk->pNext = pChunks;
+		pChunks = pChunk;
+
+		// Link the blocks in reverse so that the first block is at the head of the list.
+		std::byte* pFirst = reinterpret_cast<std::byte*>(pChunk) + AlignUp(sizeof(Chunk), alignof(std::max_align_t));
+		for (size_t index = blocksPerChunk; index > 0; index--)
+		{
+			FreeBlock* pBlock = reinterpret_cast<FreeBlock*>(pFirst + (index - 1) * blockSize);
+			pBlock->pNext = pFreeList;
+			pFreeList = pBlock;
+		}
+	}
+
+private:
+	MemoryResource* pUpstream = nullptr;	// The resource used to allocate the chunks.
+	Chunk* pChunks = nullptr;				// The most recently allocated chunk.
+	FreeBlock* pFreeList = nullptr;			// The free blocks.
+	size_t blockSize = 0;					// The size of a single block.
+	size_t blocksPerChunk = 0;				// The number of blocks in a chunk.
+};
+
+/**
+ * Thread local caching allocator.
+ * Freed blocks are kept in per thread, power of two size class free lists and reused by later allocations on the
+ * same thread without touching the global heap. Blocks larger than the largest size class are forwarded to the
+ * default memory resource. All instances share the same per thread caches, and a thread's cache is released when
+ * the thread exits.
+ */
+class ThreadLocalCacheAllocator final : public MemoryResource {
+	static constexpr size_t MinimumClassShift = 4;		// The smallest size class (16 bytes).
+	static constexpr size_t SizeClassCount = 9;			// The number of size classes (16 bytes to 4 KiB).
+	static constexpr size_t MaximumCachedBlocks = 256;	// The maximum number of blocks cached per size class.
+
+	/**
+	 * Free list node stored inside a free block.
+	 */
+	struct FreeBlock {
+		FreeBlock* pNext = nullptr;
+	};
+
+	/**
+	 * The cache of a single thread.
+	 */
+	struct ThreadCache {
+		/**
+		 * Default destructor.
+		 * This releases all the cached blocks.
+		 */
+		~ThreadCache()
+		{
+			for (size_t sizeClass = 0; sizeClass < SizeClassCount; sizeClass++)
+			{
+				while (pFreeLists[sizeClass])
+				{
+					FreeBlock* pBlock = pFreeLists[sizeClass];
+					pFreeLists[sizeClass] = pBlock->pNext;
+					GetDefaultMemoryResource()->deallocate(pBlock, ClassSize(sizeClass), alignof(std::max_align_t));
+				}
+			}
+		}
+
+		FreeBlock* pFreeLists[SizeClassCount] = {};	// Free list of each size class.
+		size_t counts[SizeClassCount] = {};			// The number of cached blocks in each size class.
+	};
+
+public:
+	/**
+	 * Allocate a block, reusing a cached block if available.
+	 *
+	 * @param byteSize: The size of the block in bytes.
+	 * @param alignment: The alignment of the block.
+	 */
+	void* allocate(size_t byteSize, size_t alignment) override final
+	{
+		const size_t sizeClass = GetSizeClass(byteSize);
+		if (sizeClass >= SizeClassCount || alignment > alignof(std::max_align_t))
+			return GetDefaultMemoryResource()->allocate(byteSize, alignment);
+
+		ThreadCache& cache = GetThreadCache();
+		if (FreeBlock* pBlock = cache.pFreeLists[sizeClass])
+		{
+			cache.pFreeLists[sizeClass] = pBlock->pNext;
+			cache.counts[sizeClass]--;
+			return pBlock;
+		}
+
+		return GetDefaultMemoryResource()->allocate(ClassSize(sizeClass), alignof(std::max_align_t));
+	}
+
+	/**
+	 * Return a block to the current thread's cache.
+	 * If the cache is full, the block is released to the default memory resource.
+	 *
+	 * @param pBlock: The block to be deallocated.
+	 * @param byteSize: The size of the block in bytes.
+	 * @param alignment: The alignment of the block.
+	 */
+	void deallocate(void* pBlock, size_t byteSize, size_t alignment) override final
+	{
+		const size_t sizeClass = GetSizeClass(byteSize);
+		if (sizeClass >= SizeClassCount || alignment > alignof(std::max_align_t))
+			return GetDefaultMemoryResource()->deallocate(pBlock, byteSize, alignment);
+
+		ThreadCache& cache = GetThreadCache();
+		if (cache.counts[sizeClass] == MaximumCachedBlocks)
+			return GetDefaultMemoryResource()->deallocate(pBlock, ClassSize(sizeClass), alignof(std::max_align_t));
+
+		FreeBlock* pFreeBlock = static_cast<FreeBlock*>(pBlock);
+		pFreeBlock->pNext = cache.pFreeLists[sizeClass];
+		cache.pFreeLists[sizeClass] = pFreeBlock;
+		cache.counts[sizeClass]++;
+	}
+
+private:
+	/**
+	 * Get the size of a size class in bytes.
+	 *
+	 * @param sizeClass: The size class.
+	 */
+	static constexpr size_t ClassSize(size_t sizeClass) { return size_t(1) << (sizeClass + MinimumClassShift); }
+
+	/**
+	 * Get the size class of a block size.
+	 *
+	 * @param byteSize: The size of the block in bytes.
+	 */
+	static size_t GetSizeClass(size_t byteSize)
+	{
+		size_t sizeClass = 0;
+		while (sizeClass < SizeClassCount && ClassSize(sizeClass) < byteSize)
+			sizeClass++;
+
+		return sizeClass;
+	}
+
+	/**
+	 * Get the cache of the current thread.
+	 */
+	static ThreadCache& GetThreadCache()
+	{
+		thread_local ThreadCache cache;
+		return cache;
+	}
+};
+
+/**
+ * Check if a memory resource type has a default resource, which is the case for the types which the default memory
+ * resource can be used as. The allocators can only be default constructed for these types.
+ *
+ * @tparam Resource: The memory resource type.
+ */
+template<class Resource>
+concept HasDefaultMemoryResource = std::is_base_of_v<Resource, DefaultMemoryResource>;
+
+/**
+ * Array allocator which allocates memory from a memory resource.
+ * This follows the same interface as the ArrayAllocator and can be used as the Allocator of the Array.
+ *
+ * @tparam Type: The type of the alocation.
+ * @tparam Alignment: The alignment of the allocation.
+ * @tparam Resource: The memory resource type. Using the concrete resource type avoids the virtual calls.
+ */
+template<class Type, size_t Alignment = alignof(Type), class Resource = MemoryResource>
+class ResourceArrayAllocator {
+public:
+	/**
+	 * Default constructor.
+	 * The memory is allocated from the default memory resource, so this is only available if it is a Resource.
+	 */
+	ResourceArrayAllocator() requires HasDefaultMemoryResource<Resource> : pResource(GetDefaultMemoryResource()) {}
+
+	/**
+	 * Construct the allocator using a memory resource.
+	 *
+	 * @param pResource: The memory resource to allocate from.
+	 */
+	ResourceArrayAllocator(Resource* pResource) : pResource(pResource) {}
+
+	/**
+	 * Create a new memory block.
+	 *
+	 * @param byteSize: The size of the block in bytes.
+	 */
+	Type* CreateNewBlock(size_t byteSize) const
+	{
+		return static_cast<Type*>(pResource->allocate(byteSize, Alignment));
+	}
+
+	/**
+	 * Destroy an allocated block of memory.
+	 *
+	 * @param pBlock: The block to be deallocated.
+	 * @param byteSize: The size of the block in bytes.
+	 */
+	void DestroyBlock(Type* pBlock, size_t byteSize) const
+	{
+		pResource->deallocate(pBlock, byteSize, Alignment);
+	}
+
+	/**
+	 * Get the memory resource.
+	 */
+	Resource* getResource() const noexcept { return pResource; }
+
+private:
+	Resource* pResource = nullptr;	// The memory resource.
+};
+
+/**
+ * Standard allocator which allocates memory from a memory resource.
+ * This can be used with the standard containers and the VectorMap.
+ *
+ * @tparam Type: The type of the alocation.
+ * @tparam Resource: The memory resource type. Using the concrete resource type avoids the virtual calls.
+ */
+template<class Type, class Resource = MemoryResource>
+class ResourceAllocator {
+	template<class Other, class OtherResource>
+	friend class ResourceAllocator;
+
+public:
+	using value_type = Type;
+
+	/**
+	 * Default constructor.
+	 * The memory is allocated from the default memory resource, so this is only available if it is a Resource.
+	 */
+	ResourceAllocator() noexcept requires HasDefaultMemoryResource<Resource> : pResource(GetDefaultMemoryResource()) {}
+
+	/**
+	 * Construct the allocator using a memory resource.
+	 *
+	 * @param pResource: The memory resource to allocate from.
+	 */
+	ResourceAllocator(Resource* pResource) noexcept : pResource(pResource) {}
+
+	/**
+	 * Construct the allocator using an allocator of another type.
+	 *
+	 * @param other: The other allocator.
+	 */
+	template<class Other>
+	ResourceAllocator(const ResourceAllocator<Other, Resource>& other) noexcept : pResource(other.pResource) {}
+
+	/**
+	 * Allocate memory for a number of elements.
+	 *
+	 * @param count: The number of elements.
+	 */
+	Type* allocate(size_t count)
+	{
+		return static_cast<Type*>(pResource->allocate(count * sizeof(Type), alignof(Type)));
+	}
+
+	/**
+	 * Deallocate memory allocated for a number of elements.
+	 *
+	 * @param pBlock: The block to be deallocated.
+	 * @param count: The number of elements.
+	 */
+	void deallocate(Type* pBlock, size_t count)
+	{
+		pResource->deallocate(pBlock, count * sizeof(Type), alignof(Type));
+	}
+
+	/**
+	 * Get the memory resource.
+	 */
+	Resource* getResource() const noexcept { return pResource; }
+
+	/**
+	 * Is equal operator.
+	 *
+	 * @param other: The other allocator.
+	 */
+	template<class Other>
+	bool operator==(const ResourceAllocator<Other, Resource>& other) const noexcept { return pResource == other.pResource; }
+
+	/**
+	 * Is not equal operator.
+	 *
+	 * @param other: The other allocator.
+	 */
+	template<class Other>
+	bool operator!=(const ResourceAllocator<Other, Resource>& other) const noexcept { return pResource != other.pResource; }
+
+private:
+	Resource* pResource = nullptr;	// The memory resource.
+};
@@ -1,4 +1,6 @@
 #pragma once
+#include "InternedString.h"
+
 #include <vector>
 #include <unordered_map>
 
@@ -43,7 +45,7 @@ public:
 	UniformBuffer() {}
 	~UniformBuffer() {}
 
-	std::unordered_map<std::string, UniformAttribute> uniformAttributes;
+	std::unordered_map<BasicInternedString<char>, UniformAttribute> uniformAttributes;	// Attributes keyed by their interned names.
 };
 
 class MeshHandle {
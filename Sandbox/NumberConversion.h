@@ -0,0 +1,197 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * Locale independent conversions between numbers and characters, for any character type.
+ * The conversions are built on std::to_chars and std::from_chars, which do not allocate and do not consult the
+ * locale. Floating point values are formatted using the shortest representation which parses back to the same
+ * value (the standard library implements this with Ryu). Other character types are converted to and from char,
+ * so the characters of a number must be ASCII.
+ */
+namespace NumberConversion {
+	/**
+	 * The number of characters a formatted integer can take (a 64 bit value in base 2 with a sign).
+	 */
+	constexpr size_t MaxIntegerLength = 65;
+
+	/**
+	 * The number of characters a formatted floating point value can take.
+	 */
+	constexpr size_t MaxFloatLength = 64;
+
+	/**
+	 * The maximum number of characters of other character types which can be parsed. They are converted to char on
+	 * the stack, so longer inputs are rejected. Formatted numbers are much shorter than this.
+	 */
+	constexpr size_t ParseBufferLength = 128;
+
+	/**
+	 * Copy characters to another character type.
+	 *
+	 * @param pDestination: The destination.
+	 * @param pSource: The source.
+	 * @param count: The number of characters.
+	 */
+	template<class Destination, class Source>
+	inline void CopyCharacters(Destination* pDestination, const Source* pSource, size_t count) noexcept
+	{
+		for (size_t index = 0; index < count; index++)
+			pDestination[index] = static_cast<Destination>(pSource[index]);
+	}
+
+	/**
+	 * Convert characters to char.
+	 * Returns false if a character is not ASCII.
+	 *
+	 * @param pDestination: The destination.
+	 * @param pSource: The source.
+	 * @param count: The number of characters.
+	 */
+	template<class Type>
+	inline bool NarrowCharacters(char* pDestination, const Type* pSource, size_t count) noexcept
+	{
+		// Checking every character without branching lets the compiler vectorize the loop.
+		bool bInvalid = false;
+		for (size_t index = 0; index < count; index++)
+		{
+			bInvalid |= static_cast<std::make_unsigned_t<Type>>(pSource[index]) > 0x7F;
+			pDestination[index] = static_cast<char>(pSource[index]);
+		}
+
+		return !bInvalid;
+	}
+
+	/**
+	 * Call a function with the characters converted to char.
+	 * Returns false without calling the function if a character is not ASCII, or if the characters are not char and
+	 * there are more than ParseBufferLength of them.
+	 *
+	 * @param pString: The characters.
+	 * @param length: The number of characters.
+	 * @param function: The function, taking the first and the last char.
+	 */
+	template<class Type, class Function>
+	inline bool WithNarrowCharacters(const Type* pString, size_t length, Function&& function)
+	{
+		if constexpr (std::is_same_v<Type, char>)
+		{
+			return function(pString, pString + length);
+		}
+		else
+		{
+			if (length > ParseBufferLength)
+				return false;
+
+			char buffer[ParseBufferLength];
+			return NarrowCharacters(buffer, pString, length) && function(buffer, buffer + length);
+		}
+	}
+
+	/**
+	 * Format an integer.
+	 * Returns the number of characters written.
+	 *
+	 * @param pBuffer: The buffer to write to. This must hold at least MaxIntegerLength characters.
+	 * @param value: The value.
+	 * @param base: The base, from 2 to 36.
+	 */
+	template<class Type, class Integer>
+	inline size_t FormatInteger(Type* pBuffer, Integer value, int base = 10) noexcept
+	{
+		static_assert(std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>, "The value must be an integer!");
+
+		if constexpr (std::is_same_v<Type, char>)
+		{
+			return std::to_chars(pBuffer, pBuffer + MaxIntegerLength, value, base).ptr - pBuffer;
+		}
+		else
+		{
+			char buffer[MaxIntegerLength];
+			const size_t count = std::to_chars(buffer, buffer + MaxIntegerLength, value, base).ptr - buffer;
+			CopyCharacters(pBuffer, buffer, count);
+			return count;
+		}
+	}
+
+	/**
+	 * Format a floating point value using the shortest representation which parses back to the same value.
+	 * Returns the number of characters written.
+	 *
+	 * @param pBuffer: The buffer to write to. This must hold at least MaxFloatLength characters.
+	 * @param value: The value.
+	 */
+	template<class Type, class Float>
+	inline size_t FormatFloat(Type* pBuffer, Float value) noexcept
+	{
+		static_assert(std::is_floating_point_v<Float>, "The value must be a floating point value!");
+
+		if constexpr (std::is_same_v<Type, char>)
+		{
+			return std::to_chars(pBuffer, pBuffer + MaxFloatLength, value).ptr - pBuffer;
+		}
+		else
+		{
+			char buffer[MaxFloatLength];
+			const size_t count = std::to_chars(buffer, buffer + MaxFloatLength, value).ptr - buffer;
+			CopyCharacters(pBuffer, buffer, count);
+			return count;
+		}
+	}
+
+	/**
+	 * Parse an integer.
+	 * All the characters must be a part of the number: whitespace and a leading '+' are not accepted. Returns false
+	 * and leaves the value unchanged if the characters are not a number or the number does not fit the type.
+	 * Characters of other types than char are limited to ParseBufferLength.
+	 *
+	 * @param pString: The characters.
+	 * @param length: The number of characters.
+	 * @param value: The parsed value.
+	 * @param base: The base, from 2 to 36.
+	 */
+	template<class Type, class Integer>
+	inline bool ParseInteger(const Type* pString, size_t length, Integer& value, int base = 10)
+	{
+		static_assert(std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>, "The value must be an integer!");
+
+		return WithNarrowCharacters(pString, length, [&value, base](const char* pFirst, const char* pLast)
+			{
+				Integer result = 0;
+				const auto [pEnd, error] = std::from_chars(pFirst, pLast, result, base);
+				if (error != std::errc() || pEnd != pLast)
+					return false;
+
+				value = result;
+				return true;
+			});
+	}
+
+	/**
+	 * Parse a floating point value, in decimal or scientific notation, or "inf" and "nan".
+	 * All the characters must be a part of the number: whitespace and a leading '+' are not accepted. Returns false
+	 * and leaves the value unchanged if the characters are not a number or the number is out of range.
+	 * Characters of other types than char are limited to ParseBufferLength.
+	 *
+	 * @param pString: The characters.
+	 * @param length: The number of characters.
+	 * @param value: The parsed value.
+	 */
+	template<class Type, class Float>
+	inline bool ParseFloat(const Type* pString, size_t length, Float& value)
+	{
+		static_assert(std::is_floating_point_v<Float>, "The value must be a floating point value!");
+
+		return WithNarrowCharacters(pString, length, [&value](const char* pFirst, const char* pLast)
+			{
+				Float result = 0;
+				const auto [pEnd, error] = std::from_chars(pFirst, pLast, result);
+				if (error != std::errc() || pEnd != pLast)
+					return false;
+
+				value = result;
+				return true;
+			});
+	}
+}
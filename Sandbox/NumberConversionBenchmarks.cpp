@@ -0,0 +1,252 @@
+#include "String.h"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/**
+ * Create random integers of mixed magnitudes.
+ */
+static std::vector<long long> CreateIntegers()
+{
+	std::vector<long long> values(1024);
+
+	std::mt19937_64 engine(1);
+	for (auto& value : values)
+		value = static_cast<long long>(engine() >> (engine() % 64)) * (engine() % 2 ? 1 : -1);
+
+	return values;
+}
+
+/**
+ * Create random doubles of mixed magnitudes.
+ */
+static std::vector<double> CreateFloats()
+{
+	std::vector<double> values(1024);
+
+	std::mt19937_64 engine(1);
+	std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+	for (auto& value : values)
+		value = distribution(engine) * std::pow(10.0, static_cast<double>(engine() % 20) - 10.0);
+
+	return values;
+}
+
+/**
+ * Format the values into a string using appendInt.
+ */
+static void BM_StringAppendInt(benchmark::State& state)
+{
+	const std::vector<long long> values = CreateIntegers();
+	String string;
+
+	for (auto _ : state)
+	{
+		string = TEXT("");
+		for (const auto value : values)
+			string.appendInt(value);
+
+		benchmark::DoNotOptimize(string.str());
+	}
+
+	state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(BM_StringAppendInt);
+
+/**
+ * Format the values into a string using std::to_string for reference (std::to_wstring when using wchar_t).
+ */
+static void BM_StringAppendToString(benchmark::State& state)
+{
+	const std::vector<long long> values = CreateIntegers();
+	String string;
+
+	for (auto _ : state)
+	{
+		string = TEXT("");
+		for (const auto value : values)
+		{
+#ifdef USE_WCHAR
+			string += std::to_wstring(value).c_str();
+
+#else
+			string += std::to_string(value).c_str();
+
+#endif // USE_WCHAR
+		}
+
+		benchmark::DoNotOptimize(string.str());
+	}
+
+	state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(BM_StringAppendToString);
+
+/**
+ * Format the values into a string using appendFloat.
+ */
+static void BM_StringAppendFloat(benchmark::State& state)
+{
+	const std::vector<double> values = CreateFloats();
+	String string;
+
+	for (auto _ : state)
+	{
+		string = TEXT("");
+		for (const auto value : values)
+			string.appendFloat(value);
+
+		benchmark::DoNotOptimize(string.str());
+	}
+
+	state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(BM_StringAppendFloat);
+
+/**
+ * Format the values into a string using snprintf with enough digits to round trip, for reference.
+ */
+static void BM_StringAppendSnprintf(benchmark::State& state)
+{
+	const std::vector<double> values = CreateFloats();
+	String string;
+
+	for (auto _ : state)
+	{
+		string = TEXT("");
+		for (const auto value : values)
+		{
+			char buffer[32];
+			const int count = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+
+			for (int index = 0; index < count; index++)
+				string.append(static_cast<String::Type>(buffer[index]));
+		}
+
+		benchmark::DoNotOptimize(string.str());
+	}
+
+	state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(BM_StringAppendSnprintf);
+
+/**
+ * Parse formatted integers using parseInt.
+ */
+static void BM_StringParseInt(benchmark::State& state)
+{
+	std::vector<String> strings;
+	for (const auto value : CreateIntegers())
+	{
+		strings.emplace_back();
+		strings.back().appendInt(value);
+	}
+
+	for (auto _ : state)
+	{
+		uint64_t sum = 0;
+		for (const auto& string : strings)
+		{
+			long long value = 0;
+			string.parseInt(value);
+			sum += static_cast<uint64_t>(value);
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * strings.size());
+}
+
+BENCHMARK(BM_StringParseInt);
+
+/**
+ * Parse formatted integers using std::stoll for reference.
+ */
+static void BM_StandardStringParseInt(benchmark::State& state)
+{
+	std::vector<String::TypeSTD> strings;
+	for (const auto value : CreateIntegers())
+	{
+		String string;
+		string.appendInt(value);
+		strings.emplace_back(string.toStandard());
+	}
+
+	for (auto _ : state)
+	{
+		uint64_t sum = 0;
+		for (const auto& string : strings)
+			sum += static_cast<uint64_t>(std::stoll(string));
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * strings.size());
+}
+
+BENCHMARK(BM_StandardStringParseInt);
+
+/**
+ * Parse formatted floating point values using parseFloat.
+ */
+static void BM_StringParseFloat(benchmark::State& state)
+{
+	std::vector<String> strings;
+	for (const auto value : CreateFloats())
+	{
+		strings.emplace_back();
+		strings.back().appendFloat(value);
+	}
+
+	for (auto _ : state)
+	{
+		double sum = 0.0;
+		for (const auto& string : strings)
+		{
+			double value = 0.0;
+			string.parseFloat(value);
+			sum += value;
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * strings.size());
+}
+
+BENCHMARK(BM_StringParseFloat);
+
+/**
+ * Parse formatted floating point values using std::stod for reference.
+ */
+static void BM_StandardStringParseFloat(benchmark::State& state)
+{
+	std::vector<String::TypeSTD> strings;
+	for (const auto value : CreateFloats())
+	{
+		String string;
+		string.appendFloat(value);
+		strings.emplace_back(string.toStandard());
+	}
+
+	for (auto _ : state)
+	{
+		double sum = 0.0;
+		for (const auto& string : strings)
+			sum += std::stod(string);
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * strings.size());
+}
+
+BENCHMARK(BM_StandardStringParseFloat);
@@ -0,0 +1,758 @@
+#pragma once
+#include "Array.h"
+#include "StaticArray.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Work stealing thread pool.
+ * Every worker owns a task queue. Workers take tasks from the back of their own queue and steal from the front of
+ * the other queues when they run out, so the large tasks which are submitted first are the ones which get stolen.
+ *
+ * The thread which waits on a task group takes part in the work, so a pool of N threads spawns N - 1 workers.
+ */
+class ThreadPool {
+public:
+	using Task = std::function<void()>;
+
+	/**
+	 * Construct the pool.
+	 *
+	 * @param threadCount: The number of threads including the waiting thread. Defaults to the hardware concurrency.
+	 */
+	explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency())
+		: mQueues(threadCount > 1 ? threadCount : 1)
+	{
+		// The last queue receives the tasks submitted from outside the pool.
+		for (size_t index = 0; index + 1 < mQueues.size(); index++)
+			mWorkers.emplace_back([this, index] { work(index); });
+	}
+
+	/**
+	 * Default destructor.
+	 * This waits for the workers to finish their current task and joins them.
+	 */
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mWakeMutex);
+			bShouldStop = true;
+		}
+
+		mWakeCondition.notify_all();
+		for (auto& worker : mWorkers)
+			worker.join();
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 * Get the number of threads which run the tasks, including the waiting thread.
+	 */
+	size_t threadCount() const noexcept { return mQueues.size(); }
+
+	/**
+	 * Submit a task.
+	 * Tasks submitted from a worker go to its own queue, all the others go to the shared queue.
+	 *
+	 * @param task: The task to be executed.
+	 */
+	void submit(Task task)
+	{
+		Queue& queue = mQueues[currentQueueIndex()];
+		{
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.tasks.push_back(std::move(task));
+		}
+
+		// Increment under the wake mutex so that a worker which is about to sleep sees the task.
+		{
+			std::lock_guard<std::mutex> lock(mWakeMutex);
+			mPendingTasks++;
+		}
+
+		mWakeCondition.notify_one();
+	}
+
+	/**
+	 * Run one pending task on the calling thread if there is any.
+	 * Returns true if a task was executed.
+	 */
+	bool runPendingTask()
+	{
+		Task task;
+		if (!takeTask(currentQueueIndex(), task))
+			return false;
+
+		task();
+		return true;
+	}
+
+private:
+	/**
+	 * Task queue of a single thread.
+	 */
+	struct Queue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	/**
+	 * Get the queue index of the calling thread.
+	 */
+	size_t currentQueueIndex() const noexcept
+	{
+		return tpCurrentPool == this ? tCurrentIndex : mQueues.size() - 1;
+	}
+
+	/**
+	 * Take a task from the thread's own queue or steal one from the others.
+	 *
+	 * @param ownIndex: The queue index of the calling thread.
+	 * @param task: The variable to store the task in.
+	 */
+	bool takeTask(size_t ownIndex, Task& task)
+	{
+		if (mPendingTasks.load(std::memory_order_acquire) == 0)
+			return false;
+
+		// Take the newest task from the own queue.
+		{
+			Queue& queue = mQueues[ownIndex];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (!queue.tasks.empty())
+			{
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+				mPendingTasks--;
+				return true;
+			}
+		}
+
+		// Steal the oldest task from the other queues.
+		for (size_t offset = 1; offset < mQueues.size(); offset++)
+		{
+			Queue& queue = mQueues[(ownIndex + offset) % mQueues.size()];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (!queue.tasks.empty())
+			{
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+				mPendingTasks--;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * Worker thread function.
+	 *
+	 * @param index: The queue index of the worker.
+	 */
+	void work(size_t index)
+	{
+		tpCurrentPool = this;
+		tCurrentIndex = index;
+
+		Task task;
+		while (true)
+		{
+			if (takeTask(index, task))
+			{
+				task();
+				task = nullptr;
+				continue;
+			}
+
+			// Sleep until there is something to do.
+			std::unique_lock<std::mutex> lock(mWakeMutex);
+			mWakeCondition.wait(lock, [this] { return bShouldStop || mPendingTasks.load() != 0; });
+
+			if (bShouldStop)
+				return;
+		}
+	}
+
+private:
+	std::vector<Queue> mQueues;
+	std::vector<std::thread> mWorkers;
+
+	std::mutex mWakeMutex;
+	std::condition_variable mWakeCondition;
+	std::atomic<size_t> mPendingTasks = 0;
+	bool bShouldStop = false;
+
+	static inline thread_local ThreadPool* tpCurrentPool = nullptr;
+	static inline thread_local size_t tCurrentIndex = 0;
+};
+
+/**
+ * Get the default thread pool.
+ * The pool is created on first use with one thread per hardware thread.
+ */
+inline ThreadPool& GetDefaultThreadPool()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+/**
+ * Group of tasks which can be waited on.
+ * The waiting thread runs pending tasks instead of blocking, which keeps nested parallelism from deadlocking.
+ * The first exception thrown by a task is rethrown by wait().
+ */
+class TaskGroup {
+public:
+	/**
+	 * Construct the group.
+	 *
+	 * @param pool: The pool to run the tasks on.
+	 */
+	explicit TaskGroup(ThreadPool& pool) : mPool(pool) {}
+
+	/**
+	 * Default destructor.
+	 * This waits for the remaining tasks, ignoring their exceptions.
+	 */
+	~TaskGroup()
+	{
+		while (mRemaining.load(std::memory_order_acquire) != 0)
+			if (!mPool.runPendingTask())
+				std::this_thread::yield();
+	}
+
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator=(const TaskGroup&) = delete;
+
+	/**
+	 * Run a function on the pool.
+	 *
+	 * @param function: The function to be executed.
+	 */
+	template<class Function>
+	void run(Function&& function)
+	{
+		mRemaining.fetch_add(1, std::memory_order_relaxed);
+		mPool.submit([this, function = std::forward<Function>(function)]() mutable
+			{
+				try
+				{
+					function();
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(mExceptionMutex);
+					if (!mException)
+						mException = std::current_exception();
+				}
+
+				mRemaining.fetch_sub(1, std::memory_order_release);
+			});
+	}
+
+	/**
+	 * Wait until all the tasks of the group are finished.
+	 */
+	void wait()
+	{
+		while (mRemaining.load(std::memory_order_acquire) != 0)
+			if (!mPool.runPendingTask())
+				std::this_thread::yield();
+
+		if (mException)
+			std::rethrow_exception(std::exchange(mException, nullptr));
+	}
+
+	/**
+	 * Get the pool of the group.
+	 */
+	ThreadPool& getPool() const noexcept { return mPool; }
+
+private:
+	ThreadPool& mPool;
+	std::atomic<size_t> mRemaining = 0;
+
+	std::mutex mExceptionMutex;
+	std::exception_ptr mException = nullptr;
+};
+
+/**
+ * Default number of elements processed by a single task.
+ */
+constexpr size_t DefaultGrainSize = 4096;
+
+/**
+ * Run a function over the sub ranges of [begin, end), splitting the range in halves until a sub range has at most
+ * grainSize elements. The function receives the begin and end index of each sub range.
+ *
+ * @param begin: The first index.
+ * @param end: The end index.
+ * @param function: The function to be called with (begin, end).
+ * @param grainSize: The maximum number of elements processed by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Function>
+void parallelFor(size_t begin, size_t end, Function&& function, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	if (grainSize == 0)
+		grainSize = 1;
+
+	// Small ranges and single threaded pools are executed directly.
+	if (end - begin <= grainSize || pool.threadCount() == 1)
+	{
+		if (begin < end)
+			function(begin, end);
+
+		return;
+	}
+
+	// The queued tasks call split, so it has to outlive the group, whose destructor runs the remaining tasks.
+	std::function<void(size_t, size_t)> split;
+	TaskGroup group(pool);
+
+	split = [&](size_t first, size_t last)
+	{
+		// Hand the upper halves to the pool and keep the lower half.
+		while (last - first > grainSize)
+		{
+			const size_t middle = first + (last - first) / 2;
+			group.run([&split, middle, last] { split(middle, last); });
+			last = middle;
+		}
+
+		function(first, last);
+	};
+
+	try
+	{
+		split(begin, end);
+	}
+	catch (...)
+	{
+		// Let the tasks which were already handed out finish. The exception of this thread is the one reported.
+		try
+		{
+			group.wait();
+		}
+		catch (...)
+		{
+		}
+
+		throw;
+	}
+
+	group.wait();
+}
+
+/**
+ * Call a function for every element of a range in parallel.
+ *
+ * @param pBegin: The first element.
+ * @param pEnd: The end of the range.
+ * @param function: The function to be called with each element.
+ * @param grainSize: The maximum number of elements processed by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, class Function>
+void parallelForEach(Type* pBegin, Type* pEnd, Function&& function, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	parallelFor(0, pEnd - pBegin, [pBegin, &function](size_t first, size_t last)
+		{
+			for (size_t index = first; index < last; index++)
+				function(pBegin[index]);
+		}, grainSize, pool);
+}
+
+/**
+ * Transform the elements of a range into another range in parallel.
+ * The destination must have space for the whole source range. It may be the source itself.
+ *
+ * @param pBegin: The first source element.
+ * @param pEnd: The end of the source range.
+ * @param pDestination: The first destination element.
+ * @param function: The function which maps a source element to a destination element.
+ * @param grainSize: The maximum number of elements processed by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, class Result, class Function>
+void parallelTransform(const Type* pBegin, const Type* pEnd, Result* pDestination, Function&& function, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	parallelFor(0, pEnd - pBegin, [pBegin, pDestination, &function](size_t first, size_t last)
+		{
+			for (size_t index = first; index < last; index++)
+				pDestination[index] = function(pBegin[index]);
+		}, grainSize, pool);
+}
+
+/**
+ * Reduce a range in parallel into a result of another type.
+ * The range is split into chunks of grainSize elements which are reduced in order and then combined in order, so
+ * the result only depends on the grain size and not on the number of threads.
+ *
+ * @param pBegin: The first element.
+ * @param pEnd: The end of the range.
+ * @param identity: The identity value of the operations.
+ * @param operation: The operation, called with (accumulated, element).
+ * @param combine: The associative operation which combines the results of two chunks, called with (accumulated, result).
+ * @param grainSize: The number of elements reduced by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, class Result, class Operation, class Combine>
+	requires std::is_invocable_r_v<Result, Combine&, Result, Result>
+Result parallelReduce(const Type* pBegin, const Type* pEnd, Result identity, Operation&& operation, Combine&& combine, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	if (grainSize == 0)
+		grainSize = 1;
+
+	const size_t count = pEnd - pBegin;
+	const size_t chunkCount = (count + grainSize - 1) / grainSize;
+	Array<Result> partials(chunkCount, identity);
+
+	parallelFor(0, chunkCount, [&](size_t first, size_t last)
+		{
+			for (size_t chunk = first; chunk < last; chunk++)
+			{
+				const size_t end = std::min(count, (chunk + 1) * grainSize);
+
+				Result result = identity;
+				for (size_t index = chunk * grainSize; index < end; index++)
+					result = operation(result, pBegin[index]);
+
+				partials[chunk] = result;
+			}
+		}, 1, pool);
+
+	Result result = identity;
+	for (size_t chunk = 0; chunk < chunkCount; chunk++)
+		result = combine(result, partials[chunk]);
+
+	return result;
+}
+
+/**
+ * Reduce a range in parallel.
+ * The results of the chunks are combined with the operation itself, so the result has the type of the elements.
+ *
+ * @param pBegin: The first element.
+ * @param pEnd: The end of the range.
+ * @param identity: The identity value of the operation.
+ * @param operation: The associative operation, called with (accumulated, element).
+ * @param grainSize: The number of elements reduced by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, class Operation>
+Type parallelReduce(const Type* pBegin, const Type* pEnd, std::type_identity_t<Type> identity, Operation&& operation, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	return parallelReduce(pBegin, pEnd, identity, operation, operation, grainSize, pool);
+}
+
+/**
+ * Sort a range in parallel.
+ * Chunks of grainSize elements are sorted in parallel and then merged pairwise, with the merges of each pass running
+ * in parallel. The sort is not stable.
+ *
+ * @param pBegin: The first element.
+ * @param pEnd: The end of the range.
+ * @param compare: The less than comparison.
+ * @param grainSize: The number of elements sorted by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, class Compare = std::less<Type>>
+void parallelSort(Type* pBegin, Type* pEnd, Compare compare = Compare(), size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	if (grainSize == 0)
+		grainSize = 1;
+
+	const size_t count = pEnd - pBegin;
+	if (count <= grainSize || pool.threadCount() == 1)
+	{
+		std::sort(pBegin, pEnd, compare);
+		return;
+	}
+
+	// Sort the chunks.
+	const size_t chunkCount = (count + grainSize - 1) / grainSize;
+	parallelFor(0, chunkCount, [&](size_t first, size_t last)
+		{
+			for (size_t chunk = first; chunk < last; chunk++)
+				std::sort(pBegin + chunk * grainSize, pBegin + std::min(count, (chunk + 1) * grainSize), compare);
+		}, 1, pool);
+
+	// Merge neighbouring runs until a single run is left.
+	for (size_t runSize = grainSize; runSize < count; runSize *= 2)
+	{
+		const size_t mergeCount = (count + 2 * runSize - 1) / (2 * runSize);
+		parallelFor(0, mergeCount, [&](size_t first, size_t last)
+			{
+				for (size_t merge = first; merge < last; merge++)
+				{
+					const size_t begin = merge * 2 * runSize;
+					const size_t middle = std::min(count, begin + runSize);
+					const size_t end = std::min(count, begin + 2 * runSize);
+
+					if (middle < end)
+						std::inplace_merge(pBegin + begin, pBegin + middle, pBegin + end, compare);
+				}
+			}, 1, pool);
+	}
+}
+
+/**
+ * Compute the inclusive prefix scan of a range in parallel.
+ * The chunk totals are computed in parallel, scanned on the calling thread and then used as the starting values of
+ * a second parallel pass. The destination may be the source itself.
+ *
+ * @param pBegin: The first source element.
+ * @param pEnd: The end of the source range.
+ * @param pDestination: The first destination element.
+ * @param identity: The identity value of the operation.
+ * @param operation: The associative operation, called with (accumulated, element).
+ * @param grainSize: The number of elements scanned by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, class Operation = std::plus<Type>>
+void parallelScan(const Type* pBegin, const Type* pEnd, Type* pDestination, Type identity = Type(), Operation operation = Operation(), size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	if (grainSize == 0)
+		grainSize = 1;
+
+	const size_t count = pEnd - pBegin;
+	const size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+	// Compute the total of each chunk.
+	Array<Type> offsets(chunkCount, identity);
+	parallelFor(0, chunkCount, [&](size_t first, size_t last)
+		{
+			for (size_t chunk = first; chunk < last; chunk++)
+			{
+				const size_t end = std::min(count, (chunk + 1) * grainSize);
+
+				Type total = identity;
+				for (size_t index = chunk * grainSize; index < end; index++)
+					total = operation(total, pBegin[index]);
+
+				offsets[chunk] = total;
+			}
+		}, 1, pool);
+
+	// Turn the totals into the starting values of the chunks.
+	Type running = identity;
+	for (size_t chunk = 0; chunk < chunkCount; chunk++)
+	{
+		const Type total = offsets[chunk];
+		offsets[chunk] = running;
+		running = operation(running, total);
+	}
+
+	// Scan the chunks.
+	parallelFor(0, chunkCount, [&](size_t first, size_t last)
+		{
+			for (size_t chunk = first; chunk < last; chunk++)
+			{
+				const size_t end = std::min(count, (chunk + 1) * grainSize);
+
+				Type accumulated = offsets[chunk];
+				for (size_t index = chunk * grainSize; index < end; index++)
+				{
+					accumulated = operation(accumulated, pBegin[index]);
+					pDestination[index] = accumulated;
+				}
+			}
+		}, 1, pool);
+}
+
+/**
+ * Call a function for every element of an array in parallel.
+ *
+ * @param array: The array.
+ * @param function: The function to be called with each element.
+ * @param grainSize: The maximum number of elements processed by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, size_t SizeBias, class Allocator, class GrowthPolicy, class Function>
+void parallelForEach(Array<Type, SizeBias, Allocator, GrowthPolicy>& array, Function&& function, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	parallelForEach(array.begin(), array.end(), std::forward<Function>(function), grainSize, pool);
+}
+
+/**
+ * Call a function for every element of a static array in parallel.
+ *
+ * @param array: The static array.
+ * @param function: The function to be called with each element.
+ * @param grainSize: The maximum number of elements processed by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, size_t ArrayCount, class Function>
+void parallelForEach(StaticArray<Type, ArrayCount>& array, Function&& function, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	parallelForEach(array.begin(), array.end(), std::forward<Function>(function), grainSize, pool);
+}
+
+/**
+ * Transform the elements of an array into another array in parallel.
+ * The destination is resized to the size of the source.
+ *
+ * @param source: The source array.
+ * @param destination: The destination array.
+ * @param function: The function which maps a source element to a destination element.
+ * @param grainSize: The maximum number of elements processed by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, size_t SizeBias, class Allocator, class GrowthPolicy, class Result, size_t ResultSizeBias, class ResultAllocator, class ResultGrowthPolicy, class Function>
+void parallelTransform(const Array<Type, SizeBias, Allocator, GrowthPolicy>& source, Array<Result, ResultSizeBias, ResultAllocator, ResultGrowthPolicy>& destination, Function&& function, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	if (destination.size() != source.size())
+		destination.resize(source.size());
+
+	parallelTransform(source.begin(), source.end(), destination.begin(), std::forward<Function>(function), grainSize, pool);
+}
+
+/**
+ * Transform the elements of a static array into another static array in parallel.
+ *
+ * @param source: The source static array.
+ * @param destination: The destination static array.
+ * @param function: The function which maps a source element to a destination element.
+ * @param grainSize: The maximum number of elements processed by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, class Result, size_t ArrayCount, class Function>
+void parallelTransform(const StaticArray<Type, ArrayCount>& source, StaticArray<Result, ArrayCount>& destination, Function&& function, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	parallelTransform(source.begin(), source.end(), destination.begin(), std::forward<Function>(function), grainSize, pool);
+}
+
+/**
+ * Reduce an array in parallel into a result of another type.
+ *
+ * @param array: The array.
+ * @param identity: The identity value of the operations.
+ * @param operation: The operation, called with (accumulated, element).
+ * @param combine: The associative operation which combines the results of two chunks, called with (accumulated, result).
+ * @param grainSize: The number of elements reduced by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, size_t SizeBias, class Allocator, class GrowthPolicy, class Result, class Operation, class Combine>
+	requires std::is_invocable_r_v<Result, Combine&, Result, Result>
+Result parallelReduce(const Array<Type, SizeBias, Allocator, GrowthPolicy>& array, Result identity, Operation&& operation, Combine&& combine, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	return parallelReduce(array.begin(), array.end(), identity, std::forward<Operation>(operation), std::forward<Combine>(combine), grainSize, pool);
+}
+
+/**
+ * Reduce an array in parallel.
+ *
+ * @param array: The array.
+ * @param identity: The identity value of the operation.
+ * @param operation: The associative operation, called with (accumulated, element).
+ * @param grainSize: The number of elements reduced by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, size_t SizeBias, class Allocator, class GrowthPolicy, class Operation>
+Type parallelReduce(const Array<Type, SizeBias, Allocator, GrowthPolicy>& array, std::type_identity_t<Type> identity, Operation&& operation, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	return parallelReduce(array.begin(), array.end(), identity, std::forward<Operation>(operation), grainSize, pool);
+}
+
+/**
+ * Reduce a static array in parallel into a result of another type.
+ *
+ * @param array: The static array.
+ * @param identity: The identity value of the operations.
+ * @param operation: The operation, called with (accumulated, element).
+ * @param combine: The associative operation which combines the results of two chunks, called with (accumulated, result).
+ * @param grainSize: The number of elements reduced by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, size_t ArrayCount, class Result, class Operation, class Combine>
+	requires std::is_invocable_r_v<Result, Combine&, Result, Result>
+Result parallelReduce(const StaticArray<Type, ArrayCount>& array, Result identity, Operation&& operation, Combine&& combine, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	return parallelReduce(array.begin(), array.end(), identity, std::forward<Operation>(operation), std::forward<Combine>(combine), grainSize, pool);
+}
+
+/**
+ * Reduce a static array in parallel.
+ *
+ * @param array: The static array.
+ * @param identity: The identity value of the operation.
+ * @param operation: The associative operation, called with (accumulated, element).
+ * @param grainSize: The number of elements reduced by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, size_t ArrayCount, class Operation>
+Type parallelReduce(const StaticArray<Type, ArrayCount>& array, std::type_identity_t<Type> identity, Operation&& operation, size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	return parallelReduce(array.begin(), array.end(), identity, std::forward<Operation>(operation), grainSize, pool);
+}
+
+/**
+ * Sort an array in parallel.
+ *
+ * @param array: The array.
+ * @param compare: The less than comparison.
+ * @param grainSize: The number of elements sorted by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, size_t SizeBias, class Allocator, class GrowthPolicy, class Compare = std::less<Type>>
+void parallelSort(Array<Type, SizeBias, Allocator, GrowthPolicy>& array, Compare compare = Compare(), size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	parallelSort(array.begin(), array.end(), compare, grainSize, pool);
+}
+
+/**
+ * Sort a static array in parallel.
+ *
+ * @param array: The static array.
+ * @param compare: The less than comparison.
+ * @param grainSize: The number of elements sorted by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, size_t ArrayCount, class Compare = std::less<Type>>
+void parallelSort(StaticArray<Type, ArrayCount>& array, Compare compare = Compare(), size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	parallelSort(array.begin(), array.end(), compare, grainSize, pool);
+}
+
+/**
+ * Compute the inclusive prefix scan of an array in place, in parallel.
+ *
+ * @param array: The array.
+ * @param identity: The identity value of the operation.
+ * @param operation: The associative operation, called with (accumulated, element).
+ * @param grainSize: The number of elements scanned by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, size_t SizeBias, class Allocator, class GrowthPolicy, class Operation = std::plus<Type>>
+void parallelScan(Array<Type, SizeBias, Allocator, GrowthPolicy>& array, Type identity = Type(), Operation operation = Operation(), size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	parallelScan(array.begin(), array.end(), array.begin(), identity, operation, grainSize, pool);
+}
+
+/**
+ * Compute the inclusive prefix scan of a static array in place, in parallel.
+ *
+ * @param array: The static array.
+ * @param identity: The identity value of the operation.
+ * @param operation: The associative operation, called with (accumulated, element).
+ * @param grainSize: The number of elements scanned by a single task.
+ * @param pool: The pool to run the tasks on.
+ */
+template<class Type, size_t ArrayCount, class Operation = std::plus<Type>>
+void parallelScan(StaticArray<Type, ArrayCount>& array, Type identity = Type(), Operation operation = Operation(), size_t grainSize = DefaultGrainSize, ThreadPool& pool = GetDefaultThreadPool())
+{
+	parallelScan(array.begin(), array.end(), array.begin(), identity, operation, grainSize, pool);
+}
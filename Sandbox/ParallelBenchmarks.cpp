@@ -0,0 +1,160 @@
+#include "Parallel.h"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+
+/**
+ * Number of elements processed by the benchmarks.
+ */
+constexpr size_t ParallelElementCount = 1 << 22;
+
+/**
+ * Arguments: thread counts from 1 to the hardware concurrency.
+ */
+static void ThreadArguments(benchmark::internal::Benchmark* pBenchmark)
+{
+	const int64_t maximum = std::max<int64_t>(1, std::thread::hardware_concurrency());
+
+	pBenchmark->ArgName("threads");
+	for (int64_t threads = 1; threads <= maximum; threads *= 2)
+		pBenchmark->Arg(threads);
+
+	// Always measure the full machine, even if it is not a power of two.
+	if ((maximum & (maximum - 1)) != 0)
+		pBenchmark->Arg(maximum);
+
+	pBenchmark->UseRealTime();
+}
+
+/**
+ * Create an array of random floats.
+ */
+static Array<float> CreateRandomFloats()
+{
+	Array<float> array;
+	array.reserve(ParallelElementCount);
+
+	std::mt19937 engine(42);
+	std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+	for (size_t index = 0; index < ParallelElementCount; index++)
+		array.pushBack(distribution(engine));
+
+	return array;
+}
+
+/**
+ * Apply a moderately expensive function to every element.
+ */
+static void BM_ParallelForEach(benchmark::State& state)
+{
+	ThreadPool pool(static_cast<size_t>(state.range(0)));
+	Array<float> array = CreateRandomFloats();
+
+	for (auto _ : state)
+	{
+		parallelForEach(array, [](float& value) { value = std::sqrt(value * value + 1.0f) - 1.0f; }, DefaultGrainSize, pool);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * ParallelElementCount);
+}
+
+BENCHMARK(BM_ParallelForEach)->Apply(ThreadArguments);
+
+/**
+ * Apply a function to every element with different grain sizes on all the threads.
+ */
+static void BM_ParallelForEachGrain(benchmark::State& state)
+{
+	ThreadPool pool;
+	Array<float> array = CreateRandomFloats();
+
+	for (auto _ : state)
+	{
+		parallelForEach(array, [](float& value) { value = std::sqrt(value * value + 1.0f) - 1.0f; }, static_cast<size_t>(state.range(0)), pool);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * ParallelElementCount);
+}
+
+BENCHMARK(BM_ParallelForEachGrain)->ArgName("grain")->RangeMultiplier(8)->Range(64, 1 << 18)->UseRealTime();
+
+/**
+ * Transform the elements into another array.
+ */
+static void BM_ParallelTransform(benchmark::State& state)
+{
+	ThreadPool pool(static_cast<size_t>(state.range(0)));
+	const Array<float> source = CreateRandomFloats();
+	Array<double> destination;
+
+	for (auto _ : state)
+	{
+		parallelTransform(source, destination, [](float value) { return std::exp(static_cast<double>(value)); }, DefaultGrainSize, pool);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * ParallelElementCount);
+}
+
+BENCHMARK(BM_ParallelTransform)->Apply(ThreadArguments);
+
+/**
+ * Sum the elements.
+ */
+static void BM_ParallelReduce(benchmark::State& state)
+{
+	ThreadPool pool(static_cast<size_t>(state.range(0)));
+	const Array<float> array = CreateRandomFloats();
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(parallelReduce(array, 0.0, [](double sum, double value) { return sum + value; }, DefaultGrainSize, pool));
+
+	state.SetItemsProcessed(state.iterations() * ParallelElementCount);
+}
+
+BENCHMARK(BM_ParallelReduce)->Apply(ThreadArguments);
+
+/**
+ * Sort random elements.
+ */
+static void BM_ParallelSort(benchmark::State& state)
+{
+	ThreadPool pool(static_cast<size_t>(state.range(0)));
+	const Array<float> source = CreateRandomFloats();
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		Array<float> array = source;
+		state.ResumeTiming();
+
+		parallelSort(array, std::less<float>(), 1 << 16, pool);
+		benchmark::DoNotOptimize(array.front());
+	}
+
+	state.SetItemsProcessed(state.iterations() * ParallelElementCount);
+}
+
+BENCHMARK(BM_ParallelSort)->Apply(ThreadArguments);
+
+/**
+ * Compute the prefix sum in place.
+ */
+static void BM_ParallelScan(benchmark::State& state)
+{
+	ThreadPool pool(static_cast<size_t>(state.range(0)));
+	Array<float> array = CreateRandomFloats();
+
+	for (auto _ : state)
+	{
+		parallelScan(array, 0.0f, std::plus<float>(), 1 << 16, pool);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * ParallelElementCount);
+}
+
+BENCHMARK(BM_ParallelScan)->Apply(ThreadArguments);
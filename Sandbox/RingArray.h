@@ -0,0 +1,532 @@
+#pragma once
+#include "Array.h"
+
+/**
+ * A ring buffer based dynamic array.
+ * Elements are stored in a circular block with a head offset, so adding or removing elements at either end is
+ * O(1) (amortized when the block needs to grow). This makes it suitable to be used as a queue or a deque.
+ *
+ * @tparam Type: The type of the data stored in the array.
+ * @tparam SizeBias: The number of slots to be allocated at a single instance.
+ * @tparam Allocator: A custom allocator based on the ArrayAllocator class to allocate memory.
+ * @tparam GrowthPolicy: The policy used to calculate the new capacity when the array is full. Default is GrowthPolicy1_5x.
+ */
+template<class Type, size_t SizeBias = 1, class Allocator = ArrayAllocator<Type, alignof(Type)>, class GrowthPolicy = GrowthPolicy1_5x>
+class RingArray : private Allocator // Empty base optimization
+{
+	// Check if the input template arguments are valid.
+	static_assert(!std::is_same<Type, Allocator>::value, "Invalid template arguments! Template parameters are RingArray<Type, SizeBias, Allocator, GrowthPolicy>.");
+
+public:
+	/**
+	 * Default constructor.
+	 */
+	RingArray() : pBlock(nullptr), mCapacity(0), mHead(0), mSize(0) {}
+
+	/**
+	 * Construct the array using an allocator.
+	 *
+	 * @param allocator: The allocator to allocate memory with.
+	 */
+	explicit RingArray(const Allocator& allocator) : Allocator(allocator), pBlock(nullptr), mCapacity(0), mHead(0), mSize(0) {}
+
+	/**
+	 * Construct the array using another array (copy).
+	 *
+	 * @param other: The other array.
+	 */
+	RingArray(const RingArray<Type, SizeBias, Allocator, GrowthPolicy>& other)
+		: Allocator(other), pBlock(nullptr), mCapacity(0), mHead(0), mSize(0)
+	{
+		copyFrom(other);
+	}
+
+	/**
+	 * Construct the array using another array (move).
+	 *
+	 * @param other: The other array.
+	 */
+	RingArray(RingArray<Type, SizeBias, Allocator, GrowthPolicy>&& other) noexcept
+		: Allocator(static_cast<Allocator&&>(other)), pBlock(other.pBlock), mCapacity(other.mCapacity), mHead(other.mHead), mSize(other.mSize)
+	{
+		other.pBlock = nullptr;
+		other.mCapacity = 0;
+		other.mHead = 0;
+		other.mSize = 0;
+	}
+
+	/**
+	 * Construct the array using an initializer list.
+	 *
+	 * @param list: The initializer list.
+	 */
+	RingArray(std::initializer_list<Type> list)
+		: pBlock(nullptr), mCapacity(0), mHead(0), mSize(0)
+	{
+		reserve(list.size());
+
+		for (const Type& value : list)
+			pushBack(value);
+	}
+
+	/**
+	 * Default destructor.
+	 */
+	~RingArray() { clear(); }
+
+public:
+	/**
+	 * Add an element to the end of the array (copy).
+	 *
+	 * @param value: The value to be added.
+	 */
+	void pushBack(const Type& value)
+	{
+		emplaceBack(value);
+	}
+
+	/**
+	 * Add an element to the end of the array (move).
+	 *
+	 * @param value: The value to be added.
+	 */
+	void pushBack(Type&& value)
+	{
+		emplaceBack(std::move(value));
+	}
+
+	/**
+	 * Construct an element in place at the end of the array.
+	 *
+	 * @param arguments: The arguments to be passed to the constructor of the element.
+	 * @return: The newly constructed element.
+	 */
+	template<class... Arguments>
+	Type& emplaceBack(Arguments&&... arguments)
+	{
+		Type* pSlot = nullptr;
+
+		// Check if the allocated block is full.
+		if (mSize == mCapacity)
+		{
+			// The arguments might refer to an element in this array, so construct the element before reallocating.
+			Type value(std::forward<Arguments>(arguments)...);
+			extend();
+
+			pSlot = new (slot(mSize)) Type(std::move(value));
+		}
+		else
+			pSlot = new (slot(mSize)) Type(std::forward<Arguments>(arguments)...);
+
+		mSize++;
+		return *pSlot;
+	}
+
+	/**
+	 * Pop the last element after returning the value of it.
+	 */
+	Type popBack()
+	{
+		mSize--;
+
+		// Move the value out before destroying the element.
+		Type* pSlot = slot(mSize);
+		Type retValue = std::move(*pSlot);
+		pSlot->~Type();
+
+		return retValue;
+	}
+
+	/**
+	 * Push an element to the front of the array (copy).
+	 *
+	 * @param value: The value to be added.
+	 */
+	void pushFront(const Type& value)
+	{
+		emplaceFront(value);
+	}
+
+	/**
+	 * Push an element to the front of the array (move).
+	 *
+	 * @param value: The value to be added.
+	 */
+	void pushFront(Type&& value)
+	{
+		emplaceFront(std::move(value));
+	}
+
+	/**
+	 * Construct an element in place at the front of the array.
+	 *
+	 * @param arguments: The arguments to be passed to the constructor of the element.
+	 * @return: The newly constructed element.
+	 */
+	template<class... Arguments>
+	Type& emplaceFront(Arguments&&... arguments)
+	{
+		Type* pSlot = nullptr;
+
+		// Check if the allocated block is full.
+		if (mSize == mCapacity)
+		{
+			// The arguments might refer to an element in this array, so construct the element before reallocating.
+			Type value(std::forward<Arguments>(arguments)...);
+			extend();
+
+			mHead = previous(mHead);
+			pSlot = new (pBlock + mHead) Type(std::move(value));
+		}
+		else
+		{
+			mHead = previous(mHead);
+			pSlot = new (pBlock + mHead) Type(std::forward<Arguments>(arguments)...);
+		}
+
+		mSize++;
+		return *pSlot;
+	}
+
+	/**
+	 * Pop the first element after returning the value of it.
+	 */
+	Type popFront()
+	{
+		// Move the value out before destroying the element.
+		Type* pSlot = pBlock + mHead;
+		Type retValue = std::move(*pSlot);
+		pSlot->~Type();
+
+		// Advance the head.
+		mHead = wrap(mHead + 1);
+		mSize--;
+
+		return retValue;
+	}
+
+	/**
+	 * Extend the array by a certain size.
+	 * The new capacity is calculated using the growth policy so it will be able to store at least size more
+	 * elements.
+	 *
+	 * @param size: The size to be extended (element count). Default is SizeBias.
+	 */
+	void extend(size_t size = SizeBias)
+	{
+		reallocate(GrowthPolicy::Calculate(mCapacity, mSize + size, SizeBias));
+	}
+
+	/**
+	 * Reserve memory to store a number of elements.
+	 * This does nothing if the capacity is already large enough.
+	 *
+	 * @param count: The number of elements to reserve memory for.
+	 */
+	void reserve(size_t count)
+	{
+		if (count > mCapacity)
+			reallocate(count);
+	}
+
+	/**
+	 * Release the unused capacity of the array.
+	 */
+	void shrinkToFit()
+	{
+		if (mSize != mCapacity)
+			reallocate(mSize);
+	}
+
+	/**
+	 * Clear all the data in the array.
+	 * This resets all the data in this to its default.
+	 */
+	void clear()
+	{
+		// Destroy the stored elements.
+		if constexpr (!std::is_trivially_destructible_v<Type>)
+			for (size_t index = 0; index < mSize; index++)
+				slot(index)->~Type();
+
+		// Terminate the block if already allocated.
+		if (pBlock)
+			Allocator::DestroyBlock(pBlock, typeSize() * mCapacity);
+
+		// Reset the data.
+		pBlock = nullptr;
+		mCapacity = 0;
+		mHead = 0;
+		mSize = 0;
+	}
+
+	/**
+	 * Get an element at a given index.
+	 * This method accepts negative indexes.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	Type& at(long long index)
+	{
+		// Process the index.
+		if (index < 0)
+			index = size() + index;
+
+		// Return the element.
+		return *slot(static_cast<size_t>(index));
+	}
+
+	/**
+	 * Get an element at a given index.
+	 * This method accepts negative indexes.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	const Type at(long long index) const
+	{
+		// Process the index.
+		if (index < 0)
+			index = size() + index;
+
+		// Return the element.
+		return *slot(static_cast<size_t>(index));
+	}
+
+	/**
+	 * Find a certain value is present in the array.
+	 * If the array does not contain any data or if the value is not found, -1 is returned.
+	 */
+	size_t find(const Type& value) const
+	{
+		// Iterate through the array to find the required value.
+		for (size_t index = 0; index < mSize; index++)
+			if (*slot(index) == value)
+				return index;
+
+		// Return if not found.
+		return -1;
+	}
+
+public:
+	/**
+	 * Get the type size in bytes.
+	 */
+	constexpr size_t typeSize() const noexcept { return sizeof(Type); }
+
+	/**
+	 * Get the number of elements stored in the array.
+	 */
+	const size_t size() const noexcept { return mSize; }
+
+	/**
+	 * Get the number of elements which can be stored in the array.
+	 */
+	const size_t capacity() const noexcept { return mCapacity; }
+
+	/**
+	 * Check if the array is empty.
+	 */
+	bool empty() const noexcept { return mSize == 0; }
+
+	/**
+	 * Get the front element of the array.
+	 */
+	Type& front() { return pBlock[mHead]; }
+
+	/**
+	 * Get the front element of the array.
+	 */
+	const Type front() const { return pBlock[mHead]; }
+
+	/**
+	 * Get the back element of the array.
+	 */
+	Type& back() { return *slot(mSize - 1); }
+
+	/**
+	 * Get the back element of the array.
+	 */
+	const Type back() const { return *slot(mSize - 1); }
+
+	/**
+	 * Check if an index is valid.
+	 */
+	bool isValidIndex(long long index) const { return index < 0 ? ((size() + index) < size()) : (static_cast<size_t>(index) < size()); }
+
+public:
+	/**
+	 * Index operator.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	Type& operator[](long long index)
+	{
+		return at(index);
+	}
+
+	/**
+	 * Index operator.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	const Type operator[](long long index) const
+	{
+		return at(index);
+	}
+
+	/**
+	 * Assignment operator (copy).
+	 *
+	 * @param other: The other array.
+	 */
+	RingArray<Type, SizeBias, Allocator, GrowthPolicy>& operator=(const RingArray<Type, SizeBias, Allocator, GrowthPolicy>& other)
+	{
+		// Check if we are assigning to ourselves.
+		if (this == &other)
+			return *this;
+
+		clear();
+		copyFrom(other);
+
+		return *this;
+	}
+
+	/**
+	 * Assignment operator (move).
+	 *
+	 * @param other: The other array.
+	 */
+	RingArray<Type, SizeBias, Allocator, GrowthPolicy>& operator=(RingArray<Type, SizeBias, Allocator, GrowthPolicy>&& other) noexcept
+	{
+		// Check if we are assigning to ourselves.
+		if (this == &other)
+			return *this;
+
+		clear();
+
+		// Take the other array's allocator along with its memory.
+		static_cast<Allocator&>(*this) = static_cast<Allocator&>(other);
+
+		// Copy contents of the other array.
+		pBlock = other.pBlock;
+		mCapacity = other.mCapacity;
+		mHead = other.mHead;
+		mSize = other.mSize;
+
+		// Reset the contents of the other array.
+		other.pBlock = nullptr;
+		other.mCapacity = 0;
+		other.mHead = 0;
+		other.mSize = 0;
+
+		return *this;
+	}
+
+private:
+	/**
+	 * Wrap a physical index which is less than twice the capacity back in to the block.
+	 *
+	 * @param index: The physical index.
+	 */
+	size_t wrap(size_t index) const noexcept
+	{
+		return index >= mCapacity ? index - mCapacity : index;
+	}
+
+	/**
+	 * Get the physical index which comes before another.
+	 *
+	 * @param index: The physical index.
+	 */
+	size_t previous(size_t index) const noexcept
+	{
+		return index ? index - 1 : mCapacity - 1;
+	}
+
+	/**
+	 * Get the address of a logical index.
+	 *
+	 * @param index: The logical index (0 is the front element).
+	 */
+	Type* slot(size_t index) const noexcept
+	{
+		return pBlock + wrap(mHead + index);
+	}
+
+	/**
+	 * Copy the elements of another array in to this.
+	 * This array must be empty.
+	 *
+	 * @param other: The other array.
+	 */
+	void copyFrom(const RingArray<Type, SizeBias, Allocator, GrowthPolicy>& other)
+	{
+		// Check if the other array has data in it.
+		if (!other.mSize)
+			return;
+
+		pBlock = Allocator::CreateNewBlock(typeSize() * other.mSize);
+		mCapacity = other.mSize;
+
+		for (; mSize < other.mSize; mSize++)
+			new (pBlock + mSize) Type(*other.slot(mSize));
+	}
+
+	/**
+	 * Move the stored elements to a new block with a given capacity.
+	 * The elements are unwrapped so that the head of the new block is at 0.
+	 *
+	 * @param newCapacity: The capacity of the new block. This must not be less than the size.
+	 */
+	void reallocate(size_t newCapacity)
+	{
+		Type* pNewBlock = newCapacity ? Allocator::CreateNewBlock(typeSize() * newCapacity) : nullptr;
+
+		if (mSize)
+		{
+			// The elements are stored in at most two contiguous ranges.
+			const size_t firstCount = mHead + mSize > mCapacity ? mCapacity - mHead : mSize;
+			relocate(pNewBlock, pBlock + mHead, firstCount);
+			relocate(pNewBlock + firstCount, pBlock, mSize - firstCount);
+		}
+
+		// Terminate the old block.
+		if (pBlock)
+			Allocator::DestroyBlock(pBlock, typeSize() * mCapacity);
+
+		pBlock = pNewBlock;
+		mCapacity = newCapacity;
+		mHead = 0;
+	}
+
+	/**
+	 * Relocate a number of elements to uninitialized memory.
+	 * The source elements are destroyed after this.
+	 *
+	 * @param pDst: The destination address.
+	 * @param pSrc: The source address.
+	 * @param count: The number of elements to relocate.
+	 */
+	void relocate(Type* pDst, Type* pSrc, size_t count)
+	{
+		if constexpr (IsTriviallyRelocatable<Type>::value)
+		{
+			if (count)
+				std::memcpy(pDst, pSrc, count * typeSize());
+		}
+		else
+		{
+			for (; count; count--, pDst++, pSrc++)
+			{
+				new (pDst) Type(std::move(*pSrc));
+				pSrc->~Type();
+			}
+		}
+	}
+
+private:
+	Type* pBlock = nullptr;		// The memory block of the array.
+	size_t mCapacity = 0;		// The number of elements which can be stored in the block.
+	size_t mHead = 0;			// The physical index of the front element.
+	size_t mSize = 0;			// The number of elements stored.
+};
@@ -0,0 +1,137 @@
+#include "RingArray.h"
+
+#include <deque>
+#include <benchmark/benchmark.h>
+
+/**
+ * Use a container as a work queue.
+ * The queue is filled with a number of elements and then every iteration enqueues one element and dequeues one,
+ * so the queue length stays the same.
+ */
+template<class Queue>
+static void RunWorkQueue(benchmark::State& state, Queue& queue)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+	int value = 0;
+
+	for (auto _ : state)
+	{
+		for (size_t index = 0; index < count; index++)
+		{
+			queue.pushBack(value++);
+			benchmark::DoNotOptimize(queue.popFront());
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Array used as a queue. popFront shifts the whole array.
+ */
+static void BM_ArrayWorkQueue(benchmark::State& state)
+{
+	Array<int> queue;
+	for (long long index = 0; index < state.range(0); index++)
+		queue.pushBack(static_cast<int>(index));
+
+	RunWorkQueue(state, queue);
+}
+
+BENCHMARK(BM_ArrayWorkQueue)->RangeMultiplier(8)->Range(8, 32768);
+
+/**
+ * Ring array used as a queue.
+ */
+static void BM_RingArrayWorkQueue(benchmark::State& state)
+{
+	RingArray<int> queue;
+	for (long long index = 0; index < state.range(0); index++)
+		queue.pushBack(static_cast<int>(index));
+
+	RunWorkQueue(state, queue);
+}
+
+BENCHMARK(BM_RingArrayWorkQueue)->RangeMultiplier(8)->Range(8, 1 << 20);
+
+/**
+ * Thin wrapper around the standard deque so it can be used with the same workload.
+ */
+struct StandardDeque {
+	void pushBack(int value) { deque.push_back(value); }
+
+	int popFront()
+	{
+		int value = deque.front();
+		deque.pop_front();
+		return value;
+	}
+
+	std::deque<int> deque;
+};
+
+/**
+ * The standard deque for reference.
+ */
+static void BM_DequeWorkQueue(benchmark::State& state)
+{
+	StandardDeque queue;
+	for (long long index = 0; index < state.range(0); index++)
+		queue.pushBack(static_cast<int>(index));
+
+	RunWorkQueue(state, queue);
+}
+
+BENCHMARK(BM_DequeWorkQueue)->RangeMultiplier(8)->Range(8, 1 << 20);
+
+/**
+ * Push elements alternately to both ends and then drain the container from both ends.
+ */
+static void BM_RingArrayDoubleEnded(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		RingArray<int> ring;
+		for (size_t index = 0; index < count; index++)
+			(index & 1) ? ring.pushFront(static_cast<int>(index)) : ring.pushBack(static_cast<int>(index));
+
+		while (ring.size() > 1)
+		{
+			benchmark::DoNotOptimize(ring.popFront());
+			benchmark::DoNotOptimize(ring.popBack());
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_RingArrayDoubleEnded)->RangeMultiplier(8)->Range(8, 1 << 20);
+
+/**
+ * The standard deque for reference.
+ */
+static void BM_DequeDoubleEnded(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		std::deque<int> deque;
+		for (size_t index = 0; index < count; index++)
+			(index & 1) ? deque.push_front(static_cast<int>(index)) : deque.push_back(static_cast<int>(index));
+
+		while (deque.size() > 1)
+		{
+			deque.pop_front();
+			deque.pop_back();
+		}
+
+		benchmark::DoNotOptimize(deque.size());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_DequeDoubleEnded)->RangeMultiplier(8)->Range(8, 1 << 20);
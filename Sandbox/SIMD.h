@@ -0,0 +1,228 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Portable helpers for writing SIMD code with runtime dispatch.
+ *
+ * Kernels for an instruction set are written inside a SIMD_BEGIN_TARGET_* / SIMD_END_TARGET region. On GCC and
+ * Clang this enables the instruction set for the functions in the region only, so the rest of the program can be
+ * compiled for the baseline architecture. MSVC does not need this, as it allows any intrinsic to be used.
+ * The instruction set to use is then selected at runtime using SIMD::GetLevel().
+ */
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+	#define SIMD_X86
+
+	#ifdef _MSC_VER
+		#include <intrin.h>
+
+	#else
+		#include <cpuid.h>
+
+	#endif // _MSC_VER
+
+	#include <immintrin.h>
+
+#endif // x86
+
+/**
+ * SSE2 is a part of the x86-64 baseline (and enabled by default for 32 bit targets by the compilers), so it can be
+ * used without a runtime check.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define SIMD_SSE2
+
+#endif // SSE2
+
+#if defined(SIMD_X86) && defined(__clang__)
+	#define SIMD_BEGIN_TARGET_SSE42		_Pragma("clang attribute push (__attribute__((target(\"sse4.2,popcnt\"))), apply_to = function)")
+	#define SIMD_BEGIN_TARGET_AVX2		_Pragma("clang attribute push (__attribute__((target(\"avx2,bmi,popcnt\"))), apply_to = function)")
+	#define SIMD_BEGIN_TARGET_AVX512	_Pragma("clang attribute push (__attribute__((target(\"avx512f,avx512bw,avx2,bmi,popcnt\"))), apply_to = function)")
+	#define SIMD_END_TARGET				_Pragma("clang attribute pop")
+
+#elif defined(SIMD_X86) && defined(__GNUC__)
+	#define SIMD_BEGIN_TARGET_SSE42		_Pragma("GCC push_options") _Pragma("GCC target(\"sse4.2,popcnt\")")
+	#define SIMD_BEGIN_TARGET_AVX2		_Pragma("GCC push_options") _Pragma("GCC target(\"avx2,bmi,popcnt\")")
+	#define SIMD_BEGIN_TARGET_AVX512	_Pragma("GCC push_options") _Pragma("GCC target(\"avx512f,avx512bw,avx2,bmi,popcnt\")")
+	#define SIMD_END_TARGET				_Pragma("GCC pop_options")
+
+#else
+	#define SIMD_BEGIN_TARGET_SSE42
+	#define SIMD_BEGIN_TARGET_AVX2
+	#define SIMD_BEGIN_TARGET_AVX512
+	#define SIMD_END_TARGET
+
+#endif // Compiler
+
+// Kernels which deliberately read past the end of a buffer (for example strlen style loops using aligned loads, which
+// never cross a page boundary) are excluded from the address sanitizer.
+#if defined(__clang__) || defined(__GNUC__)
+	#define SIMD_NO_SANITIZE_ADDRESS	__attribute__((no_sanitize_address))
+
+#elif defined(_MSC_VER)
+	#define SIMD_NO_SANITIZE_ADDRESS	__declspec(no_sanitize_address)
+
+#else
+	#define SIMD_NO_SANITIZE_ADDRESS
+
+#endif // Compiler
+
+namespace SIMD {
+	/**
+	 * Instruction set levels, ordered from the least to the most capable.
+	 */
+	enum class Level : uint8_t {
+		Scalar,
+		SSE42,
+		AVX2,
+		AVX512,
+	};
+
+	/**
+	 * Detect the highest instruction set level supported by the CPU and the operating system.
+	 * AVX2 also requires BMI1/POPCNT, and AVX-512 requires the F and BW subsets.
+	 */
+	inline Level DetectLevel()
+	{
+#ifdef SIMD_X86
+		uint32_t registers1[4] = {};	// EAX, EBX, ECX, EDX of leaf 1.
+		uint32_t registers7[4] = {};	// EAX, EBX, ECX, EDX of leaf 7.
+
+#ifdef _MSC_VER
+		int info[4] = {};
+		__cpuid(info, 0);
+		const int maximumLeaf = info[0];
+
+		__cpuid(info, 1);
+		for (int index = 0; index < 4; index++) registers1[index] = static_cast<uint32_t>(info[index]);
+
+		if (maximumLeaf >= 7)
+		{
+			__cpuidex(info, 7, 0);
+			for (int index = 0; index < 4; index++) registers7[index] = static_cast<uint32_t>(info[index]);
+		}
+
+#else
+		const unsigned int maximumLeaf = __get_cpuid_max(0, nullptr);
+		__get_cpuid(1, &registers1[0], &registers1[1], &registers1[2], &registers1[3]);
+
+		if (maximumLeaf >= 7)
+			__cpuid_count(7, 0, registers7[0], registers7[1], registers7[2], registers7[3]);
+
+#endif // _MSC_VER
+
+		const bool sse42 = (registers1[2] & (1u << 20)) && (registers1[2] & (1u << 23));
+		if (!sse42)
+			return Level::Scalar;
+
+		// The OS must save the YMM (and ZMM) registers on context switches.
+		const bool osxsave = registers1[2] & (1u << 27);
+		const bool avx = registers1[2] & (1u << 28);
+		if (!osxsave || !avx)
+			return Level::SSE42;
+
+#ifdef _MSC_VER
+		const uint64_t xcr0 = _xgetbv(0);
+
+#else
+		uint32_t xcr0Low = 0, xcr0High = 0;
+		__asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+		const uint64_t xcr0 = (static_cast<uint64_t>(xcr0High) << 32) | xcr0Low;
+
+#endif // _MSC_VER
+
+		const bool avx2 = (registers7[1] & (1u << 5)) && (registers7[1] & (1u << 3));
+		if (!avx2 || (xcr0 & 0x6) != 0x6)
+			return Level::SSE42;
+
+		const bool avx512 = (registers7[1] & (1u << 16)) && (registers7[1] & (1u << 30));
+		if (!avx512 || (xcr0 & 0xE6) != 0xE6)
+			return Level::AVX2;
+
+		return Level::AVX512;
+
+#else
+		return Level::Scalar;
+
+#endif // SIMD_X86
+	}
+
+	/**
+	 * Override the detected level. This is used to benchmark and test the lower levels on capable machines.
+	 * Setting a level higher than the detected level is ignored.
+	 */
+	inline Level& LevelOverride()
+	{
+		static Level level = Level::AVX512;
+		return level;
+	}
+
+	/**
+	 * Get the instruction set level used by the runtime dispatchers.
+	 * The CPU is only queried once.
+	 */
+	inline Level GetLevel()
+	{
+		static const Level detected = DetectLevel();
+		const Level maximum = LevelOverride();
+
+		return detected < maximum ? detected : maximum;
+	}
+
+	/**
+	 * Count the trailing zero bits of a non-zero value.
+	 *
+	 * @param value: The value. This must not be 0.
+	 */
+	inline uint32_t CountTrailingZeros(uint64_t value)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index = 0;
+		_BitScanForward64(&index, value);
+		return static_cast<uint32_t>(index);
+
+#elif defined(_MSC_VER)
+		unsigned long index = 0;
+		if (_BitScanForward(&index, static_cast<uint32_t>(value)))
+			return static_cast<uint32_t>(index);
+
+		_BitScanForward(&index, static_cast<uint32_t>(value >> 32));
+		return static_cast<uint32_t>(index) + 32;
+
+#else
+		return static_cast<uint32_t>(__builtin_ctzll(value));
+
+#endif // _MSC_VER
+	}
+
+	/**
+	 * Prefetch the cache line containing an address into all the cache levels. This never faults, so the address does
+	 * not have to be valid.
+	 *
+	 * @param address: The address.
+	 */
+	inline void Prefetch(uintptr_t address)
+	{
+#ifdef SIMD_X86
+		_mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0);
+
+#elif defined(__GNUC__)
+		__builtin_prefetch(reinterpret_cast<const void*>(address));
+
+#endif // SIMD_X86
+	}
+
+	/**
+	 * Count the number of set bits of a value.
+	 * std::popcount only uses the POPCNT instruction when the compiler may assume it (or, on MSVC, after checking the
+	 * CPU), so this is safe to call on the machines which run the scalar level.
+	 *
+	 * @param value: The value.
+	 */
+	inline uint32_t PopCount(uint64_t value)
+	{
+		return static_cast<uint32_t>(std::popcount(value));
+	}
+}
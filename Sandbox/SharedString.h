@@ -0,0 +1,423 @@
+#pragma once
+#include "String.h"
+
+#include <atomic>
+
+/**
+ * Copy on write string.
+ * The characters are stored in a reference counted buffer, so copying the string only increments the reference count
+ * and is O(1) regardless of the length. The first modification of a string whose buffer is shared with other
+ * strings copies the characters to a buffer of its own (detaches), so the other strings never see the change.
+ *
+ * This suits values which are copied into many places and rarely modified, such as configuration values and asset
+ * names. Strings which are modified often should use String, which does not pay for the reference count.
+ *
+ * Like std::shared_ptr, different strings which share a buffer can be used from different threads at the same time
+ * (the reference count is atomic), but a single string object must not be modified by one thread while another uses
+ * it. Characters are modified using set() rather than through references, as a reference could be used to modify a
+ * buffer after it was shared.
+ *
+ * @tparam Type: The character type.
+ */
+template<class Type>
+class BasicSharedString {
+	/**
+	 * Header of a buffer. The null terminated characters are stored right after the header.
+	 */
+	struct Buffer {
+		std::atomic<size_t> referenceCount = 1;	// The number of strings using the buffer.
+		size_t length = 0;						// The number of characters.
+		size_t capacity = 0;					// The number of characters the buffer can hold (excluding '\0').
+		MemoryResource* pResource = nullptr;	// The memory resource the buffer was allocated from.
+
+		/**
+		 * Get the characters of the buffer.
+		 */
+		Type* characters() noexcept { return reinterpret_cast<Type*>(this + 1); }
+	};
+
+public:
+	// String view type.
+	using View = BasicStringView<Type>;
+
+public:
+	/**
+	 * Default constructor.
+	 */
+	BasicSharedString() noexcept = default;
+
+	/**
+	 * Construct the string using a memory resource.
+	 *
+	 * @param pResource: The memory resource to allocate the buffers from. It must be thread safe if the string is
+	 *	shared between threads.
+	 */
+	explicit BasicSharedString(MemoryResource* pResource) noexcept : pResource(pResource) {}
+
+	/**
+	 * Construct the string by copying the characters of a view. This also accepts strings.
+	 *
+	 * @param view: The view.
+	 * @param pResource: The memory resource to allocate the buffers from.
+	 */
+	explicit BasicSharedString(View view, MemoryResource* pResource = GetDefaultMemoryResource()) : pResource(pResource)
+	{
+		if (view.empty())
+			return;
+
+		pBuffer = createBuffer(view.size());
+		std::memcpy(pBuffer->characters(), view.data(), view.size() * sizeof(Type));
+		pBuffer->characters()[view.size()] = 0;
+		pBuffer->length = view.size();
+	}
+
+	/**
+	 * Construct the string using a primitive string.
+	 *
+	 * @param pString: The primitive string.
+	 */
+	BasicSharedString(const Type* pString) : BasicSharedString(View(pString)) {}
+
+	/**
+	 * Copy constructor. This shares the buffer of the other string.
+	 *
+	 * @param other: The other string.
+	 */
+	BasicSharedString(const BasicSharedString& other) noexcept : pBuffer(other.pBuffer), pResource(other.pResource)
+	{
+		if (pBuffer)
+			pBuffer->referenceCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Move constructor.
+	 *
+	 * @param other: The other string.
+	 */
+	BasicSharedString(BasicSharedString&& other) noexcept : pBuffer(std::exchange(other.pBuffer, nullptr)), pResource(other.pResource) {}
+
+	/**
+	 * Default destructor.
+	 */
+	~BasicSharedString() { release(); }
+
+	/**
+	 * Get the null terminated characters.
+	 */
+	const Type* str() const noexcept
+	{
+		static constexpr Type Empty[1] = {};
+		return pBuffer ? pBuffer->characters() : Empty;
+	}
+
+	/**
+	 * Get a view of the characters.
+	 */
+	View view() const noexcept { return View(str(), size()); }
+
+	/**
+	 * Get the number of characters.
+	 */
+	size_t size() const noexcept { return pBuffer ? pBuffer->length : 0; }
+
+	/**
+	 * Check if the string is empty.
+	 */
+	bool empty() const noexcept { return size() == 0; }
+
+	/**
+	 * Get the number of strings sharing the buffer. This is 0 for an empty string without a buffer.
+	 * The value may be out of date if the buffer is shared with strings used by other threads.
+	 */
+	size_t useCount() const noexcept { return pBuffer ? pBuffer->referenceCount.load(std::memory_order_relaxed) : 0; }
+
+	/**
+	 * Get the memory resource used by the string.
+	 */
+	MemoryResource* getMemoryResource() const noexcept { return pResource; }
+
+	/**
+	 * Copy the characters to a String.
+	 */
+	String toString() const { return String(view(), pResource); }
+
+	/**
+	 * Release the buffer.
+	 */
+	void clear()
+	{
+		release();
+		pBuffer = nullptr;
+	}
+
+	/**
+	 * Make sure that a number of characters can be stored without reallocating. This detaches the string.
+	 *
+	 * @param count: The number of characters (excluding '\0').
+	 */
+	void reserve(size_t count)
+	{
+		if (count > size() || isShared())
+			reallocate(count > size() ? count : size());
+	}
+
+	/**
+	 * Append a character. This detaches the string.
+	 *
+	 * @param character: The character.
+	 */
+	void append(Type character)
+	{
+		prepareForWrite(size() + 1);
+
+		pBuffer->characters()[pBuffer->length++] = character;
+		pBuffer->characters()[pBuffer->length] = 0;
+	}
+
+	/**
+	 * Append a number of characters. This detaches the string.
+	 * The characters may be a part of this string.
+	 *
+	 * @param pString: The characters.
+	 * @param count: The number of characters.
+	 */
+	void append(const Type* pString, size_t count)
+	{
+		if (!count)
+			return;
+
+		// The characters could be a part of this string, which moves when detaching or reallocating.
+		const bool bAliases = pBuffer && pString >= str() && pString < str() + size();
+		const size_t offset = bAliases ? static_cast<size_t>(pString - str()) : 0;
+
+		prepareForWrite(size() + count);
+		if (bAliases)
+			pString = pBuffer->characters() + offset;
+
+		std::memcpy(pBuffer->characters() + pBuffer->length, pString, count * sizeof(Type));
+		pBuffer->length += count;
+		pBuffer->characters()[pBuffer->length] = 0;
+	}
+
+	/**
+	 * Replace a character. This detaches the string.
+	 *
+	 * @param index: The index of the character. Negative indexes count from the back.
+	 * @param character: The new character.
+	 */
+	void set(long long index, Type character)
+	{
+		if (index < 0)
+			index += static_cast<long long>(size());
+
+		prepareForWrite(size());
+		pBuffer->characters()[index] = character;
+	}
+
+	/**
+	 * Access a character in a given index.
+	 *
+	 * @param index: The index to be accessed. Negative indexes count from the back.
+	 */
+	Type at(long long index) const noexcept { return view().at(index); }
+
+	/**
+	 * Find a character and return its index, or -1 if it is not found.
+	 *
+	 * @param character: The character.
+	 */
+	long long find(Type character) const { return view().find(character); }
+
+	/**
+	 * Find a string and return the index of its first character, or -1 if it is not found.
+	 *
+	 * @param other: The string to search for.
+	 */
+	long long find(View other) const { return view().find(other); }
+
+	/**
+	 * Generate a hash using the characters. This is equal to the hash of a view with the same characters.
+	 */
+	size_t hash() const noexcept { return view().hash(); }
+
+public:
+	/**
+	 * Copy assignment operator. This shares the buffer of the other string.
+	 *
+	 * @param other: The other string.
+	 */
+	BasicSharedString& operator=(const BasicSharedString& other) noexcept
+	{
+		if (other.pBuffer)
+			other.pBuffer->referenceCount.fetch_add(1, std::memory_order_relaxed);
+
+		release();
+		pBuffer = other.pBuffer;
+		pResource = other.pResource;
+		return *this;
+	}
+
+	/**
+	 * Move assignment operator.
+	 *
+	 * @param other: The other string.
+	 */
+	BasicSharedString& operator=(BasicSharedString&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			pBuffer = std::exchange(other.pBuffer, nullptr);
+			pResource = other.pResource;
+		}
+
+		return *this;
+	}
+
+	/**
+	 * Append a character. This detaches the string.
+	 *
+	 * @param character: The character.
+	 */
+	BasicSharedString& operator+=(Type character)
+	{
+		append(character);
+		return *this;
+	}
+
+	/**
+	 * Append a view. This detaches the string.
+	 *
+	 * @param other: The view. This may be a part of this string.
+	 */
+	BasicSharedString& operator+=(View other)
+	{
+		append(other.data(), other.size());
+		return *this;
+	}
+
+	/**
+	 * Index operator.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	Type operator[](long long index) const noexcept { return at(index); }
+
+	/**
+	 * Is equal operator. Strings sharing a buffer are equal without comparing the characters.
+	 *
+	 * @param other: The other string.
+	 */
+	bool operator==(const BasicSharedString& other) const { return pBuffer == other.pBuffer || view() == other.view(); }
+
+	/**
+	 * Is equal operator.
+	 *
+	 * @param other: The view.
+	 */
+	bool operator==(View other) const { return view() == other; }
+
+	/**
+	 * Is equal operator.
+	 *
+	 * @param pString: The primitive string.
+	 */
+	bool operator==(const Type* pString) const { return view() == View(pString); }
+
+	/**
+	 * Convert the string to a view.
+	 */
+	operator View() const noexcept { return view(); }
+
+private:
+	/**
+	 * Check if the buffer is shared with other strings.
+	 * The acquire load makes the reads of the strings which released the buffer happen before the writes of this one.
+	 */
+	bool isShared() const noexcept { return pBuffer && pBuffer->referenceCount.load(std::memory_order_acquire) != 1; }
+
+	/**
+	 * Allocate an unshared buffer.
+	 *
+	 * @param capacity: The number of characters (excluding '\0').
+	 */
+	Buffer* createBuffer(size_t capacity) const
+	{
+		void* pBlock = pResource->allocate(sizeof(Buffer) + (capacity + 1) * sizeof(Type), alignof(Buffer));
+		Buffer* pNewBuffer = new (pBlock) Buffer();
+		pNewBuffer->capacity = capacity;
+		pNewBuffer->pResource = pResource;
+
+		return pNewBuffer;
+	}
+
+	/**
+	 * Drop the reference to the buffer, and destroy it if this was the last reference.
+	 */
+	void release() noexcept
+	{
+		if (pBuffer && pBuffer->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			const size_t byteSize = sizeof(Buffer) + (pBuffer->capacity + 1) * sizeof(Type);
+			MemoryResource* pBufferResource = pBuffer->pResource;
+
+			pBuffer->~Buffer();
+			pBufferResource->deallocate(pBuffer, byteSize, alignof(Buffer));
+		}
+	}
+
+	/**
+	 * Move the characters to a new unshared buffer.
+	 *
+	 * @param capacity: The number of characters the buffer should fit (excluding '\0'). This must not be less than
+	 *	the length.
+	 */
+	void reallocate(size_t capacity)
+	{
+		Buffer* pNewBuffer = createBuffer(capacity);
+		pNewBuffer->length = size();
+		std::memcpy(pNewBuffer->characters(), str(), (size() + 1) * sizeof(Type));
+
+		release();
+		pBuffer = pNewBuffer;
+	}
+
+	/**
+	 * Make the buffer unshared (detach) and large enough to hold a number of characters. The capacity grows by 1.5x
+	 * like String, so that appending is amortized O(1).
+	 *
+	 * @param requiredLength: The number of characters which must fit.
+	 */
+	void prepareForWrite(size_t requiredLength)
+	{
+		const size_t capacity = pBuffer ? pBuffer->capacity : 0;
+		if (requiredLength <= capacity)
+		{
+			if (isShared())
+				reallocate(capacity);
+
+			return;
+		}
+
+		size_t grown = capacity + capacity / 2;
+		if (grown < 15)
+			grown = 15;
+
+		reallocate(requiredLength > grown ? requiredLength : grown);
+	}
+
+private:
+	Buffer* pBuffer = nullptr;	// The shared buffer, or nullptr for the empty string.
+	MemoryResource* pResource = GetDefaultMemoryResource();	// The memory resource used to allocate the buffers.
+};
+
+/**
+ * Standard hash specialization, so that shared strings can be used as keys of the standard containers.
+ */
+template<class Type>
+struct std::hash<BasicSharedString<Type>> {
+	size_t operator()(const BasicSharedString<Type>& str) const noexcept { return str.hash(); }
+};
+
+// Shared string using the primitive type of the String.
+using SharedString = BasicSharedString<String::Type>;
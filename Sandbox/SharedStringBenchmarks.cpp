@@ -0,0 +1,117 @@
+#include "SharedString.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+/**
+ * Copy a String into 64 components.
+ */
+static void BM_StringCopy(benchmark::State& state)
+{
+	const String source(String::TypeSTD(static_cast<size_t>(state.range(0)), TEXT('x')).c_str());
+	std::vector<String> components(64);
+
+	for (auto _ : state)
+	{
+		for (auto& component : components)
+			component = source;
+
+		benchmark::DoNotOptimize(components.data());
+		benchmark::ClobberMemory();
+
+		// Release the copies so that every iteration copies from scratch.
+		for (auto& component : components)
+			component.clear();
+	}
+
+	state.SetItemsProcessed(state.iterations() * components.size());
+}
+
+BENCHMARK(BM_StringCopy)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+/**
+ * Copy a SharedString into 64 components.
+ */
+static void BM_SharedStringCopy(benchmark::State& state)
+{
+	const SharedString source(String::TypeSTD(static_cast<size_t>(state.range(0)), TEXT('x')).c_str());
+	std::vector<SharedString> components(64);
+
+	for (auto _ : state)
+	{
+		for (auto& component : components)
+			component = source;
+
+		benchmark::DoNotOptimize(components.data());
+		benchmark::ClobberMemory();
+
+		for (auto& component : components)
+			component.clear();
+	}
+
+	state.SetItemsProcessed(state.iterations() * components.size());
+}
+
+BENCHMARK(BM_SharedStringCopy)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+/**
+ * Copy a SharedString and modify the copy, which detaches it. This is the cost of the first write to a shared
+ * string.
+ */
+static void BM_SharedStringCopyAndDetach(benchmark::State& state)
+{
+	const SharedString source(String::TypeSTD(static_cast<size_t>(state.range(0)), TEXT('x')).c_str());
+
+	for (auto _ : state)
+	{
+		SharedString copy = source;
+		copy.set(0, TEXT('y'));
+		benchmark::DoNotOptimize(copy.str());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SharedStringCopyAndDetach)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+/**
+ * Append characters to a SharedString which is not shared, to measure the cost of the reference count check.
+ */
+static void BM_SharedStringAppendCharacter(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		SharedString string;
+		for (size_t index = 0; index < count; index++)
+			string.append(static_cast<String::Type>('a' + index % 26));
+
+		benchmark::DoNotOptimize(string.str());
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_SharedStringAppendCharacter)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+/**
+ * Append characters to a String for reference.
+ */
+static void BM_StringAppendCharacterReference(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		String string;
+		for (size_t index = 0; index < count; index++)
+			string.append(static_cast<String::Type>('a' + index % 26));
+
+		benchmark::DoNotOptimize(string.str());
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_StringAppendCharacterReference)->RangeMultiplier(16)->Range(16, 1 << 16);
@@ -0,0 +1,297 @@
+#pragma once
+#include "Array.h"
+
+#include <cstdint>
+
+/**
+ * Stable handle to an element of a slot map.
+ * A handle stays valid until its element is erased, no matter how many other elements are inserted or erased. Once
+ * the element is erased the generation of the slot changes, so the old handle is detected as stale instead of
+ * pointing to whichever element reuses the slot.
+ */
+struct SlotHandle {
+	uint32_t index = 0;			// Index of the slot.
+	uint32_t generation = 0;	// Generation of the slot when the handle was created. 0 is never a valid generation.
+
+	/**
+	 * Check if the handle was ever assigned.
+	 */
+	constexpr bool isNull() const noexcept { return generation == 0; }
+
+	/**
+	 * Is equal to operator.
+	 *
+	 * @param other: The other handle.
+	 */
+	constexpr bool operator==(const SlotHandle& other) const noexcept { return index == other.index && generation == other.generation; }
+
+	/**
+	 * Is not equal to operator.
+	 *
+	 * @param other: The other handle.
+	 */
+	constexpr bool operator!=(const SlotHandle& other) const noexcept { return !(*this == other); }
+};
+
+/**
+ * Get the generation which follows another one. 0 is skipped when the generation wraps around, so a handle of a
+ * live element is never null.
+ *
+ * @param generation: The current generation.
+ */
+constexpr uint32_t NextSlotGeneration(uint32_t generation) noexcept
+{
+	return generation == UINT32_MAX ? 1 : generation + 1;
+}
+
+/**
+ * Slot map.
+ * The elements are stored densely in an Array, so iterating over them is as fast as iterating over an array. A
+ * sparse slot table maps handles to the dense index of their element. Insertion, erasure and handle lookups are O(1);
+ * erasing moves the last element into the hole, so the order of the elements is not kept.
+ *
+ * @tparam Type: The type of the elements.
+ * @tparam Allocator: The allocator of the element array.
+ */
+template<class Type, class Allocator = ArrayAllocator<Type, alignof(Type)>>
+class SlotMap {
+	/**
+	 * Entry of the slot table.
+	 * While the slot is in use, the link is the dense index of the element. Otherwise it is the next free slot.
+	 */
+	struct Slot {
+		uint32_t link = 0;
+		uint32_t generation = 1;
+	};
+
+	static constexpr uint32_t InvalidIndex = static_cast<uint32_t>(-1);
+
+public:
+	/**
+	 * Default constructor.
+	 */
+	SlotMap() {}
+
+	/**
+	 * Construct the slot map using an allocator.
+	 *
+	 * @param allocator: The allocator of the element array.
+	 */
+	explicit SlotMap(const Allocator& allocator) : mValues(allocator) {}
+
+	/**
+	 * Insert an element.
+	 *
+	 * @param value: The value to be inserted.
+	 * @return: The handle of the element.
+	 */
+	SlotHandle insert(const Type& value) { return emplace(value); }
+
+	/**
+	 * Insert an element.
+	 *
+	 * @param value: The value to be inserted.
+	 * @return: The handle of the element.
+	 */
+	SlotHandle insert(Type&& value) { return emplace(std::move(value)); }
+
+	/**
+	 * Construct an element in place.
+	 *
+	 * @param arguments: The arguments to be passed to the constructor of the element.
+	 * @return: The handle of the element.
+	 */
+	template<class... Arguments>
+	SlotHandle emplace(Arguments&&... arguments)
+	{
+		// Reuse a free slot or create a new one.
+		const bool bNewSlot = mFreeHead == InvalidIndex;
+		const uint32_t slotIndex = bNewSlot ? static_cast<uint32_t>(mSlots.size()) : mFreeHead;
+		if (bNewSlot)
+			mSlots.pushBack(Slot());
+
+		try
+		{
+			mDenseToSlot.pushBack(slotIndex);
+			mValues.emplaceBack(std::forward<Arguments>(arguments)...);
+		}
+		catch (...)
+		{
+			// Give the slot back, so a throwing constructor leaves the map unchanged.
+			if (mDenseToSlot.size() > mValues.size())
+				mDenseToSlot.popBack();
+
+			if (bNewSlot)
+				mSlots.popBack();
+
+			throw;
+		}
+
+		Slot& slot = mSlots[slotIndex];
+		if (!bNewSlot)
+			mFreeHead = slot.link;
+
+		slot.link = static_cast<uint32_t>(mValues.size() - 1);
+
+		return SlotHandle{ slotIndex, slot.generation };
+	}
+
+	/**
+	 * Erase an element.
+	 * The last element is moved into the place of the erased one.
+	 *
+	 * @param handle: The handle of the element.
+	 * @return: False if the handle is stale or null.
+	 */
+	bool erase(SlotHandle handle)
+	{
+		if (!contains(handle))
+			return false;
+
+		Slot& slot = mSlots[handle.index];
+		const uint32_t denseIndex = slot.link;
+		const uint32_t lastIndex = static_cast<uint32_t>(mValues.size() - 1);
+
+		// Move the last element into the hole and point its slot to the new place.
+		if (denseIndex != lastIndex)
+		{
+			mValues[denseIndex] = std::move(mValues[lastIndex]);
+			mDenseToSlot[denseIndex] = mDenseToSlot[lastIndex];
+			mSlots[mDenseToSlot[denseIndex]].link = denseIndex;
+		}
+
+		mValues.popBack();
+		mDenseToSlot.popBack();
+
+		// Invalidate the handles to the slot and add it to the free list.
+		slot.generation = NextSlotGeneration(slot.generation);
+
+		slot.link = mFreeHead;
+		mFreeHead = handle.index;
+
+		return true;
+	}
+
+	/**
+	 * Check if a handle refers to a live element.
+	 *
+	 * @param handle: The handle to be checked.
+	 */
+	bool contains(SlotHandle handle) const noexcept
+	{
+		return handle.index < mSlots.size() && mSlots[handle.index].generation == handle.generation;
+	}
+
+	/**
+	 * Get the element of a handle.
+	 * Returns nullptr if the handle is stale or null.
+	 *
+	 * @param handle: The handle of the element.
+	 */
+	Type* get(SlotHandle handle) noexcept
+	{
+		return contains(handle) ? mValues.begin() + mSlots[handle.index].link : nullptr;
+	}
+
+	/**
+	 * Get the element of a handle.
+	 * Returns nullptr if the handle is stale or null.
+	 *
+	 * @param handle: The handle of the element.
+	 */
+	const Type* get(SlotHandle handle) const noexcept
+	{
+		return contains(handle) ? mValues.begin() + mSlots[handle.index].link : nullptr;
+	}
+
+	/**
+	 * Get the handle of an element using its dense index.
+	 * This is used to find the handle of an element while iterating.
+	 *
+	 * @param denseIndex: The index of the element in the dense storage.
+	 */
+	SlotHandle handleAt(size_t denseIndex) const
+	{
+		const uint32_t slotIndex = mDenseToSlot[denseIndex];
+		return SlotHandle{ slotIndex, mSlots[slotIndex].generation };
+	}
+
+	/**
+	 * Reserve space for a number of elements.
+	 *
+	 * @param count: The number of elements.
+	 */
+	void reserve(size_t count)
+	{
+		mValues.reserve(count);
+		mDenseToSlot.reserve(count);
+		mSlots.reserve(count);
+	}
+
+	/**
+	 * Erase all the elements.
+	 * Every handle becomes stale. The slots are kept so their generations are not reused.
+	 */
+	void clear()
+	{
+		while (mValues.size())
+			erase(handleAt(mValues.size() - 1));
+	}
+
+public:
+	/**
+	 * Get the number of elements.
+	 */
+	size_t size() const noexcept { return mValues.size(); }
+
+	/**
+	 * Check if the slot map is empty.
+	 */
+	bool empty() const noexcept { return mValues.size() == 0; }
+
+	/**
+	 * Begin iterator of the dense storage.
+	 */
+	Type* begin() noexcept { return mValues.begin(); }
+
+	/**
+	 * Begin iterator of the dense storage.
+	 */
+	const Type* begin() const noexcept { return mValues.begin(); }
+
+	/**
+	 * End iterator of the dense storage.
+	 */
+	Type* end() noexcept { return mValues.end(); }
+
+	/**
+	 * End iterator of the dense storage.
+	 */
+	const Type* end() const noexcept { return mValues.end(); }
+
+	/**
+	 * Get the dense storage.
+	 */
+	const Array<Type, 1, Allocator>& values() const noexcept { return mValues; }
+
+public:
+	/**
+	 * Access the element of a handle. The handle must be valid.
+	 *
+	 * @param handle: The handle of the element.
+	 */
+	Type& operator[](SlotHandle handle) { return mValues[mSlots[handle.index].link]; }
+
+	/**
+	 * Access the element of a handle. The handle must be valid.
+	 *
+	 * @param handle: The handle of the element.
+	 */
+	const Type& operator[](SlotHandle handle) const { return *get(handle); }
+
+private:
+	Array<Type, 1, Allocator> mValues;		// Dense element storage.
+	Array<uint32_t> mDenseToSlot;			// Slot index of every dense element.
+	Array<Slot> mSlots;						// Slot table.
+	uint32_t mFreeHead = InvalidIndex;		// First free slot.
+};
@@ -0,0 +1,112 @@
+#include "SlotMap.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <unordered_map>
+
+/**
+ * Component sized payload.
+ */
+struct Transform {
+	float position[3];
+	float rotation[4];
+	float scale[3];
+};
+
+/**
+ * Keep a number of elements alive while erasing and inserting one element per step, then look up every live handle
+ * and iterate over all the elements.
+ */
+static void BM_SlotMapChurn(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	SlotMap<Transform> map;
+	Array<SlotHandle> handles;
+	for (size_t index = 0; index < count; index++)
+		handles.pushBack(map.insert(Transform()));
+
+	std::mt19937 engine(7);
+
+	for (auto _ : state)
+	{
+		// Replace a random element.
+		const size_t victim = engine() % count;
+		map.erase(handles[victim]);
+		handles[victim] = map.insert(Transform());
+
+		// Look up a few handles.
+		for (size_t lookup = 0; lookup < 4; lookup++)
+			benchmark::DoNotOptimize(map.get(handles[engine() % count]));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SlotMapChurn)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+/**
+ * Same churn with an unordered map from an incrementing id to the element.
+ */
+static void BM_UnorderedMapChurn(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	std::unordered_map<uint64_t, Transform> map;
+	Array<uint64_t> handles;
+	uint64_t nextId = 0;
+	for (size_t index = 0; index < count; index++)
+	{
+		map.emplace(nextId, Transform());
+		handles.pushBack(nextId++);
+	}
+
+	std::mt19937 engine(7);
+	for (auto _ : state)
+	{
+		const size_t victim = engine() % count;
+		map.erase(handles[victim]);
+		map.emplace(nextId, Transform());
+		handles[victim] = nextId++;
+
+		for (size_t lookup = 0; lookup < 4; lookup++)
+		{
+			auto iterator = map.find(handles[engine() % count]);
+			benchmark::DoNotOptimize(iterator == map.end() ? nullptr : &iterator->second);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_UnorderedMapChurn)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+/**
+ * Iterate over the live elements after heavy churn.
+ */
+static void BM_SlotMapIterate(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	SlotMap<Transform> map;
+	Array<SlotHandle> handles;
+	for (size_t index = 0; index < count * 2; index++)
+		handles.pushBack(map.insert(Transform()));
+
+	// Erase every other element so the slot table has holes.
+	for (size_t index = 0; index < handles.size(); index += 2)
+		map.erase(handles[index]);
+
+	for (auto _ : state)
+	{
+		float sum = 0.0f;
+		for (const Transform& transform : map)
+			sum += transform.position[0] + transform.scale[0];
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_SlotMapIterate)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
@@ -0,0 +1,507 @@
+#pragma once
+#include "Array.h"
+
+/**
+ * A dynamic array with inline storage.
+ * Up to InlineCapacity elements are stored inside the object itself, so small arrays never touch the heap. Once
+ * the inline storage overflows, the elements are moved to a block allocated using the allocator and the array
+ * behaves like a normal Array.
+ *
+ * @tparam Type: The type of the data stored in the array.
+ * @tparam InlineCapacity: The number of elements which can be stored without a heap allocation.
+ * @tparam Allocator: A custom allocator based on the ArrayAllocator class to allocate memory.
+ * @tparam GrowthPolicy: The policy used to calculate the new capacity when the array is full. Default is GrowthPolicy1_5x.
+ */
+template<class Type, size_t InlineCapacity = 8, class Allocator = ArrayAllocator<Type, alignof(Type)>, class GrowthPolicy = GrowthPolicy1_5x>
+class SmallArray : private Allocator // Empty base optimization
+{
+	// Check if the input template arguments are valid.
+	static_assert(InlineCapacity > 0, "The inline capacity of a small array must be greater than 0!");
+
+public:
+	/**
+	 * Default constructor.
+	 */
+	SmallArray() : pBegin(inlineBlock()), pNext(inlineBlock()), pEnd(inlineBlock() + InlineCapacity) {}
+
+	/**
+	 * Construct the array using an allocator.
+	 *
+	 * @param allocator: The allocator to allocate memory with once the inline storage overflows.
+	 */
+	explicit SmallArray(const Allocator& allocator) : Allocator(allocator), pBegin(inlineBlock()), pNext(inlineBlock()), pEnd(inlineBlock() + InlineCapacity) {}
+
+	/**
+	 * Construct the array using another array (copy).
+	 *
+	 * @param other: The other array.
+	 */
+	SmallArray(const SmallArray<Type, InlineCapacity, Allocator, GrowthPolicy>& other) : SmallArray(static_cast<const Allocator&>(other))
+	{
+		reserve(other.size());
+
+		for (const Type* pElement = other.pBegin; pElement != other.pNext; pElement++)
+			new (pNext++) Type(*pElement);
+	}
+
+	/**
+	 * Construct the array using another array (move).
+	 * If the other array is stored inline, the elements are moved one by one.
+	 *
+	 * @param other: The other array.
+	 */
+	SmallArray(SmallArray<Type, InlineCapacity, Allocator, GrowthPolicy>&& other) : SmallArray(static_cast<const Allocator&>(other))
+	{
+		takeFrom(other);
+	}
+
+	/**
+	 * Construct the array using an initializer list.
+	 *
+	 * @param list: The initializer list.
+	 */
+	SmallArray(std::initializer_list<Type> list) : SmallArray()
+	{
+		reserve(list.size());
+
+		for (const Type& value : list)
+			new (pNext++) Type(value);
+	}
+
+	/**
+	 * Default destructor.
+	 */
+	~SmallArray() { clear(); }
+
+public:
+	/**
+	 * Add an elements to the end of the array (copy).
+	 *
+	 * @param value: The value to be added.
+	 */
+	void pushBack(const Type& value)
+	{
+		emplaceBack(value);
+	}
+
+	/**
+	 * Add an elements to the end of the array (move).
+	 *
+	 * @param value: The value to be added.
+	 */
+	void pushBack(Type&& value)
+	{
+		emplaceBack(std::move(value));
+	}
+
+	/**
+	 * Construct an element in place at the end of the array.
+	 *
+	 * @param arguments: The arguments to be passed to the constructor of the element.
+	 * @return: The newly constructed element.
+	 */
+	template<class... Arguments>
+	Type& emplaceBack(Arguments&&... arguments)
+	{
+		// Check if the storage is full.
+		if (pNext == pEnd)
+		{
+			// The arguments might refer to an element in this array, so construct the element before reallocating.
+			Type value(std::forward<Arguments>(arguments)...);
+			reallocate(GrowthPolicy::Calculate(capacity(), size() + 1, 1));
+
+			new (pNext) Type(std::move(value));
+		}
+		else
+			new (pNext) Type(std::forward<Arguments>(arguments)...);
+
+		return *(pNext++);
+	}
+
+	/**
+	 * Pop the last element after returning the value of it.
+	 */
+	Type popBack()
+	{
+		pNext--;
+
+		// Move the value out before destroying the element.
+		Type retValue = std::move(*pNext);
+		pNext->~Type();
+
+		return retValue;
+	}
+
+	/**
+	 * Remove an element from the array using its index.
+	 *
+	 * @param index: The index of the element to be removed.
+	 */
+	void remove(long long index)
+	{
+		// Process the index.
+		if (index < 0)
+			index = size() + index;
+
+		// Destroy the element and move the proceeding elements back by one.
+		Type* pElement = pBegin + index;
+		pElement->~Type();
+
+		if constexpr (IsTriviallyRelocatable<Type>::value)
+			std::memmove(pElement, pElement + 1, (pNext - pElement - 1) * typeSize());
+		else
+		{
+			for (Type* pSource = pElement + 1; pSource != pNext; pSource++)
+			{
+				new (pSource - 1) Type(std::move(*pSource));
+				pSource->~Type();
+			}
+		}
+
+		pNext--;
+	}
+
+	/**
+	 * Reserve memory to store a number of elements.
+	 * This does nothing if the capacity is already large enough.
+	 *
+	 * @param count: The number of elements to reserve memory for.
+	 */
+	void reserve(size_t count)
+	{
+		if (count > capacity())
+			reallocate(count);
+	}
+
+	/**
+	 * Release the unused capacity of the array.
+	 * If the elements fit in the inline storage, the heap block is released.
+	 */
+	void shrinkToFit()
+	{
+		if (!isInline() && pNext != pEnd)
+			reallocate(size());
+	}
+
+	/**
+	 * Clear all the data in the array.
+	 * This returns the array to its inline storage.
+	 */
+	void clear()
+	{
+		// Destroy the stored elements.
+		if constexpr (!std::is_trivially_destructible_v<Type>)
+			for (Type* pElement = pBegin; pElement != pNext; pElement++)
+				pElement->~Type();
+
+		// Terminate the block if allocated on the heap.
+		if (!isInline())
+			Allocator::DestroyBlock(pBegin, typeSize() * capacity());
+
+		// Reset pointers.
+		pBegin = inlineBlock();
+		pNext = pBegin;
+		pEnd = pBegin + InlineCapacity;
+	}
+
+	/**
+	 * Get an element at a given index.
+	 * This method accepts negative indexes.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	Type& at(long long index)
+	{
+		// Process the index.
+		if (index < 0)
+			index = size() + index;
+
+		// Return the element.
+		return pBegin[index];
+	}
+
+	/**
+	 * Get an element at a given index.
+	 * This method accepts negative indexes.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	const Type at(long long index) const
+	{
+		// Process the index.
+		if (index < 0)
+			index = size() + index;
+
+		// Return the element
+		return pBegin[index];
+	}
+
+	/**
+	 * Find a certain value is present in the array.
+	 * If the array does not contain any data or if the value is not found, -1 is returned.
+	 */
+	size_t find(const Type& value) const
+	{
+		// Iterate through the array to find the required value.
+		for (size_t index = 0; index < size(); index++)
+			if (pBegin[index] == value)
+				return index;
+
+		// Return if not found.
+		return -1;
+	}
+
+public:
+	/**
+	 * Get the type size in bytes.
+	 */
+	constexpr size_t typeSize() const noexcept { return sizeof(Type); }
+
+	/**
+	 * Get the number of elements stored in the array.
+	 */
+	const size_t size() const noexcept { return pNext - pBegin; }
+
+	/**
+	 * Get the number of elements which can be stored in the array.
+	 */
+	const size_t capacity() const noexcept { return pEnd - pBegin; }
+
+	/**
+	 * Get the number of elements which can be stored without allocating memory.
+	 */
+	static constexpr size_t inlineCapacity() noexcept { return InlineCapacity; }
+
+	/**
+	 * Check if the elements are stored in the inline storage.
+	 */
+	bool isInline() const noexcept { return pBegin == inlineBlock(); }
+
+	/**
+	 * Begin iterator of the array.
+	 */
+	Type* begin() noexcept { return pBegin; }
+
+	/**
+	 * Begin iterator of the array.
+	 */
+	const Type* begin() const noexcept { return pBegin; }
+
+	/**
+	 * End iterator of the array.
+	 */
+	Type* end() noexcept { return pNext; }
+
+	/**
+	 * End iterator of the array.
+	 */
+	const Type* end() const noexcept { return pNext; }
+
+	/**
+	 * Get the front element of the array.
+	 */
+	Type& front() { return pBegin[0]; }
+
+	/**
+	 * Get the front element of the array.
+	 */
+	const Type front() const { return pBegin[0]; }
+
+	/**
+	 * Get the back element of the array.
+	 */
+	Type& back() { return *(pNext - 1); }
+
+	/**
+	 * Get the back element of the array.
+	 */
+	const Type back() const { return *(pNext - 1); }
+
+	/**
+	 * Check if an index is valid.
+	 */
+	bool isValidIndex(long long index) const { return index < 0 ? ((size() + index) < size()) : (static_cast<size_t>(index) < size()); }
+
+public:
+	/**
+	 * Index operator.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	Type& operator[](long long index)
+	{
+		return at(index);
+	}
+
+	/**
+	 * Index operator.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	const Type operator[](long long index) const
+	{
+		return at(index);
+	}
+
+	/**
+	 * Assignment operator (copy).
+	 *
+	 * @param other: The other array.
+	 */
+	SmallArray<Type, InlineCapacity, Allocator, GrowthPolicy>& operator=(const SmallArray<Type, InlineCapacity, Allocator, GrowthPolicy>& other)
+	{
+		// Check if we are assigning to ourselves.
+		if (this == &other)
+			return *this;
+
+		clear();
+		reserve(other.size());
+
+		for (const Type* pElement = other.pBegin; pElement != other.pNext; pElement++)
+			new (pNext++) Type(*pElement);
+
+		return *this;
+	}
+
+	/**
+	 * Assignment operator (move).
+	 *
+	 * @param other: The other array.
+	 */
+	SmallArray<Type, InlineCapacity, Allocator, GrowthPolicy>& operator=(SmallArray<Type, InlineCapacity, Allocator, GrowthPolicy>&& other)
+	{
+		// Check if we are assigning to ourselves.
+		if (this == &other)
+			return *this;
+
+		clear();
+
+		// Take the other array's allocator along with its memory.
+		static_cast<Allocator&>(*this) = static_cast<Allocator&>(other);
+		takeFrom(other);
+
+		return *this;
+	}
+
+	/**
+	 * Is equal operator.
+	 *
+	 * @param other: The other array.
+	 */
+	bool operator==(const SmallArray<Type, InlineCapacity, Allocator, GrowthPolicy>& other) const
+	{
+		// Check if the sizes match.
+		if (other.size() != size())
+			return false;
+
+		// Check if the elements match.
+		for (size_t index = 0; index < size(); index++)
+			if (pBegin[index] != other.pBegin[index])
+				return false;
+
+		return true;
+	}
+
+private:
+	/**
+	 * Get the address of the inline storage.
+	 */
+	Type* inlineBlock() const noexcept
+	{
+		return reinterpret_cast<Type*>(const_cast<unsigned char*>(mInlineStorage));
+	}
+
+	/**
+	 * Relocate a number of elements to uninitialized memory.
+	 * The source elements are destroyed after this. The two ranges must not overlap.
+	 *
+	 * @param pDst: The destination address.
+	 * @param pSrcBegin: The begin address of the source.
+	 * @param pSrcEnd: The end address of the source.
+	 */
+	void relocate(Type* pDst, Type* pSrcBegin, Type* pSrcEnd)
+	{
+		if constexpr (IsTriviallyRelocatable<Type>::value)
+		{
+			if (pSrcBegin != pSrcEnd)
+				std::memcpy(pDst, pSrcBegin, (pSrcEnd - pSrcBegin) * typeSize());
+		}
+		else
+		{
+			for (; pSrcBegin != pSrcEnd; pDst++, pSrcBegin++)
+			{
+				new (pDst) Type(std::move(*pSrcBegin));
+				pSrcBegin->~Type();
+			}
+		}
+	}
+
+	/**
+	 * Move the stored elements to a new block with a given capacity.
+	 * The elements are moved back to the inline storage if they fit in it.
+	 *
+	 * @param newCapacity: The capacity of the new block. This must not be less than the size.
+	 */
+	void reallocate(size_t newCapacity)
+	{
+		const size_t count = size();
+		Type* pBlock = nullptr;
+
+		// Go back to the inline storage if possible.
+		if (newCapacity <= InlineCapacity)
+		{
+			if (isInline())
+				return;
+
+			pBlock = inlineBlock();
+			newCapacity = InlineCapacity;
+		}
+		else
+			pBlock = Allocator::CreateNewBlock(typeSize() * newCapacity);
+
+		// Move existing data to the new block and release the old one.
+		relocate(pBlock, pBegin, pNext);
+
+		if (!isInline())
+			Allocator::DestroyBlock(pBegin, typeSize() * capacity());
+
+		// Assign pointers.
+		pBegin = pBlock;
+		pNext = pBegin + count;
+		pEnd = pBegin + newCapacity;
+	}
+
+	/**
+	 * Take the elements of another array.
+	 * This array must be empty and in its inline storage.
+	 *
+	 * @param other: The other array.
+	 */
+	void takeFrom(SmallArray<Type, InlineCapacity, Allocator, GrowthPolicy>& other)
+	{
+		if (other.isInline())
+		{
+			// The inline storage cannot be stolen, so move the elements.
+			relocate(pBegin, other.pBegin, other.pNext);
+			pNext = pBegin + other.size();
+		}
+		else
+		{
+			pBegin = other.pBegin;
+			pNext = other.pNext;
+			pEnd = other.pEnd;
+		}
+
+		// Reset the other array.
+		other.pBegin = other.inlineBlock();
+		other.pNext = other.pBegin;
+		other.pEnd = other.pBegin + InlineCapacity;
+	}
+
+private:
+	Type* pBegin = nullptr;		// Begin pointer of the array.
+	Type* pNext = nullptr;		// Next pointer of the array.
+	Type* pEnd = nullptr;		// End pointer of the array.
+
+	alignas(Type) unsigned char mInlineStorage[InlineCapacity * sizeof(Type)];	// Inline storage for the elements.
+};
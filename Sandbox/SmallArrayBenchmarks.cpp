@@ -0,0 +1,127 @@
+#include "SmallArray.h"
+
+#include <benchmark/benchmark.h>
+
+/**
+ * Array allocator which counts the number of blocks it creates.
+ *
+ * @tparam Type: The type of the alocation.
+ */
+template<class Type>
+class CountingArrayAllocator {
+public:
+	/**
+	 * Create a new memory block and increment the allocation count.
+	 *
+	 * @param byteSize: The size of the block in bytes.
+	 */
+	static Type* CreateNewBlock(size_t byteSize)
+	{
+		AllocationCount++;
+		return ArrayAllocator<Type, alignof(Type)>::CreateNewBlock(byteSize);
+	}
+
+	/**
+	 * Destroy an allocated block of memory.
+	 *
+	 * @param pBlock: The block to be deallocated.
+	 * @param byteSize: The size of the block in bytes.
+	 */
+	static void DestroyBlock(Type* pBlock, size_t byteSize)
+	{
+		ArrayAllocator<Type, alignof(Type)>::DestroyBlock(pBlock, byteSize);
+	}
+
+	static inline size_t AllocationCount = 0;	// The number of blocks created.
+};
+
+/**
+ * Fill a container with a number of elements and read them back.
+ * The number of heap allocations per container is reported as a counter.
+ */
+template<class Container>
+static void RunFillAndSum(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+	CountingArrayAllocator<int>::AllocationCount = 0;
+
+	for (auto _ : state)
+	{
+		Container container;
+		for (size_t index = 0; index < count; index++)
+			container.pushBack(static_cast<int>(index));
+
+		int sum = 0;
+		for (size_t index = 0; index < count; index++)
+			sum += container[index];
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(CountingArrayAllocator<int>::AllocationCount) / state.iterations());
+}
+
+/**
+ * Array for reference.
+ */
+static void BM_ArrayFill(benchmark::State& state)
+{
+	RunFillAndSum<Array<int, 1, CountingArrayAllocator<int>>>(state);
+}
+
+BENCHMARK(BM_ArrayFill)->DenseRange(1, 8)->Arg(16)->Arg(64);
+
+/**
+ * Small array with 8 inline elements.
+ */
+static void BM_SmallArrayFill(benchmark::State& state)
+{
+	RunFillAndSum<SmallArray<int, 8, CountingArrayAllocator<int>>>(state);
+}
+
+BENCHMARK(BM_SmallArrayFill)->DenseRange(1, 8)->Arg(16)->Arg(64);
+
+/**
+ * Create and destroy many small containers with a remove and a find on each.
+ */
+template<class Container>
+static void RunManySmall(benchmark::State& state)
+{
+	CountingArrayAllocator<int>::AllocationCount = 0;
+
+	for (auto _ : state)
+	{
+		for (int outer = 0; outer < 1024; outer++)
+		{
+			Container container;
+			for (int index = 0; index < 6; index++)
+				container.pushBack(outer + index);
+
+			container.remove(-2);
+			benchmark::DoNotOptimize(container.find(outer + 3));
+		}
+	}
+
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(CountingArrayAllocator<int>::AllocationCount) / state.iterations());
+	state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+/**
+ * Array for reference.
+ */
+static void BM_ArrayManySmall(benchmark::State& state)
+{
+	RunManySmall<Array<int, 1, CountingArrayAllocator<int>>>(state);
+}
+
+BENCHMARK(BM_ArrayManySmall);
+
+/**
+ * Small array with 8 inline elements.
+ */
+static void BM_SmallArrayManySmall(benchmark::State& state)
+{
+	RunManySmall<SmallArray<int, 8, CountingArrayAllocator<int>>>(state);
+}
+
+BENCHMARK(BM_SmallArrayManySmall);
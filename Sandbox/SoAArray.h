@@ -0,0 +1,487 @@
+#pragma once
+#include "Array.h"
+
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+/**
+ * Structure of arrays container.
+ * Every field is stored in its own column, so a loop which only reads a few fields only pulls those fields into the
+ * cache. The rows are accessed by index and every column is exposed as a span which can be fed to SIMD loops.
+ *
+ * The columns are allocated using the ArrayAllocator and aligned to at least ColumnAlignment bytes, so the first
+ * element of every column is suitable for aligned vector loads.
+ *
+ * @tparam Fields: The types of the columns.
+ */
+template<class... Fields>
+class SoAArray {
+	static_assert(sizeof...(Fields) > 0, "The structure of arrays must have at least one field!");
+
+public:
+	/**
+	 * The minimum alignment of the columns, in bytes. This covers the cache line and the widest vector register.
+	 */
+	static constexpr size_t ColumnAlignment = 64;
+
+	/**
+	 * Get the type of a field.
+	 *
+	 * @tparam Index: The index of the field.
+	 */
+	template<size_t Index>
+	using FieldType = std::tuple_element_t<Index, std::tuple<Fields...>>;
+
+	/**
+	 * Get the allocator of a column.
+	 *
+	 * @tparam Field: The field type.
+	 */
+	template<class Field>
+	using ColumnAllocator = ArrayAllocator<Field, (alignof(Field) > ColumnAlignment ? alignof(Field) : ColumnAlignment)>;
+
+public:
+	/**
+	 * Default constructor.
+	 */
+	SoAArray() {}
+
+	/**
+	 * Construct the array using another array (copy).
+	 *
+	 * @param other: The other array.
+	 */
+	SoAArray(const SoAArray<Fields...>& other)
+	{
+		if (!other.mSize)
+			return;
+
+		reallocate(other.mSize);
+		forEachColumn([&](auto index)
+			{
+				using Field = FieldType<decltype(index)::value>;
+				const Field* pSource = std::get<decltype(index)::value>(other.mColumns);
+				Field* pDestination = std::get<decltype(index)::value>(mColumns);
+
+				for (size_t row = 0; row < other.mSize; row++)
+					new (pDestination + row) Field(pSource[row]);
+			});
+
+		mSize = other.mSize;
+	}
+
+	/**
+	 * Construct the array using another array (move).
+	 *
+	 * @param other: The other array.
+	 */
+	SoAArray(SoAArray<Fields...>&& other) noexcept
+		: mColumns(std::exchange(other.mColumns, std::tuple<Fields*...>())),
+		mSize(std::exchange(other.mSize, 0)),
+		mCapacity(std::exchange(other.mCapacity, 0)) {}
+
+	/**
+	 * Default destructor.
+	 */
+	~SoAArray() { clear(); }
+
+	/**
+	 * Add a row to the end of the array.
+	 *
+	 * @param values: The values of the fields.
+	 */
+	void pushBack(const Fields&... values)
+	{
+		// The values might live in this array, so copy them before reallocating.
+		if (mSize == mCapacity)
+		{
+			std::tuple<Fields...> row(values...);
+			reallocate(getNewCapacity(1));
+			constructRow(mSize, std::move(row), std::index_sequence_for<Fields...>());
+		}
+		else
+			constructRow(mSize, std::forward_as_tuple(values...), std::index_sequence_for<Fields...>());
+
+		mSize++;
+	}
+
+	/**
+	 * Add a row to the end of the array.
+	 *
+	 * @param values: The values of the fields.
+	 */
+	void pushBack(Fields&&... values)
+	{
+		if (mSize == mCapacity)
+		{
+			std::tuple<Fields...> row(std::move(values)...);
+			reallocate(getNewCapacity(1));
+			constructRow(mSize, std::move(row), std::index_sequence_for<Fields...>());
+		}
+		else
+			constructRow(mSize, std::forward_as_tuple(std::move(values)...), std::index_sequence_for<Fields...>());
+
+		mSize++;
+	}
+
+	/**
+	 * Remove the last row.
+	 */
+	void popBack()
+	{
+		mSize--;
+		forEachColumn([&](auto index) { destroyElement(std::get<decltype(index)::value>(mColumns) + mSize); });
+	}
+
+	/**
+	 * Remove a row and shift the rows after it, keeping the order.
+	 *
+	 * @param index: The index of the row. Negative indexes count from the back.
+	 */
+	void remove(long long index)
+	{
+		const size_t row = resolveIndex(index);
+		forEachColumn([&](auto column)
+			{
+				auto pColumn = std::get<decltype(column)::value>(mColumns);
+				std::move(pColumn + row + 1, pColumn + mSize, pColumn + row);
+				destroyElement(pColumn + mSize - 1);
+			});
+
+		mSize--;
+	}
+
+	/**
+	 * Remove a row by moving the last row into its place. This is O(1) but does not keep the order.
+	 *
+	 * @param index: The index of the row. Negative indexes count from the back.
+	 */
+	void swapRemove(long long index)
+	{
+		const size_t row = resolveIndex(index);
+		forEachColumn([&](auto column)
+			{
+				auto pColumn = std::get<decltype(column)::value>(mColumns);
+				if (row != mSize - 1)
+					pColumn[row] = std::move(pColumn[mSize - 1]);
+
+				destroyElement(pColumn + mSize - 1);
+			});
+
+		mSize--;
+	}
+
+	/**
+	 * Make sure that the array can hold a number of rows without reallocating.
+	 *
+	 * @param count: The number of rows.
+	 */
+	void reserve(size_t count)
+	{
+		if (count > mCapacity)
+			reallocate(count);
+	}
+
+	/**
+	 * Release the unused capacity.
+	 */
+	void shrinkToFit()
+	{
+		if (mSize == mCapacity)
+			return;
+
+		if (mSize)
+			reallocate(mSize);
+		else
+			clear();
+	}
+
+	/**
+	 * Destroy all the rows and release the memory.
+	 */
+	void clear()
+	{
+		forEachColumn([&](auto index)
+			{
+				using Field = FieldType<decltype(index)::value>;
+				Field*& pColumn = std::get<decltype(index)::value>(mColumns);
+
+				for (size_t row = 0; row < mSize; row++)
+					destroyElement(pColumn + row);
+
+				if (pColumn)
+					ColumnAllocator<Field>::DestroyBlock(pColumn, sizeof(Field) * mCapacity);
+
+				pColumn = nullptr;
+			});
+
+		mSize = 0;
+		mCapacity = 0;
+	}
+
+	/**
+	 * Access a field of a row.
+	 *
+	 * @tparam Field: The index of the field.
+	 * @param index: The index of the row. Negative indexes count from the back.
+	 */
+	template<size_t Field>
+	FieldType<Field>& at(long long index) { return std::get<Field>(mColumns)[resolveIndex(index)]; }
+
+	/**
+	 * Access a field of a row.
+	 *
+	 * @tparam Field: The index of the field.
+	 * @param index: The index of the row. Negative indexes count from the back.
+	 */
+	template<size_t Field>
+	const FieldType<Field>& at(long long index) const { return std::get<Field>(mColumns)[resolveIndex(index)]; }
+
+	/**
+	 * Get a column as a span.
+	 *
+	 * @tparam Field: The index of the field.
+	 */
+	template<size_t Field>
+	std::span<FieldType<Field>> column() noexcept { return { std::get<Field>(mColumns), mSize }; }
+
+	/**
+	 * Get a column as a span.
+	 *
+	 * @tparam Field: The index of the field.
+	 */
+	template<size_t Field>
+	std::span<const FieldType<Field>> column() const noexcept { return { std::get<Field>(mColumns), mSize }; }
+
+public:
+	/**
+	 * Get the number of fields (columns).
+	 */
+	static constexpr size_t fieldCount() noexcept { return sizeof...(Fields); }
+
+	/**
+	 * Get the number of rows.
+	 */
+	size_t size() const noexcept { return mSize; }
+
+	/**
+	 * Get the number of rows which can be stored without reallocating.
+	 */
+	size_t capacity() const noexcept { return mCapacity; }
+
+	/**
+	 * Check if the array is empty.
+	 */
+	bool empty() const noexcept { return mSize == 0; }
+
+public:
+	/**
+	 * Assignment operator (copy).
+	 *
+	 * @param other: The other array.
+	 */
+	SoAArray<Fields...>& operator=(const SoAArray<Fields...>& other)
+	{
+		if (this != &other)
+		{
+			SoAArray<Fields...> copy(other);
+			*this = std::move(copy);
+		}
+
+		return *this;
+	}
+
+	/**
+	 * Assignment operator (move).
+	 *
+	 * @param other: The other array.
+	 */
+	SoAArray<Fields...>& operator=(SoAArray<Fields...>&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			mColumns = std::exchange(other.mColumns, std::tuple<Fields*...>());
+			mSize = std::exchange(other.mSize, 0);
+			mCapacity = std::exchange(other.mCapacity, 0);
+		}
+
+		return *this;
+	}
+
+private:
+	/**
+	 * Call a function for every column with the column index as an std::integral_constant.
+	 *
+	 * @param function: The function to be called.
+	 */
+	template<class Function>
+	void forEachColumn(Function&& function)
+	{
+		forEachColumn(function, std::index_sequence_for<Fields...>());
+	}
+
+	/**
+	 * Call a function for every column with the column index as an std::integral_constant.
+	 *
+	 * @param function: The function to be called.
+	 */
+	template<class Function, size_t... Indices>
+	void forEachColumn(Function& function, std::index_sequence<Indices...>)
+	{
+		(function(std::integral_constant<size_t, Indices>()), ...);
+	}
+
+	/**
+	 * Construct a row in place from a tuple of values.
+	 *
+	 * @param row: The index of the row.
+	 * @param values: The values of the fields.
+	 */
+	template<class Tuple, size_t... Indices>
+	void constructRow(size_t row, Tuple&& values, std::index_sequence<Indices...>)
+	{
+		size_t constructedCount = 0;
+		try
+		{
+			((new (std::get<Indices>(mColumns) + row) FieldType<Indices>(std::get<Indices>(std::forward<Tuple>(values))), constructedCount++), ...);
+		}
+		catch (...)
+		{
+			// Destroy the fields which were constructed before the exception.
+			((Indices < constructedCount ? destroyElement(std::get<Indices>(mColumns) + row) : void()), ...);
+			throw;
+		}
+	}
+
+	/**
+	 * Destroy a single element.
+	 *
+	 * @param pElement: The element to be destroyed.
+	 */
+	template<class Field>
+	static void destroyElement(Field* pElement)
+	{
+		if constexpr (!std::is_trivially_destructible_v<Field>)
+			pElement->~Field();
+	}
+
+	/**
+	 * Convert a possibly negative index to a row index.
+	 *
+	 * @param index: The index.
+	 */
+	size_t resolveIndex(long long index) const noexcept
+	{
+		return index < 0 ? mSize + index : static_cast<size_t>(index);
+	}
+
+	/**
+	 * Get the capacity needed to add a number of rows.
+	 *
+	 * @param newRowCount: The number of rows to be added.
+	 */
+	size_t getNewCapacity(size_t newRowCount) const
+	{
+		return GrowthPolicy1_5x::Calculate(mCapacity, mSize + newRowCount, 1);
+	}
+
+	/**
+	 * Move all the columns to new blocks.
+	 * Every block is allocated, and the columns which may throw while being moved are copied, before any element is
+	 * moved. The array is left unchanged if an exception is thrown.
+	 *
+	 * @param newCapacity: The new capacity. This must not be less than the size.
+	 */
+	void reallocate(size_t newCapacity)
+	{
+		std::tuple<Fields*...> newColumns = {};
+		size_t constructedCounts[sizeof...(Fields)] = {};
+
+		try
+		{
+			forEachColumn([&](auto index)
+				{
+					using Field = FieldType<decltype(index)::value>;
+					std::get<decltype(index)::value>(newColumns) = ColumnAllocator<Field>::CreateNewBlock(sizeof(Field) * newCapacity);
+				});
+
+			forEachColumn([&](auto index)
+				{
+					using Field = FieldType<decltype(index)::value>;
+					if constexpr (!IsNothrowRelocatable<Field>())
+					{
+						Field* pColumn = std::get<decltype(index)::value>(mColumns);
+						Field* pNewColumn = std::get<decltype(index)::value>(newColumns);
+
+						for (size_t& row = constructedCounts[index]; row < mSize; row++)
+							new (pNewColumn + row) Field(std::move_if_noexcept(pColumn[row]));
+					}
+				});
+		}
+		catch (...)
+		{
+			forEachColumn([&](auto index)
+				{
+					using Field = FieldType<decltype(index)::value>;
+					Field* pNewColumn = std::get<decltype(index)::value>(newColumns);
+
+					if (pNewColumn)
+					{
+						for (size_t row = 0; row < constructedCounts[index]; row++)
+							destroyElement(pNewColumn + row);
+
+						ColumnAllocator<Field>::DestroyBlock(pNewColumn, sizeof(Field) * newCapacity);
+					}
+				});
+
+			throw;
+		}
+
+		// Nothing throws from here on.
+		forEachColumn([&](auto index)
+			{
+				using Field = FieldType<decltype(index)::value>;
+				Field*& pColumn = std::get<decltype(index)::value>(mColumns);
+				Field* pNewColumn = std::get<decltype(index)::value>(newColumns);
+
+				if (pColumn)
+				{
+					// Relocate the elements, unless they were copied above.
+					if constexpr (IsTriviallyRelocatable<Field>::value)
+						std::memcpy(static_cast<void*>(pNewColumn), pColumn, sizeof(Field) * mSize);
+					else
+					{
+						for (size_t row = 0; row < mSize; row++)
+						{
+							if constexpr (IsNothrowRelocatable<Field>())
+								new (pNewColumn + row) Field(std::move(pColumn[row]));
+
+							destroyElement(pColumn + row);
+						}
+					}
+
+					ColumnAllocator<Field>::DestroyBlock(pColumn, sizeof(Field) * mCapacity);
+				}
+
+				pColumn = pNewColumn;
+			});
+
+		mCapacity = newCapacity;
+	}
+
+	/**
+	 * Check whether the elements of a field can be moved to a new block without throwing.
+	 */
+	template<class Field>
+	static constexpr bool IsNothrowRelocatable()
+	{
+		return IsTriviallyRelocatable<Field>::value || std::is_nothrow_move_constructible_v<Field>;
+	}
+
+private:
+	std::tuple<Fields*...> mColumns = {};
+	size_t mSize = 0;
+	size_t mCapacity = 0;
+};
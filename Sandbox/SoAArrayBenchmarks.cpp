@@ -0,0 +1,126 @@
+#include "SoAArray.h"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+/**
+ * Particle stored as a structure. Only the position and velocity are used by the integration, the rest is the kind
+ * of data which usually sits next to them.
+ */
+struct Particle {
+	float positionX, positionY, positionZ;
+	float velocityX, velocityY, velocityZ;
+	float colorR, colorG, colorB, colorA;
+	float mass, lifetime, age, size;
+	uint32_t textureIndex, flags;
+};
+
+/**
+ * Particles stored as a structure of arrays with the same fields.
+ */
+using ParticleColumns = SoAArray<
+	float, float, float,
+	float, float, float,
+	float, float, float, float,
+	float, float, float, float,
+	uint32_t, uint32_t>;
+
+constexpr float IntegrationStep = 1.0f / 60.0f;
+
+/**
+ * Integrate the positions of particles stored in an array of structures.
+ */
+static void BM_IntegrateAoS(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	Array<Particle> particles;
+	particles.reserve(count);
+	for (size_t index = 0; index < count; index++)
+	{
+		const float value = static_cast<float>(index);
+		particles.pushBack({ value, value, value, 1.0f, 2.0f, 3.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 10.0f, 0.0f, 1.0f, 0, 0 });
+	}
+
+	for (auto _ : state)
+	{
+		for (Particle& particle : particles)
+		{
+			particle.positionX += particle.velocityX * IntegrationStep;
+			particle.positionY += particle.velocityY * IntegrationStep;
+			particle.positionZ += particle.velocityZ * IntegrationStep;
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_IntegrateAoS)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+
+/**
+ * Integrate the positions of particles stored in a structure of arrays.
+ */
+static void BM_IntegrateSoA(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	ParticleColumns particles;
+	particles.reserve(count);
+	for (size_t index = 0; index < count; index++)
+	{
+		const float value = static_cast<float>(index);
+		particles.pushBack(value, value, value, 1.0f, 2.0f, 3.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 10.0f, 0.0f, 1.0f, 0, 0);
+	}
+
+	for (auto _ : state)
+	{
+		// The columns never overlap, which lets the compiler vectorize without runtime alias checks.
+		const auto integrate = [](std::span<float> positions, std::span<const float> velocities)
+		{
+			float* __restrict pPositions = positions.data();
+			const float* __restrict pVelocities = velocities.data();
+
+			for (size_t index = 0; index < positions.size(); index++)
+				pPositions[index] += pVelocities[index] * IntegrationStep;
+		};
+
+		integrate(particles.column<0>(), particles.column<3>());
+		integrate(particles.column<1>(), particles.column<4>());
+		integrate(particles.column<2>(), particles.column<5>());
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_IntegrateSoA)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+
+/**
+ * Remove rows from the middle using swap-remove.
+ */
+static void BM_SoAArraySwapRemove(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		ParticleColumns particles;
+		particles.reserve(count);
+		for (size_t index = 0; index < count; index++)
+			particles.pushBack(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0, static_cast<uint32_t>(index));
+		state.ResumeTiming();
+
+		while (particles.size() > 1)
+			particles.swapRemove(particles.size() / 2);
+
+		benchmark::DoNotOptimize(particles.at<15>(0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_SoAArraySwapRemove)->Arg(1 << 16);
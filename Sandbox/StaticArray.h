@@ -1,74 +1,71 @@
 #pragma once
-#include <initializer_list>
-#include <memory>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
 
 /**
  * Static array object.
  * This object can be used to store data in a static array.
+ *
+ * The static array is an aggregate, so it is initialized using braces (StaticArray<int, 3> array = { 1, 2, 3 };) and
+ * the elements which are not listed are value initialized. Copying and moving is done element wise by the compiler,
+ * so the array is trivially copyable (and can be kept in registers) whenever the Type is, and every member can be
+ * used in constant expressions.
+ *
+ * @tparam Type: The element type.
+ * @tparam ArrayCount: The number of elements.
  */
 template<class Type, size_t ArrayCount>
 class StaticArray {
+	static_assert(ArrayCount > 0, "The static array must contain at least one element!");
+
 public:
 	/**
-	 * Default consructor.
+	 * Get the size of the array.
 	 */
-	StaticArray() {}
+	constexpr size_t size() const { return ArrayCount; }
 
 	/**
-	 * Construct the static array using an initializer list.
+	 * Get the size of the Type in bytes.
 	 */
-	StaticArray(std::initializer_list<Type> list)
-	{
-		// Check if the list size is compatible.
-		if ((list.size() > ArrayCount) || !list.size())
-			return;
+	constexpr size_t typeSize() const { return sizeof(Type); }
 
-		// Copy the data from the list to the static array.
-		std::memcpy(sArray, list.begin(), list.size() * typeSize());
-	}
+	/**
+	 * Get the pointer to the first element.
+	 */
+	constexpr Type* data() { return sArray; }
 
 	/**
-	 * Cronstruct the class using another array (copy).
-	 * 
-	 * @param other: The other static array to copy data from.
+	 * Get the pointer to the first element.
 	 */
-	StaticArray(const StaticArray<Type, ArrayCount>& other)
-	{
-		std::memcpy(sArray, other.sArray, ArrayCount * typeSize());
-	}
+	constexpr const Type* data() const { return sArray; }
 
 	/**
-	 * Cronstruct the class using another array (move).
-	 *
-	 * @param other: The other static array to copy data from.
+	 * Begin iterator of the array.
 	 */
-	StaticArray(StaticArray<Type, ArrayCount>&& other)
-	{
-		std::memmove(sArray, other.sArray, ArrayCount * typeSize());
-		std::memset(other.sArray, Type(), ArrayCount * typeSize());
-	}
+	constexpr Type* begin() { return sArray; }
 
 	/**
-	 * Default destructor.
+	 * Begin iterator of the array.
 	 */
-	~StaticArray() {}
+	constexpr const Type* begin() const { return sArray; }
 
 	/**
-	 * Get the size of the array.
+	 * End iterator of the array.
 	 */
-	constexpr size_t size() const { return ArrayCount; }
+	constexpr Type* end() { return sArray + ArrayCount; }
 
 	/**
-	 * Get the size of the Type in bytes.
+	 * End iterator of the array.
 	 */
-	constexpr size_t typeSize() const { return sizeof(Type); }
+	constexpr const Type* end() const { return sArray + ArrayCount; }
 
 	/**
 	 * Access a given element using the index.
 	 *
 	 * @param index: The index of the element.
 	 */
-	Type& at(long long index)
+	constexpr Type& at(long long index)
 	{
 		// Process the index.
 		if (index < 0)
@@ -82,7 +79,7 @@ public:
 	 *
 	 * @param index: The index of the element.
 	 */
-	const Type at(long long index) const
+	constexpr const Type& at(long long index) const
 	{
 		// Process the index.
 		if (index < 0)
@@ -91,13 +88,24 @@ public:
 		return sArray[index];
 	}
 
+	/**
+	 * Set all the elements to a value.
+	 *
+	 * @param value: The value to be set.
+	 */
+	constexpr void fill(const Type& value)
+	{
+		for (size_t itr = 0; itr < ArrayCount; itr++)
+			sArray[itr] = value;
+	}
+
 public:
 	/**
 	 * Index operator.
 	 *
 	 * @param index: The index to be accessed.
 	 */
-	Type& operator[](long long index)
+	constexpr Type& operator[](long long index)
 	{
 		return at(index);
 	}
@@ -107,7 +115,7 @@ public:
 	 *
 	 * @param index: The index to be accessed.
 	 */
-	const Type operator[](long long index) const
+	constexpr const Type& operator[](long long index) const
 	{
 		return at(index);
 	}
@@ -117,37 +125,57 @@ public:
 	 *
 	 * @param other: The other static array.
 	 */
-	bool operator==(const StaticArray<Type, ArrayCount>& other)
+	constexpr bool operator==(const StaticArray<Type, ArrayCount>& other) const
 	{
-		// Iterate through the array and check if the elements are equal.
-		for (size_t itr = 0; itr < ArrayCount; itr++)
-			if (sArray[itr] != other[itr])
-				return false;
-
-		return true;
+		// std::equal is constexpr and turns into a memcmp for trivially comparable types.
+		return std::equal(sArray, sArray + ArrayCount, other.sArray);
 	}
 
 	/**
-	 * Assignment operator (copy).
-	 * 
+	 * Is not equal to operator.
+	 *
 	 * @param other: The other static array.
 	 */
-	StaticArray<Type, ArrayCount>& operator=(const StaticArray<Type, ArrayCount>& other)
+	constexpr bool operator!=(const StaticArray<Type, ArrayCount>& other) const
 	{
-		std::memcpy(sArray, other.sArray, ArrayCount * typeSize());
+		return !(*this == other);
 	}
 
+public:
+	// Static array store. This is public so that the array stays an aggregate; use the accessors instead.
+	Type sArray[ArrayCount] = {};
+};
+
+/**
+ * Compile time checks of the static array.
+ */
+namespace StaticArrayChecks {
+	constexpr StaticArray<int, 4> Values = { 1, 2, 3, 4 };
+	constexpr StaticArray<int, 4> Padded = { 1, 2 };
+
 	/**
-	 * Assignment operator (move).
-	 *
-	 * @param other: The other static array.
+	 * Copy an array, modify the copy and sum it, all at compile time.
 	 */
-	StaticArray<Type, ArrayCount>& operator=(StaticArray<Type, ArrayCount>&& other)
+	constexpr int ModifiedSum()
 	{
-		std::memmove(sArray, other.sArray, ArrayCount * typeSize());
-		std::memset(other.sArray, Type(), ArrayCount * typeSize());
+		StaticArray<int, 4> copy = Values;
+		copy[-1] = 10;
+		copy.fill(copy[0] + copy[-1]);
+
+		int sum = 0;
+		for (const int value : copy)
+			sum += value;
+
+		return sum;
 	}
 
-private:
-	Type sArray[ArrayCount] = { Type() };	// Static array store.
-};
+	static_assert(std::is_aggregate_v<StaticArray<int, 4>>, "StaticArray must be an aggregate!");
+	static_assert(std::is_trivially_copyable_v<StaticArray<int, 4>>, "StaticArray of a trivial type must be trivially copyable!");
+	static_assert(std::is_trivially_destructible_v<StaticArray<float, 16>>, "StaticArray of a trivial type must be trivially destructible!");
+	static_assert(sizeof(StaticArray<int, 4>) == sizeof(int) * 4, "StaticArray must not add any storage!");
+
+	static_assert(Values.size() == 4 && Values[0] == 1 && Values[-1] == 4, "Indexing failed!");
+	static_assert(Padded[1] == 2 && Padded[2] == 0 && Padded[3] == 0, "Missing elements must be value initialized!");
+	static_assert(Values != Padded && Values == StaticArray<int, 4>{ 1, 2, 3, 4 }, "Comparison failed!");
+	static_assert(ModifiedSum() == 44, "Constexpr modification failed!");
+}
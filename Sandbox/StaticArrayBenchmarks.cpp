@@ -0,0 +1,109 @@
+#include "StaticArray.h"
+
+#include <array>
+#include <benchmark/benchmark.h>
+
+/**
+ * Dot product of two small vectors, passed by value.
+ * This is not inlined so that the cost of passing the arrays is measured.
+ */
+template<class Vector>
+static __declspec(noinline) float Dot(Vector first, Vector second)
+{
+	float result = 0.0f;
+	for (size_t index = 0; index < 4; index++)
+		result += first[index] * second[index];
+
+	return result;
+}
+
+/**
+ * Pass small arrays by value.
+ */
+template<class Vector>
+static void BM_StaticArrayPassByValue(benchmark::State& state)
+{
+	Vector first = { 1.0f, 2.0f, 3.0f, 4.0f };
+	Vector second = { 4.0f, 3.0f, 2.0f, 1.0f };
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(first);
+		benchmark::DoNotOptimize(Dot(first, second));
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_StaticArrayPassByValue, StaticArray<float, 4>);
+BENCHMARK_TEMPLATE(BM_StaticArrayPassByValue, std::array<float, 4>);
+
+/**
+ * Copy an array and modify the copy.
+ */
+template<class Container>
+static void BM_StaticArrayCopy(benchmark::State& state)
+{
+	Container source = {};
+	for (size_t index = 0; index < source.size(); index++)
+		source[index] = static_cast<int>(index);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(source);
+
+		Container copy = source;
+		copy[0]++;
+		benchmark::DoNotOptimize(copy);
+	}
+
+	state.SetBytesProcessed(state.iterations() * sizeof(Container));
+}
+
+BENCHMARK_TEMPLATE(BM_StaticArrayCopy, StaticArray<int, 16>);
+BENCHMARK_TEMPLATE(BM_StaticArrayCopy, std::array<int, 16>);
+BENCHMARK_TEMPLATE(BM_StaticArrayCopy, StaticArray<int, 1024>);
+BENCHMARK_TEMPLATE(BM_StaticArrayCopy, std::array<int, 1024>);
+
+/**
+ * Sum an array which only lives in a local variable. With a trivially copyable array the compiler keeps the
+ * elements in registers and folds the loop.
+ */
+template<class Container>
+static void BM_StaticArrayLocalSum(benchmark::State& state)
+{
+	int seed = 1;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(seed);
+
+		Container values = { seed, seed + 1, seed + 2, seed + 3, seed + 4, seed + 5, seed + 6, seed + 7 };
+		int sum = 0;
+		for (size_t index = 0; index < values.size(); index++)
+			sum += values[index];
+
+		benchmark::DoNotOptimize(sum);
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_StaticArrayLocalSum, StaticArray<int, 8>);
+BENCHMARK_TEMPLATE(BM_StaticArrayLocalSum, std::array<int, 8>);
+
+/**
+ * Compare two equal arrays.
+ */
+template<class Container>
+static void BM_StaticArrayCompare(benchmark::State& state)
+{
+	Container first = {};
+	for (size_t index = 0; index < first.size(); index++)
+		first[index] = static_cast<int>(index);
+
+	Container second = first;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(first);
+		benchmark::DoNotOptimize(first == second);
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_StaticArrayCompare, StaticArray<int, 64>);
+BENCHMARK_TEMPLATE(BM_StaticArrayCompare, std::array<int, 64>);
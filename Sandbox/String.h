@@ -1,5 +1,10 @@
 #pragma once
+#include <atomic>
 #include <string>
+#include <cstring>
+#include <utility>
+#include "MemoryResource.h"
+#include "StringView.h"
 
 #ifdef USE_WCHAR
 	#define TEXT(text)	L##text
@@ -15,6 +20,12 @@
  *
  * This object is not intended to be used as a direct substitute of the std::string/ std::wstring. This is a small implementation
  * targeted for educational purposes.
+ *
+ * The memory is allocated using a memory resource, which is the default memory resource unless another is provided.
+ *
+ * Defining STRING_CACHE_HASH stores the hash inside the string once it is calculated, which helps strings which are
+ * used as keys and looked up repeatedly. The cache is reset by every method which can modify the characters. It is
+ * atomic, so a const string can still be hashed from several threads at once.
  */
 class String {
 public:
@@ -31,18 +42,28 @@ public:
 	// String standard type.
 	using TypeSTD = std::basic_string<Type, std::char_traits<Type>, std::allocator<Type>>;
 
+	// String view type.
+	using View = BasicStringView<Type>;
+
 public:
 	/**
 	 * Default constructor.
 	 */
 	String() noexcept : string(nullptr), length(0) {}
 
+	/**
+	 * Construct the string using a memory resource.
+	 *
+	 * @param pResource: The memory resource to allocate memory from.
+	 */
+	explicit String(MemoryResource* pResource) noexcept : string(nullptr), length(0), pResource(pResource) {}
+
 	/**
 	 * Construct the string by allocating the size and keeping it.
 	 *
 	 * @param length: The length to be allocated to.
 	 */
-	String(size_t length) : string(nullptr), length(length)
+	String(size_t length) : string(nullptr), length(length), allocatedLength(length)
 	{
 		string = CreateNewBlock(this->length + 1);
 	}
@@ -52,10 +73,19 @@ public:
 	 *
 	 * @param pString: The primitive string.
 	 */
-	String(const Type* pString) : string(nullptr), length(0)
+	String(const Type* pString) : String(pString, GetDefaultMemoryResource()) {}
+
+	/**
+	 * Construct the string object using a primitive string and a memory resource.
+	 *
+	 * @param pString: The primitive string.
+	 * @param pResource: The memory resource to allocate memory from.
+	 */
+	String(const Type* pString, MemoryResource* pResource) : string(nullptr), length(0), pResource(pResource)
 	{
 		// Set the length of the string.
 		length = GetStrLength(pString);
+		allocatedLength = length;
 
 		// Allocate a new block in memory.
 		string = CreateNewBlock(length + 1);
@@ -64,18 +94,45 @@ public:
 		std::memcpy(string, pString, length * typeSize());
 	}
 
+	/**
+	 * Construct the string object using a number of characters from a primitive string.
+	 * The characters do not need to be null terminated.
+	 *
+	 * @param pString: The primitive string.
+	 * @param length: The number of characters to copy.
+	 * @param pResource: The memory resource to allocate memory from.
+	 */
+	String(const Type* pString, size_t length, MemoryResource* pResource = GetDefaultMemoryResource())
+		: string(nullptr), length(length), allocatedLength(length), pResource(pResource)
+	{
+		// Allocate a new block in memory.
+		string = CreateNewBlock(length + 1);
+
+		// Copy the characters to the newly allocated memory block.
+		std::memcpy(string, pString, length * typeSize());
+	}
+
+	/**
+	 * Construct the string object by copying the characters of a view.
+	 *
+	 * @param view: The view.
+	 * @param pResource: The memory resource to allocate memory from.
+	 */
+	explicit String(View view, MemoryResource* pResource = GetDefaultMemoryResource()) : String(view.data(), view.size(), pResource) {}
+
 	/**
 	 * The copy constructor.
 	 *
 	 * @param str: The other string.
 	 */
-	String(const String& str) : string(nullptr), length(str.length)
+	String(const String& str) : string(nullptr), length(str.length), pResource(str.pResource)
 	{
 		// Return if the other string is empty.
 		if (!str.length || !str.string)
 			return;
 
 		// Allocate a new block in memory.
+		allocatedLength = length;
 		string = CreateNewBlock(length + 1);
 
 		// Copy the primitive string to the newly allocated memory block.
@@ -87,10 +144,16 @@ public:
 	 *
 	 * @param str: The other string.
 	 */
-	String(String&& str) noexcept : string(str.string), length(str.length)
+	String(String&& str) noexcept : string(str.string), length(str.length), allocatedLength(str.allocatedLength), pResource(str.pResource)
 	{
 		str.string = nullptr;
 		str.length = 0;
+		str.allocatedLength = 0;
+
+#ifdef STRING_CACHE_HASH
+		cachedHash.store(str.cachedHash.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+#endif // STRING_CACHE_HASH
 	}
 
 	/**
@@ -105,6 +168,7 @@ public:
 			return;
 
 		// Allocate a new block in memory.
+		allocatedLength = length;
 		string = CreateNewBlock(length + 1);
 
 		// Copy the primitive string to the newly allocated memory block.
@@ -126,6 +190,11 @@ public:
 	 */
 	const Type* str() const { return static_cast<const Type*>(this->string); }
 
+	/**
+	 * Get a view of the characters.
+	 */
+	View view() const noexcept { return View(string, length); }
+
 	/**
 	 * Get the length of a primitive string.
 	 *
@@ -137,14 +206,9 @@ public:
 		if (!pString)
 			return 0;
 
-		size_t count = 0;
-		Type* pBegining = const_cast<Type*>(pString);
-
 		// Count the number of characters till '\0' character. This is the null termination character and represents
 		// the end of the string.
-		while (*pBegining != '\0') count++, pBegining++;
-
-		return count;
+		return StringKernels::Length(pString);
 	}
 
 	/**
@@ -157,17 +221,54 @@ public:
 	 */
 	__forceinline size_t size() const { return length; }
 
+	/**
+	 * Get the number of characters which can be stored without reallocating.
+	 */
+	__forceinline size_t capacity() const { return allocatedLength; }
+
+	/**
+	 * Get the memory resource used by the string.
+	 */
+	MemoryResource* getMemoryResource() const noexcept { return pResource; }
+
 	/**
 	 * Clear all the values of the string.
 	 */
 	void clear()
 	{
 		if (string)
-			delete[] string;
+			DestroyBlock(string, allocatedLength + 1);
 
 		// Set all the data so default.
 		string = nullptr;
 		length = 0;
+		allocatedLength = 0;
+		invalidateHash();
+	}
+
+	/**
+	 * Make sure that a number of characters can be stored without reallocating.
+	 *
+	 * @param count: The number of characters (excluding '\0').
+	 */
+	void reserve(size_t count)
+	{
+		if (count > allocatedLength)
+			reallocate(count);
+	}
+
+	/**
+	 * Release the unused capacity.
+	 */
+	void shrinkToFit()
+	{
+		if (length == allocatedLength)
+			return;
+
+		if (length)
+			reallocate(length);
+		else
+			clear();
 	}
 
 	/**
@@ -175,13 +276,22 @@ public:
 	 */
 	TypeSTD toStandard() const
 	{
-		return TypeSTD(string);
+		return TypeSTD(string, length);
 	}
 
 	/**
 	 * Begin iterator method.
 	 */
-	Type* begin() const
+	Type* begin()
+	{
+		invalidateHash();
+		return string;
+	}
+
+	/**
+	 * Begin iterator method.
+	 */
+	const Type* begin() const
 	{
 		return string;
 	}
@@ -189,9 +299,18 @@ public:
 	/**
 	 * The end iterator method.
 	 */
-	Type* end() const
+	Type* end()
 	{
-		return reinterpret_cast<Type*>(reinterpret_cast<size_t>(string) + (length * typeSize()));
+		invalidateHash();
+		return string + length;
+	}
+
+	/**
+	 * The end iterator method.
+	 */
+	const Type* end() const
+	{
+		return string + length;
 	}
 
 	/**
@@ -206,7 +325,9 @@ public:
 		clear();
 
 		// Create the new block and assign values.
+		invalidateHash();
 		this->length = length;
+		allocatedLength = length;
 		string = CreateNewBlock(this->length + 1);
 	}
 
@@ -217,21 +338,72 @@ public:
 	 */
 	void append(Type character)
 	{
-		length++;
+		invalidateHash();
 
-		// Create a new memory block.
-		Type* newBlock = CreateNewBlock(length + 1);
+		// Grow the allocation geometrically so that appending is amortized O(1).
+		if (length == allocatedLength)
+			reallocate(getNewCapacity(length + 1));
 
-		// If the string has data, move them to the new block and delete the old allocation.
-		if (string)
+		string[length++] = character;
+		string[length] = 0;
+	}
+
+	/**
+	 * Append a number of characters to the string.
+	 * The characters may be a part of this string.
+	 *
+	 * @param pString: The characters to be appended.
+	 * @param count: The number of characters.
+	 */
+	void append(const Type* pString, size_t count)
+	{
+		if (!count)
+			return;
+
+		invalidateHash();
+		if (length + count > allocatedLength)
 		{
-			std::memmove(newBlock, string, (length - 1) * typeSize());
-			delete[] string;
+			// The characters could be a part of this string, which moves when reallocating.
+			const bool bAliases = string && pString >= string && pString < string + length;
+			const size_t offset = bAliases ? static_cast<size_t>(pString - string) : 0;
+
+			reallocate(getNewCapacity(length + count));
+
+			if (bAliases)
+				pString = string + offset;
 		}
 
-		// Assign the new character and the new block to the string pointer.
-		newBlock[length] = character;
-		string = newBlock;
+		std::memcpy(string + length, pString, count * typeSize());
+		length += count;
+		string[length] = 0;
+	}
+
+	/**
+	 * Append an integer. This does not allocate anything but the string's own storage.
+	 *
+	 * @tparam Integer: The integer type.
+	 * @param value: The value.
+	 * @param base: The base, from 2 to 36.
+	 */
+	template<class Integer>
+	void appendInt(Integer value, int base = 10)
+	{
+		Type buffer[NumberConversion::MaxIntegerLength];
+		append(buffer, NumberConversion::FormatInteger(buffer, value, base));
+	}
+
+	/**
+	 * Append a floating point value using the shortest representation which parses back to the same value.
+	 * This does not allocate anything but the string's own storage.
+	 *
+	 * @tparam Float: The floating point type.
+	 * @param value: The value.
+	 */
+	template<class Float>
+	void appendFloat(Float value)
+	{
+		Type buffer[NumberConversion::MaxFloatLength];
+		append(buffer, NumberConversion::FormatFloat(buffer, value));
 	}
 
 	/**
@@ -241,6 +413,9 @@ public:
 	 */
 	Type& at(long long index)
 	{
+		// The character could be modified through the reference.
+		invalidateHash();
+
 		// Process negative indexes.
 		if (index < 0)
 			index = static_cast<long long>(length) + index;
@@ -265,29 +440,27 @@ public:
 	/**
 	 * Create a sub string using the current string.
 	 *
-	 * The sub string is made using String[startIndex] and String[endIndex - 1] inclusive.
+	 * The sub string is made using String[startIndex] and String[endIndex - 1] inclusive. Use subView to avoid
+	 * copying the characters.
 	 *
 	 * @param startIndex: The start index to copy data from.
 	 * @param endIndex: The end index to copy data.
 	 */
-	String subString(long long startIndex, long long endIndex)
+	String subString(long long startIndex, long long endIndex) const
 	{
-		// Process the start index.
-		if (startIndex < 0)
-			startIndex = length + startIndex;
-
-		// Process the end index.
-		if (endIndex < 0)
-			endIndex = length + endIndex;
-
-		// Create the new string with the requires size.
-		String newBlock(endIndex - startIndex);
-
-		// Copy data to it using the indexes.
-		for (size_t index = static_cast<size_t>(startIndex); index < static_cast<size_t>(endIndex); index++)
-			newBlock[index - startIndex] = string[index];
+		return String(subView(startIndex, endIndex), pResource);
+	}
 
-		return newBlock;
+	/**
+	 * Create a view of a part of the string.
+	 * The view is made using String[startIndex] and String[endIndex - 1] inclusive.
+	 *
+	 * @param startIndex: The index of the first character.
+	 * @param endIndex: The index after the last character.
+	 */
+	View subView(long long startIndex, long long endIndex) const noexcept
+	{
+		return view().subView(startIndex, endIndex);
 	}
 
 	/**
@@ -296,14 +469,9 @@ public:
 	 *
 	 * @param character: The character to be searched.
 	 */
-	long long find(Type character)
+	long long find(Type character) const
 	{
-		// Iterate through the string and check if the character exists.
-		for (size_t index = 0; index < length; index++)
-			if (string[index] == character)
-				return index;
-
-		return -1;
+		return view().find(character);
 	}
 
 	/**
@@ -313,70 +481,88 @@ public:
 	 *
 	 * @param str: The string to be searched for.
 	 */
-	long long find(String str)
+	long long find(View str) const
 	{
-		// Check if the string is valid.
-		if (!this->length || !str.length || (this->length < str.length))
-			return -1;
+		return view().find(str);
+	}
 
-		// Iterate through the string to find a match.
-		for (size_t index = 0; index < length; index++)
-		{
-			if (string[index] == str[0])
-			{
-				long long candidate = index;
-
-				// Iterate through to find if the characters match.
-				for (size_t itr = index; itr < str.length; itr++)
-				{
-					if (string[itr] != str[itr - index])
-					{
-						itr = str.length;
-						candidate = -1;
-					}
-				}
-
-				// If the candidate is not -1, it means that we have found the right index.
-				if (candidate != -1)
-					return candidate;
-			}
-		}
+	/**
+	 * Check if the string starts with a prefix.
+	 *
+	 * @param prefix: The prefix.
+	 */
+	bool startsWith(View prefix) const
+	{
+		return view().startsWith(prefix);
+	}
 
-		return -1;
+	/**
+	 * Check if the string ends with a suffix.
+	 *
+	 * @param suffix: The suffix.
+	 */
+	bool endsWith(View suffix) const
+	{
+		return view().endsWith(suffix);
 	}
 
 	/**
-	 * Generate a hash using the current string.
+	 * Parse the string as an integer.
+	 * The whole string must be the number. Returns false and leaves the value unchanged if it is not a number or
+	 * does not fit the type.
+	 *
+	 * @tparam Integer: The integer type.
+	 * @param value: The parsed value.
+	 * @param base: The base, from 2 to 36.
 	 */
-	size_t hash()
+	template<class Integer>
+	bool parseInt(Integer& value, int base = 10) const
 	{
-		size_t uHash = 0;
+		return view().parseInt(value, base);
+	}
 
-		for (size_t index = 0; index < length; index++)
-		{
-			size_t charNum = static_cast<size_t>(string[index]);
+	/**
+	 * Parse the string as a floating point value.
+	 * The whole string must be the number. Returns false and leaves the value unchanged if it is not a number or is
+	 * out of range.
+	 *
+	 * @tparam Float: The floating point type.
+	 * @param value: The parsed value.
+	 */
+	template<class Float>
+	bool parseFloat(Float& value) const
+	{
+		return view().parseFloat(value);
+	}
 
-			uHash = uHash ^ (charNum * index);
+	/**
+	 * Generate a hash using the current string. This is equal to the hash of a view with the same characters.
+	 * The hash is cached if STRING_CACHE_HASH is defined.
+	 */
+	size_t hash() const noexcept
+	{
+#ifdef STRING_CACHE_HASH
+		// A hash of 0 is indistinguishable from an empty cache, so it is simply calculated every time.
+		// Threads which hash the same string at once may both calculate it, but they store the same value.
+		size_t hash = cachedHash.load(std::memory_order_relaxed);
+		if (!hash)
+		{
+			hash = view().hash();
+			cachedHash.store(hash, std::memory_order_relaxed);
 		}
 
-		return uHash;
+		return hash;
+
+#else
+		return view().hash();
+
+#endif // STRING_CACHE_HASH
 	}
 
 public:
 	String& operator=(const Type* pString)
 	{
-		// Clear the existing data.
-		clear();
-
-		// Set the length of the string.
-		length = GetStrLength(pString);
-
-		// Allocate a new block in memory.
-		string = CreateNewBlock(length + 1);
-
-		// Copy the primitive string to the newly allocated memory block.
-		std::memcpy(string, pString, length * typeSize());
-
+		assign(pString, GetStrLength(pString));
 		return *this;
 	}
 
@@ -387,18 +573,12 @@ public:
 	 */
 	String& operator=(const String& str)
 	{
-		// Return if the other string is empty.
-		if (!str.length || !str.string)
-			return*this;
+		// Check if we are assigning to ourselves.
+		if (this == &str)
+			return *this;
 
-		// Clear the existing data.
-		clear();
-
-		// Allocate a new block in memory.
-		string = CreateNewBlock(length + 1);
-
-		// Copy the primitive string to the newly allocated memory block.
-		std::memcpy(string, str.string, length * typeSize());
+		// Copy the characters, reusing the existing allocation if it is large enough.
+		assign(str.string, str.length);
 
 		return *this;
 	}
@@ -410,11 +590,26 @@ public:
 	 */
 	String& operator=(String&& str) noexcept
 	{
+		// Check if we are assigning to ourselves.
+		if (this == &str)
+			return *this;
+
+		// Clear the existing data.
+		clear();
+
 		this->string = str.string;
 		this->length = str.length;
+		this->allocatedLength = str.allocatedLength;
+		this->pResource = str.pResource;
 
 		str.string = nullptr;
 		str.length = 0;
+		str.allocatedLength = 0;
+
+#ifdef STRING_CACHE_HASH
+		cachedHash.store(str.cachedHash.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+#endif // STRING_CACHE_HASH
 
 		return *this;
 	}
@@ -426,18 +621,7 @@ public:
 	 */
 	String& operator=(const TypeSTD& str)
 	{
-		// Return if the other string is empty.
-		if (!str.size())
-			return*this;
-
-		length = str.length();
-
-		// Allocate a new block in memory.
-		string = CreateNewBlock(length + 1);
-
-		// Copy the primitive string to the newly allocated memory block.
-		std::memcpy(string, str.data(), length * typeSize());
-
+		assign(str.data(), str.size());
 		return *this;
 	}
 
@@ -448,20 +632,7 @@ public:
 	 */
 	String& operator+=(const Type* pString)
 	{
-		size_t newLength = length + GetStrLength(pString);
-
-		// Create a new memory block.
-		Type* pBlock = CreateNewBlock(newLength + 1);
-
-		// Copy the existing and new data to the new memory block.
-		std::memcpy(pBlock, string, length * typeSize());
-		std::memcpy(reinterpret_cast<Type*>(reinterpret_cast<size_t>(pBlock) + (length * typeSize())), pString, GetStrLength(pString) * typeSize());
-
-		// Clear and assign the new values to the string.
-		clear();
-		string = pBlock;
-		length = newLength;
-
+		append(pString, GetStrLength(pString));
 		return *this;
 	}
 
@@ -472,20 +643,18 @@ public:
 	 */
 	String& operator+=(const String& str)
 	{
-		size_t newLength = length + str.length;
-
-		// Create a new memory block.
-		Type* pBlock = CreateNewBlock(newLength + 1);
-
-		// Copy the existing and new data to the new memory block.
-		std::memcpy(pBlock, string, length * typeSize());
-		std::memcpy(reinterpret_cast<Type*>(reinterpret_cast<size_t>(pBlock) + (length * typeSize())), str.string, str.length * typeSize());
-
-		// Clear and assign the new values to the string.
-		clear();
-		string = pBlock;
-		length = newLength;
+		append(str.string, str.length);
+		return *this;
+	}
 
+	/**
+	 * Concatenate a view to the stored string.
+	 *
+	 * @param view: The view. This may be a part of this string.
+	 */
+	String& operator+=(View view)
+	{
+		append(view.data(), view.size());
 		return *this;
 	}
 
@@ -496,19 +665,7 @@ public:
 	 */
 	String& operator+=(String&& str)
 	{
-		size_t newLength = length + str.length;
-
-		// Create a new memory block.
-		Type* pBlock = CreateNewBlock(newLength + 1);
-
-		// Copy the existing and new data to the new memory block.
-		std::memcpy(pBlock, string, length * typeSize());
-		std::memcpy(reinterpret_cast<Type*>(reinterpret_cast<size_t>(pBlock) + (length * typeSize())), str.string, str.length * typeSize());
-
-		// Clear and assign the new values to the string.
-		clear();
-		string = pBlock;
-		length = newLength;
+		append(str.string, str.length);
 
 		// Clear the other string.
 		str.clear();
@@ -521,18 +678,14 @@ public:
 	 *
 	 * @param pString: The primitive string.
 	 */
-	bool operator==(const Type* pString)
+	bool operator==(const Type* pString) const
 	{
 		// Check if the sizes are equal.
 		if (length != GetStrLength(pString))
 			return false;
 
 		// Check if the characters are equal.
-		for (size_t itr = 0; itr < length; itr++)
-			if (string[itr] != pString[itr])
-				return false;
-
-		return true;
+		return StringKernels::Equal(string, pString, length);
 	}
 
 	/**
@@ -540,20 +693,31 @@ public:
 	 *
 	 * @param other: The other string.
 	 */
-	bool operator==(const String& other)
+	bool operator==(const String& other) const
 	{
 		// Check if the sizes are equal.
 		if (length != other.length)
 			return false;
 
 		// Check if the characters are equal.
-		for (size_t itr = 0; itr < length; itr++)
-			if (string[itr] != other.string[itr])
-				return false;
+		return StringKernels::Equal(string, other.string, length);
+	}
 
-		return true;
+	/**
+	 * Is equal operator.
+	 *
+	 * @param view: The view.
+	 */
+	bool operator==(View view) const
+	{
+		return this->view() == view;
 	}
 
+	/**
+	 * Convert the string to a view.
+	 */
+	operator View() const noexcept { return view(); }
+
 	/**
 	 * Index operator.
 	 *
@@ -583,7 +747,7 @@ private:
 	__forceinline Type* CreateNewBlock(size_t count) const
 	{
 		// Allocate a new block in memory.
-		Type* pBlock = new Type[count];
+		Type* pBlock = static_cast<Type*>(pResource->allocate(count * typeSize(), alignof(Type)));
 
 		// Set the initial values to 0.
 		std::memset(pBlock, 0, count * typeSize());
@@ -591,9 +755,120 @@ private:
 		return pBlock;
 	}
 
+	/**
+	 * Helper to release a block allocated using CreateNewBlock.
+	 *
+	 * @param pBlock: The block to be released.
+	 * @param count: The total count of characters the block was allocated for (including '\0').
+	 */
+	__forceinline void DestroyBlock(Type* pBlock, size_t count) const
+	{
+		pResource->deallocate(pBlock, count * typeSize(), alignof(Type));
+	}
+
+	/**
+	 * Reset the cached hash after the characters changed.
+	 */
+	__forceinline void invalidateHash() const noexcept
+	{
+#ifdef STRING_CACHE_HASH
+		cachedHash.store(0, std::memory_order_relaxed);
+
+#endif // STRING_CACHE_HASH
+	}
+
+	/**
+	 * Get the capacity to grow to when a number of characters must fit.
+	 * The capacity grows by 1.5x so that appending is amortized O(1), starting at 15 characters so that short strings
+	 * do not reallocate on every character.
+	 *
+	 * @param requiredLength: The number of characters which must fit.
+	 */
+	size_t getNewCapacity(size_t requiredLength) const
+	{
+		size_t grown = allocatedLength + allocatedLength / 2;
+		if (grown < 15)
+			grown = 15;
+
+		return requiredLength > grown ? requiredLength : grown;
+	}
+
+	/**
+	 * Move the characters to a new block.
+	 *
+	 * @param newCapacity: The number of characters the block should fit (excluding '\0'). This must not be less
+	 *	than the length.
+	 */
+	void reallocate(size_t newCapacity)
+	{
+		// Only the characters and the null terminator need to be initialized.
+		Type* pBlock = static_cast<Type*>(pResource->allocate((newCapacity + 1) * typeSize(), alignof(Type)));
+		if (string)
+		{
+			std::memcpy(pBlock, string, length * typeSize());
+			DestroyBlock(string, allocatedLength + 1);
+		}
+
+		pBlock[length] = 0;
+		string = pBlock;
+		allocatedLength = newCapacity;
+	}
+
+	/**
+	 * Replace the characters of the string, reusing the allocation if it is large enough.
+	 *
+	 * @param pString: The new characters. These may be a part of this string.
+	 * @param count: The number of characters.
+	 */
+	void assign(const Type* pString, size_t count)
+	{
+		invalidateHash();
+
+		// A source inside this string is never longer than the allocation, so it survives the reallocation check.
+		if (count > allocatedLength)
+		{
+			clear();
+			reallocate(count);
+		}
+
+		if (count)
+			std::memmove(string, pString, count * typeSize());
+
+		length = count;
+		if (string)
+			string[length] = 0;
+	}
+
 private:
 	size_t length = 0;			// Length of the string.
+	size_t allocatedLength = 0;	// Number of characters the allocation can hold (excluding '\0').
 	Type* string = nullptr;		// The string data pointer.
+	MemoryResource* pResource = GetDefaultMemoryResource();	// The memory resource used to allocate memory.
+
+#ifdef STRING_CACHE_HASH
+	mutable std::atomic<size_t> cachedHash = 0;	// The hash of the characters, or 0 if it was not calculated since the last change.
+
+#endif // STRING_CACHE_HASH
+};
+
+/**
+ * Standard hash specialization, so that the string can be used as a key of the standard containers.
+ */
+template<>
+struct std::hash<String> {
+	size_t operator()(const String& str) const noexcept { return str.hash(); }
+};
+
+/**
+ * Transparent hasher for the standard containers, which allows a container keyed by String to be searched using
+ * views and primitive strings without creating a String (use it together with std::equal_to<>).
+ */
+struct StringHasher {
+	using is_transparent = void;
+
+	size_t operator()(const String& str) const noexcept { return str.hash(); }
+	size_t operator()(String::View view) const noexcept { return view.hash(); }
+	size_t operator()(const String::Type* pString) const noexcept { return String::View(pString).hash(); }
 };
 
 
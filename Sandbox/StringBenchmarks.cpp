@@ -0,0 +1,98 @@
+#include "String.h"
+
+#include <benchmark/benchmark.h>
+
+/**
+ * Build a string one character at a time.
+ */
+static void BM_StringAppendCharacter(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		String string;
+		for (size_t index = 0; index < count; index++)
+			string.append(static_cast<String::Type>('a' + index % 26));
+
+		benchmark::DoNotOptimize(string.str());
+	}
+
+	state.SetComplexityN(state.range(0));
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_StringAppendCharacter)->RangeMultiplier(16)->Range(16, 1 << 20)->Complexity(benchmark::oN);
+
+/**
+ * Build a string one character at a time using std::string for reference.
+ */
+static void BM_StandardStringAppendCharacter(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		String::TypeSTD string;
+		for (size_t index = 0; index < count; index++)
+			string.push_back(static_cast<String::Type>('a' + index % 26));
+
+		benchmark::DoNotOptimize(string.data());
+	}
+
+	state.SetComplexityN(state.range(0));
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_StandardStringAppendCharacter)->RangeMultiplier(16)->Range(16, 1 << 20)->Complexity(benchmark::oN);
+
+/**
+ * Concatenate words in a loop.
+ */
+static void BM_StringConcatenateLoop(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+	const String word(TEXT("fragment "));
+
+	for (auto _ : state)
+	{
+		String string;
+		for (size_t index = 0; index < count; index++)
+			string += word;
+
+		benchmark::DoNotOptimize(string.str());
+	}
+
+	state.SetComplexityN(state.range(0));
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_StringConcatenateLoop)->RangeMultiplier(16)->Range(16, 1 << 16)->Complexity(benchmark::oN);
+
+/**
+ * Assemble log lines into a reused buffer, as a logger would.
+ */
+static void BM_StringLogLine(benchmark::State& state)
+{
+	const String::Type* const pLevels[] = { TEXT("[INFO] "), TEXT("[WARN] "), TEXT("[ERROR] ") };
+	const String message(TEXT("Frame submitted to the graphics queue in 16.6 ms."));
+
+	String line;
+	line.reserve(256);
+	size_t index = 0;
+
+	for (auto _ : state)
+	{
+		line = TEXT("2021-04-01 12:00:00 ");
+		line += pLevels[index++ % 3];
+		line.append(TEXT("Renderer: "), 10);
+		line += message;
+		line.append('\n');
+
+		benchmark::DoNotOptimize(line.str());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_StringLogLine);
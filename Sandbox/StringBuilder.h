@@ -0,0 +1,254 @@
+#pragma once
+#include "String.h"
+
+#include <ostream>
+
+/**
+ * String builder for assembling large strings out of many fragments.
+ * The fragments are copied to a list of chunks allocated from a linear arena, so appending never moves the
+ * characters which were appended before. The result is flattened into a String once using toString(), or written
+ * chunk by chunk to a stream (or any other sink using forEachChunk()) without flattening it at all.
+ *
+ * Clearing the builder resets the arena, which keeps the first chunk for the next use.
+ * This object is not thread safe.
+ */
+class StringBuilder {
+public:
+	// Primitive type.
+	using Type = String::Type;
+
+	// String view type.
+	using View = String::View;
+
+private:
+	/**
+	 * Header of a chunk. The characters are stored right after the header.
+	 */
+	struct Chunk {
+		Chunk* pNext = nullptr;		// The next chunk in the list.
+		size_t size = 0;			// The number of characters stored in the chunk.
+		size_t capacity = 0;		// The number of characters the chunk can hold.
+
+		/**
+		 * Get the characters of the chunk.
+		 */
+		Type* characters() noexcept { return reinterpret_cast<Type*>(this + 1); }
+
+		/**
+		 * Get the characters of the chunk.
+		 */
+		const Type* characters() const noexcept { return reinterpret_cast<const Type*>(this + 1); }
+	};
+
+public:
+	/**
+	 * Default constructor.
+	 *
+	 * @param chunkCapacity: The number of characters a chunk holds. Fragments larger than this get a chunk of their
+	 *	own. Default is 16 Ki characters, and a capacity of 0 is raised to 1.
+	 * @param pUpstream: The resource the arena allocates from. Default is the default memory resource.
+	 */
+	explicit StringBuilder(size_t chunkCapacity = 16 * 1024, MemoryResource* pUpstream = GetDefaultMemoryResource())
+		: mArena(GetArenaChunkSize(chunkCapacity ? chunkCapacity : 1), pUpstream), chunkCapacity(chunkCapacity ? chunkCapacity : 1) {}
+
+	StringBuilder(const StringBuilder&) = delete;
+	StringBuilder& operator=(const StringBuilder&) = delete;
+
+	/**
+	 * Get the number of characters appended to the builder.
+	 */
+	size_t size() const noexcept { return length; }
+
+	/**
+	 * Check if the builder is empty.
+	 */
+	bool empty() const noexcept { return length == 0; }
+
+	/**
+	 * Append a character.
+	 *
+	 * @param character: The character.
+	 */
+	void append(Type character)
+	{
+		if (!pTail || pTail->size == pTail->capacity)
+			createChunk(chunkCapacity);
+
+		pTail->characters()[pTail->size++] = character;
+		length++;
+	}
+
+	/**
+	 * Append a number of characters.
+	 *
+	 * @param pString: The characters.
+	 * @param count: The number of characters.
+	 */
+	void append(const Type* pString, size_t count)
+	{
+		length += count;
+
+		// Fill the rest of the current chunk first.
+		if (pTail)
+		{
+			const size_t remaining = pTail->capacity - pTail->size;
+			const size_t copyCount = count < remaining ? count : remaining;
+
+			std::memcpy(pTail->characters() + pTail->size, pString, copyCount * sizeof(Type));
+			pTail->size += copyCount;
+			pString += copyCount;
+			count -= copyCount;
+		}
+
+		// Copy the rest into a new chunk, which is made large enough to hold it in one piece.
+		if (count)
+		{
+			createChunk(count > chunkCapacity ? count : chunkCapacity);
+			std::memcpy(pTail->characters(), pString, count * sizeof(Type));
+			pTail->size = count;
+		}
+	}
+
+	/**
+	 * Append a view.
+	 *
+	 * @param view: The view.
+	 */
+	void append(View view)
+	{
+		append(view.data(), view.size());
+	}
+
+	/**
+	 * Remove all the characters.
+	 * The first arena chunk is kept for the next use.
+	 */
+	void clear()
+	{
+		mArena.reset();
+		pHead = nullptr;
+		pTail = nullptr;
+		length = 0;
+	}
+
+	/**
+	 * Call a function with a view of every chunk, in order.
+	 * This can be used to send the characters to a sink (a file, a socket or a hash) without flattening them.
+	 *
+	 * @tparam Function: The function type, taking a View.
+	 * @param function: The function.
+	 */
+	template<class Function>
+	void forEachChunk(Function&& function) const
+	{
+		for (const Chunk* pChunk = pHead; pChunk; pChunk = pChunk->pNext)
+			if (pChunk->size)
+				function(View(pChunk->characters(), pChunk->size));
+	}
+
+	/**
+	 * Write the characters to a stream without flattening them.
+	 *
+	 * @param stream: The stream.
+	 */
+	void writeTo(std::basic_ostream<Type>& stream) const
+	{
+		forEachChunk([&stream](View view) { stream.write(view.data(), static_cast<std::streamsize>(view.size())); });
+	}
+
+	/**
+	 * Flatten the characters into a string.
+	 * The string is allocated once, with exactly the size of the builder.
+	 *
+	 * @param pResource: The memory resource the string allocates from.
+	 */
+	String toString(MemoryResource* pResource = GetDefaultMemoryResource()) const
+	{
+		String string(pResource);
+		string.reserve(length);
+		forEachChunk([&string](View view) { string += view; });
+
+		return string;
+	}
+
+public:
+	/**
+	 * Append a character.
+	 *
+	 * @param character: The character.
+	 */
+	StringBuilder& operator+=(Type character)
+	{
+		append(character);
+		return *this;
+	}
+
+	/**
+	 * Append a view. This also accepts strings and primitive strings.
+	 *
+	 * @param view: The view.
+	 */
+	StringBuilder& operator+=(View view)
+	{
+		append(view);
+		return *this;
+	}
+
+	/**
+	 * Append a character.
+	 *
+	 * @param character: The character.
+	 */
+	StringBuilder& operator<<(Type character)
+	{
+		append(character);
+		return *this;
+	}
+
+	/**
+	 * Append a view. This also accepts strings and primitive strings.
+	 *
+	 * @param view: The view.
+	 */
+	StringBuilder& operator<<(View view)
+	{
+		append(view);
+		return *this;
+	}
+
+private:
+	/**
+	 * Get the arena chunk size which fits exactly one builder chunk of a capacity, including the alignment padding
+	 * the arena reserves.
+	 *
+	 * @param chunkCapacity: The number of characters of the builder chunk.
+	 */
+	static constexpr size_t GetArenaChunkSize(size_t chunkCapacity) noexcept
+	{
+		return sizeof(Chunk) + chunkCapacity * sizeof(Type) + alignof(Chunk);
+	}
+
+	/**
+	 * Allocate a new chunk from the arena and add it to the end of the list.
+	 *
+	 * @param capacity: The number of characters the chunk holds.
+	 */
+	void createChunk(size_t capacity)
+	{
+		Chunk* pChunk = new (mArena.allocate(sizeof(Chunk) + capacity * sizeof(Type), alignof(Chunk))) Chunk{ nullptr, 0, capacity };
+
+		if (pTail)
+			pTail->pNext = pChunk;
+		else
+			pHead = pChunk;
+
+		pTail = pChunk;
+	}
+
+private:
+	LinearArena mArena;			// The arena which stores the chunks.
+	Chunk* pHead = nullptr;		// The first chunk.
+	Chunk* pTail = nullptr;		// The last chunk, which is appended to.
+	size_t length = 0;			// The total number of characters.
+	size_t chunkCapacity = 0;	// The default number of characters in a chunk.
+};
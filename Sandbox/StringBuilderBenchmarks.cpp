@@ -0,0 +1,163 @@
+#include "StringBuilder.h"
+
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include <vector>
+
+/**
+ * Create shader source like fragments (lines of a generated shader).
+ *
+ * @param count: The number of fragments.
+ */
+static std::vector<String> CreateFragments(size_t count)
+{
+	const String::Type* const pLines[] = {
+		TEXT("layout(location = 0) in vec3 position;\n"),
+		TEXT("uniform mat4 model;\n"),
+		TEXT("gl_Position = projection * view * model * vec4(position, 1.0);\n"),
+		TEXT("}\n"),
+		TEXT("float attenuation = 1.0 / (distance * distance);\n")
+	};
+
+	std::vector<String> fragments(count);
+	for (size_t index = 0; index < count; index++)
+		fragments[index] = pLines[index % 5];
+
+	return fragments;
+}
+
+/**
+ * Assemble the fragments by concatenating them to a new string every time (string = string + fragment), which
+ * copies everything which came before.
+ */
+static void BM_StringAssembleConcatenate(benchmark::State& state)
+{
+	const std::vector<String> fragments = CreateFragments(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		String string;
+		for (const auto& fragment : fragments)
+			string = string + fragment;
+
+		benchmark::DoNotOptimize(string.str());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StringAssembleConcatenate)->RangeMultiplier(10)->Range(1000, 10000);
+
+/**
+ * Assemble the fragments using String::operator+=.
+ */
+static void BM_StringAssembleAppend(benchmark::State& state)
+{
+	const std::vector<String> fragments = CreateFragments(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		String string;
+		for (const auto& fragment : fragments)
+			string += fragment;
+
+		benchmark::DoNotOptimize(string.str());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StringAssembleAppend)->RangeMultiplier(10)->Range(1000, 100000);
+
+/**
+ * Assemble the fragments using a string builder and flatten the result.
+ */
+static void BM_StringBuilderAssemble(benchmark::State& state)
+{
+	const std::vector<String> fragments = CreateFragments(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		StringBuilder builder;
+		for (const auto& fragment : fragments)
+			builder += fragment;
+
+		const String string = builder.toString();
+		benchmark::DoNotOptimize(string.str());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StringBuilderAssemble)->RangeMultiplier(10)->Range(1000, 100000);
+
+/**
+ * Assemble the fragments using a string builder which is cleared and reused, and flatten the result.
+ */
+static void BM_StringBuilderAssembleReused(benchmark::State& state)
+{
+	const std::vector<String> fragments = CreateFragments(static_cast<size_t>(state.range(0)));
+	StringBuilder builder;
+
+	for (auto _ : state)
+	{
+		builder.clear();
+		for (const auto& fragment : fragments)
+			builder += fragment;
+
+		const String string = builder.toString();
+		benchmark::DoNotOptimize(string.str());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StringBuilderAssembleReused)->RangeMultiplier(10)->Range(1000, 100000);
+
+/**
+ * Assemble the fragments using a string and write it to a stream.
+ */
+static void BM_StringAssembleAppendWrite(benchmark::State& state)
+{
+	const std::vector<String> fragments = CreateFragments(static_cast<size_t>(state.range(0)));
+	std::basic_ostringstream<String::Type> stream;
+
+	for (auto _ : state)
+	{
+		String string;
+		for (const auto& fragment : fragments)
+			string += fragment;
+
+		stream.str({});
+		stream.write(string.str(), static_cast<std::streamsize>(string.size()));
+		benchmark::DoNotOptimize(stream.tellp());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StringAssembleAppendWrite)->Arg(100000);
+
+/**
+ * Assemble the fragments using a string builder and write the chunks to a stream without flattening them.
+ */
+static void BM_StringBuilderAssembleWrite(benchmark::State& state)
+{
+	const std::vector<String> fragments = CreateFragments(static_cast<size_t>(state.range(0)));
+	std::basic_ostringstream<String::Type> stream;
+
+	for (auto _ : state)
+	{
+		StringBuilder builder;
+		for (const auto& fragment : fragments)
+			builder += fragment;
+
+		stream.str({});
+		builder.writeTo(stream);
+		benchmark::DoNotOptimize(stream.tellp());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StringBuilderAssembleWrite)->Arg(100000);
@@ -0,0 +1,334 @@
+#pragma once
+#include "ArrayKernels.h"
+
+#include <cstring>
+
+/**
+ * Vectorized length, search and comparison kernels for strings of char and wchar_t (or any 1, 2 or 4 byte character
+ * type). The length and search kernels have a scalar version and SSE4.2 and AVX2 versions which are selected at
+ * runtime. The AVX-512 level uses the AVX2 kernels, as strings are usually too short to benefit from the wider
+ * registers.
+ *
+ * Searching for a single character is done using ArrayKernels::Find.
+ */
+namespace StringKernels {
+	namespace Scalar {
+		/**
+		 * Get the number of characters before the null terminator.
+		 *
+		 * @param pString: The null terminated string.
+		 */
+		template<class Type>
+		size_t Length(const Type* pString)
+		{
+			const Type* pEnd = pString;
+			while (*pEnd != Type()) pEnd++;
+
+			return pEnd - pString;
+		}
+
+		/**
+		 * Find the index of the first occurrence of a needle in a haystack.
+		 * Returns haystackLength if the needle is not found. The needle must not be longer than the haystack and must
+		 * not be empty.
+		 *
+		 * @param pHaystack: The characters to search in.
+		 * @param haystackLength: The number of characters in the haystack.
+		 * @param pNeedle: The characters to search for.
+		 * @param needleLength: The number of characters in the needle.
+		 */
+		template<class Type>
+		size_t FindString(const Type* pHaystack, size_t haystackLength, const Type* pNeedle, size_t needleLength)
+		{
+			for (size_t index = 0; index + needleLength <= haystackLength; index++)
+				if (pHaystack[index] == pNeedle[0] && std::memcmp(pHaystack + index, pNeedle, needleLength * sizeof(Type)) == 0)
+					return index;
+
+			return haystackLength;
+		}
+
+		/**
+		 * Check if two blocks of characters are equal.
+		 *
+		 * @param pLeft: The first characters.
+		 * @param pRight: The second characters.
+		 * @param count: The number of characters.
+		 */
+		template<class Type>
+		bool Equal(const Type* pLeft, const Type* pRight, size_t count)
+		{
+			return count == 0 || std::memcmp(pLeft, pRight, count * sizeof(Type)) == 0;
+		}
+	}
+
+#ifdef SIMD_X86
+	/**
+	 * Get the byte mask which keeps one bit per character of a byte mask produced by the comparisons.
+	 */
+	template<class Type>
+	constexpr uint32_t FirstByteMask = sizeof(Type) == 1 ? 0xFFFFFFFF : (sizeof(Type) == 2 ? 0x55555555 : 0x11111111);
+
+	SIMD_BEGIN_TARGET_SSE42
+
+	/**
+	 * SSE4.2 kernels.
+	 */
+	namespace SSE42 {
+		using namespace ArrayKernels::SSE42;
+
+		/**
+		 * Load a register from memory aligned to the register width. This is only used by the kernels which read past
+		 * the end of a buffer.
+		 */
+		template<class Type>
+		SIMD_NO_SANITIZE_ADDRESS inline Register LoadAligned(const Type* pData) { return _mm_load_si128(reinterpret_cast<const Register*>(pData)); }
+
+		/**
+		 * Get the lane wise unsigned minimum of two registers.
+		 */
+		template<class Type>
+		inline Register Minimum(Register a, Register b)
+		{
+			if constexpr (sizeof(Type) == 1) return _mm_min_epu8(a, b);
+			else if constexpr (sizeof(Type) == 2) return _mm_min_epu16(a, b);
+			else return _mm_min_epu32(a, b);
+		}
+
+		/**
+		 * Get the number of characters before the null terminator.
+		 * The string is read using aligned loads, which never cross a page boundary, so reading the bytes around the
+		 * string is safe even though they do not belong to it.
+		 */
+		template<class Type>
+		SIMD_NO_SANITIZE_ADDRESS size_t Length(const Type* pString)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			constexpr size_t GroupWidth = Width * 4;
+			const Register zero = _mm_setzero_si128();
+
+			// Ignore the bytes before the string in the first block.
+			const size_t offset = reinterpret_cast<uintptr_t>(pString) & (Width - 1);
+			const Type* pBlock = pString - offset / sizeof(Type);
+			uint32_t mask = EqualMask<Type>(LoadAligned(pBlock), zero) >> offset;
+			if (mask)
+				return SIMD::CountTrailingZeros(mask) / sizeof(Type);
+
+			// Check single blocks until the next block starts a group of four.
+			for (pBlock += Lanes; reinterpret_cast<uintptr_t>(pBlock) & (GroupWidth - 1); pBlock += Lanes)
+				if ((mask = EqualMask<Type>(LoadAligned(pBlock), zero)))
+					return (pBlock - pString) + SIMD::CountTrailingZeros(mask) / sizeof(Type);
+
+			// Check four blocks at a time. A lane of the minimum is zero only if that lane is zero in one of the blocks.
+			for (;; pBlock += Lanes * 4)
+			{
+				const Register minimum = Minimum<Type>(Minimum<Type>(LoadAligned(pBlock), LoadAligned(pBlock + Lanes)),
+					Minimum<Type>(LoadAligned(pBlock + Lanes * 2), LoadAligned(pBlock + Lanes * 3)));
+
+				if (EqualMask<Type>(minimum, zero))
+					break;
+			}
+
+			for (;; pBlock += Lanes)
+				if ((mask = EqualMask<Type>(LoadAligned(pBlock), zero)))
+					return (pBlock - pString) + SIMD::CountTrailingZeros(mask) / sizeof(Type);
+		}
+
+		/**
+		 * Find the index of the first occurrence of a needle in a haystack.
+		 * Every block is compared against the first and the last character of the needle, and only the positions
+		 * where both match are compared in full.
+		 */
+		template<class Type>
+		size_t FindString(const Type* pHaystack, size_t haystackLength, const Type* pNeedle, size_t needleLength)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			const Register first = Broadcast(pNeedle[0]);
+			const Register last = Broadcast(pNeedle[needleLength - 1]);
+
+			size_t index = 0;
+			for (; index + Lanes + needleLength <= haystackLength + 1; index += Lanes)
+			{
+				uint32_t mask = EqualMask<Type>(Load(pHaystack + index), first)
+					& EqualMask<Type>(Load(pHaystack + index + needleLength - 1), last)
+					& FirstByteMask<Type>;
+
+				for (; mask; mask &= mask - 1)
+				{
+					const size_t candidate = index + SIMD::CountTrailingZeros(mask) / sizeof(Type);
+					if (std::memcmp(pHaystack + candidate, pNeedle, needleLength * sizeof(Type)) == 0)
+						return candidate;
+				}
+			}
+
+			return index + Scalar::FindString(pHaystack + index, haystackLength - index, pNeedle, needleLength);
+		}
+	}
+
+	SIMD_END_TARGET
+
+	SIMD_BEGIN_TARGET_AVX2
+
+	/**
+	 * AVX2 kernels.
+	 */
+	namespace AVX2 {
+		using namespace ArrayKernels::AVX2;
+
+		/**
+		 * Load a register from memory aligned to the register width. This is only used by the kernels which read past
+		 * the end of a buffer.
+		 */
+		template<class Type>
+		SIMD_NO_SANITIZE_ADDRESS inline Register LoadAligned(const Type* pData) { return _mm256_load_si256(reinterpret_cast<const Register*>(pData)); }
+
+		/**
+		 * Get the lane wise unsigned minimum of two registers.
+		 */
+		template<class Type>
+		inline Register Minimum(Register a, Register b)
+		{
+			if constexpr (sizeof(Type) == 1) return _mm256_min_epu8(a, b);
+			else if constexpr (sizeof(Type) == 2) return _mm256_min_epu16(a, b);
+			else return _mm256_min_epu32(a, b);
+		}
+
+		/**
+		 * Get the number of characters before the null terminator.
+		 * The string is read using aligned loads, which never cross a page boundary, so reading the bytes around the
+		 * string is safe even though they do not belong to it.
+		 */
+		template<class Type>
+		SIMD_NO_SANITIZE_ADDRESS size_t Length(const Type* pString)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			constexpr size_t GroupWidth = Width * 4;
+			const Register zero = _mm256_setzero_si256();
+
+			// Ignore the bytes before the string in the first block.
+			const size_t offset = reinterpret_cast<uintptr_t>(pString) & (Width - 1);
+			const Type* pBlock = pString - offset / sizeof(Type);
+			uint32_t mask = EqualMask<Type>(LoadAligned(pBlock), zero) >> offset;
+			if (mask)
+				return SIMD::CountTrailingZeros(mask) / sizeof(Type);
+
+			// Check single blocks until the next block starts a group of four.
+			for (pBlock += Lanes; reinterpret_cast<uintptr_t>(pBlock) & (GroupWidth - 1); pBlock += Lanes)
+				if ((mask = EqualMask<Type>(LoadAligned(pBlock), zero)))
+					return (pBlock - pString) + SIMD::CountTrailingZeros(mask) / sizeof(Type);
+
+			// Check four blocks at a time. A lane of the minimum is zero only if that lane is zero in one of the blocks.
+			for (;; pBlock += Lanes * 4)
+			{
+				const Register minimum = Minimum<Type>(Minimum<Type>(LoadAligned(pBlock), LoadAligned(pBlock + Lanes)),
+					Minimum<Type>(LoadAligned(pBlock + Lanes * 2), LoadAligned(pBlock + Lanes * 3)));
+
+				if (EqualMask<Type>(minimum, zero))
+					break;
+			}
+
+			for (;; pBlock += Lanes)
+				if ((mask = EqualMask<Type>(LoadAligned(pBlock), zero)))
+					return (pBlock - pString) + SIMD::CountTrailingZeros(mask) / sizeof(Type);
+		}
+
+		/**
+		 * Find the index of the first occurrence of a needle in a haystack.
+		 * Every block is compared against the first and the last character of the needle, and only the positions
+		 * where both match are compared in full.
+		 */
+		template<class Type>
+		size_t FindString(const Type* pHaystack, size_t haystackLength, const Type* pNeedle, size_t needleLength)
+		{
+			constexpr size_t Lanes = Width / sizeof(Type);
+			const Register first = Broadcast(pNeedle[0]);
+			const Register last = Broadcast(pNeedle[needleLength - 1]);
+
+			size_t index = 0;
+			for (; index + Lanes + needleLength <= haystackLength + 1; index += Lanes)
+			{
+				uint32_t mask = EqualMask<Type>(Load(pHaystack + index), first)
+					& EqualMask<Type>(Load(pHaystack + index + needleLength - 1), last)
+					& FirstByteMask<Type>;
+
+				for (; mask; mask &= mask - 1)
+				{
+					const size_t candidate = index + SIMD::CountTrailingZeros(mask) / sizeof(Type);
+					if (std::memcmp(pHaystack + candidate, pNeedle, needleLength * sizeof(Type)) == 0)
+						return candidate;
+				}
+			}
+
+			return index + Scalar::FindString(pHaystack + index, haystackLength - index, pNeedle, needleLength);
+		}
+	}
+
+	SIMD_END_TARGET
+
+#endif // SIMD_X86
+
+	/**
+	 * Get the number of characters before the null terminator.
+	 * The implementation is selected at runtime.
+	 */
+	template<class Type>
+	size_t Length(const Type* pString)
+	{
+#ifdef SIMD_X86
+		switch (SIMD::GetLevel())
+		{
+		case SIMD::Level::AVX512:
+		case SIMD::Level::AVX2:
+			return AVX2::Length(pString);
+
+		case SIMD::Level::SSE42:
+			return SSE42::Length(pString);
+
+		default:
+			break;
+		}
+
+#endif // SIMD_X86
+
+		return Scalar::Length(pString);
+	}
+
+	/**
+	 * Find the index of the first occurrence of a needle in a haystack. Returns haystackLength if the needle is not
+	 * found or if it is empty. The implementation is selected at runtime.
+	 */
+	template<class Type>
+	size_t FindString(const Type* pHaystack, size_t haystackLength, const Type* pNeedle, size_t needleLength)
+	{
+		if (!needleLength || needleLength > haystackLength)
+			return haystackLength;
+
+#ifdef SIMD_X86
+		switch (SIMD::GetLevel())
+		{
+		case SIMD::Level::AVX512:
+		case SIMD::Level::AVX2:
+			return AVX2::FindString(pHaystack, haystackLength, pNeedle, needleLength);
+
+		case SIMD::Level::SSE42:
+			return SSE42::FindString(pHaystack, haystackLength, pNeedle, needleLength);
+
+		default:
+			break;
+		}
+
+#endif // SIMD_X86
+
+		return Scalar::FindString(pHaystack, haystackLength, pNeedle, needleLength);
+	}
+
+	/**
+	 * Check if two blocks of characters are equal.
+	 * The standard libraries already implement memcmp using the widest available vector instructions, and it was
+	 * measured to be faster than SSE4.2 and AVX2 loops, so no vectorized version is provided.
+	 */
+	template<class Type>
+	bool Equal(const Type* pLeft, const Type* pRight, size_t count)
+	{
+		return Scalar::Equal(pLeft, pRight, count);
+	}
+}
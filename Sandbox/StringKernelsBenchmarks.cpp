@@ -0,0 +1,160 @@
+#include "String.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+/**
+ * Create a haystack of random lowercase letters, ending with a needle which does not appear anywhere else.
+ * The characters are drawn from a small alphabet so that the first and last characters of the needle match often.
+ *
+ * @param length: The number of characters.
+ * @param needle: The needle placed at the end of the haystack.
+ */
+static String::TypeSTD CreateHaystack(size_t length, const String::TypeSTD& needle)
+{
+	String::TypeSTD haystack(length - needle.size(), TEXT('a'));
+
+	std::mt19937 engine(static_cast<uint32_t>(length));
+	std::uniform_int_distribution<int> distribution(0, 7);
+	for (auto& character : haystack)
+		character = static_cast<String::Type>(TEXT('a') + distribution(engine));
+
+	return haystack + needle;
+}
+
+/**
+ * Set the instruction set level of a benchmark (the first argument). Returns false if the CPU does not support it.
+ *
+ * @param state: The benchmark state.
+ * @param previous: The variable to store the previous level in.
+ */
+static bool SetLevel(benchmark::State& state, SIMD::Level& previous)
+{
+	previous = SIMD::LevelOverride();
+	SIMD::LevelOverride() = static_cast<SIMD::Level>(state.range(0));
+	if (SIMD::GetLevel() == SIMD::LevelOverride())
+		return true;
+
+	SIMD::LevelOverride() = previous;
+	state.SkipWithError("The instruction set level is not supported by this CPU.");
+	return false;
+}
+
+/**
+ * Arguments: the scalar, SSE4.2 and AVX2 levels with haystacks from 1 KiB to 16 MiB (in characters).
+ */
+static void HaystackArguments(benchmark::internal::Benchmark* pBenchmark)
+{
+	pBenchmark->ArgNames({ "level", "length" });
+	for (int64_t level = 0; level <= static_cast<int64_t>(SIMD::Level::AVX2); level++)
+		for (int64_t length = 1 << 10; length <= (16 << 20); length *= 16)
+			pBenchmark->Args({ level, length });
+}
+
+/**
+ * Arguments: haystacks from 1 KiB to 16 MiB (in characters).
+ */
+static void StandardArguments(benchmark::internal::Benchmark* pBenchmark)
+{
+	pBenchmark->ArgNames({ "length" });
+	for (int64_t length = 1 << 10; length <= (16 << 20); length *= 16)
+		pBenchmark->Args({ length });
+}
+
+static const String::TypeSTD Needle = TEXT("hgfedcbaz");
+
+/**
+ * Measure String::GetStrLength.
+ */
+static void BM_StringLength(benchmark::State& state)
+{
+	SIMD::Level previous;
+	if (!SetLevel(state, previous))
+		return;
+
+	const String::TypeSTD haystack = CreateHaystack(static_cast<size_t>(state.range(1)), Needle);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(String::GetStrLength(haystack.c_str()));
+
+	SIMD::LevelOverride() = previous;
+	state.SetBytesProcessed(state.iterations() * state.range(1) * sizeof(String::Type));
+}
+BENCHMARK(BM_StringLength)->Apply(HaystackArguments);
+
+/**
+ * Measure std::char_traits::length as a reference.
+ */
+static void BM_StringLengthStandard(benchmark::State& state)
+{
+	const String::TypeSTD haystack = CreateHaystack(static_cast<size_t>(state.range(0)), Needle);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(std::char_traits<String::Type>::length(haystack.c_str()));
+
+	state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(String::Type));
+}
+BENCHMARK(BM_StringLengthStandard)->Apply(StandardArguments);
+
+/**
+ * Measure String::find(Type) with the character at the end of the haystack.
+ */
+static void BM_StringFindCharacter(benchmark::State& state)
+{
+	SIMD::Level previous;
+	if (!SetLevel(state, previous))
+		return;
+
+	const String string(CreateHaystack(static_cast<size_t>(state.range(1)), Needle).c_str());
+	for (auto _ : state)
+		benchmark::DoNotOptimize(string.find(TEXT('z')));
+
+	SIMD::LevelOverride() = previous;
+	state.SetBytesProcessed(state.iterations() * state.range(1) * sizeof(String::Type));
+}
+BENCHMARK(BM_StringFindCharacter)->Apply(HaystackArguments);
+
+/**
+ * Measure String::find(String) with the needle at the end of the haystack.
+ */
+static void BM_StringFindString(benchmark::State& state)
+{
+	SIMD::Level previous;
+	if (!SetLevel(state, previous))
+		return;
+
+	const String string(CreateHaystack(static_cast<size_t>(state.range(1)), Needle).c_str());
+	const String needle(Needle.c_str());
+	for (auto _ : state)
+		benchmark::DoNotOptimize(string.find(needle));
+
+	SIMD::LevelOverride() = previous;
+	state.SetBytesProcessed(state.iterations() * state.range(1) * sizeof(String::Type));
+}
+BENCHMARK(BM_StringFindString)->Apply(HaystackArguments);
+
+/**
+ * Measure std::basic_string::find as a reference.
+ */
+static void BM_StringFindStringStandard(benchmark::State& state)
+{
+	const String::TypeSTD haystack = CreateHaystack(static_cast<size_t>(state.range(0)), Needle);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(haystack.find(Needle));
+
+	state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(String::Type));
+}
+BENCHMARK(BM_StringFindStringStandard)->Apply(StandardArguments);
+
+/**
+ * Measure String::operator== on two equal strings.
+ */
+static void BM_StringEqual(benchmark::State& state)
+{
+	const String::TypeSTD haystack = CreateHaystack(static_cast<size_t>(state.range(0)), Needle);
+	const String first(haystack.c_str());
+	const String second(haystack.c_str());
+	for (auto _ : state)
+		benchmark::DoNotOptimize(first == second);
+
+	state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(String::Type));
+}
+BENCHMARK(BM_StringEqual)->Apply(StandardArguments);
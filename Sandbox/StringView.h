@@ -0,0 +1,477 @@
+#pragma once
+#include "Hash.h"
+#include "NumberConversion.h"
+#include "StringKernels.h"
+
+#include <string>
+
+/**
+ * Non owning view of a sequence of characters.
+ * The view is a pointer and a length, so creating, copying and slicing it never allocates. The characters are not
+ * required to be null terminated and must outlive the view.
+ *
+ * The indexes follow the String conventions: negative indexes count from the back, and searching returns -1 if
+ * nothing is found.
+ *
+ * @tparam Type: The character type (char or wchar_t).
+ */
+template<class Type>
+class BasicStringView {
+	/**
+	 * Get the number of characters a delimiter spans.
+	 */
+	static constexpr size_t DelimiterLength(Type) noexcept { return 1; }
+	static constexpr size_t DelimiterLength(BasicStringView<Type> delimiter) noexcept { return delimiter.size(); }
+
+public:
+	// String standard type.
+	using TypeSTD = std::basic_string<Type, std::char_traits<Type>, std::allocator<Type>>;
+
+	/**
+	 * Range of the tokens of a view separated by a delimiter.
+	 * Every delimiter splits the view, so N delimiters always produce N + 1 tokens, some of which may be empty.
+	 *
+	 * @tparam Delimiter: The delimiter type (a character or a view).
+	 */
+	template<class Delimiter>
+	class SplitRange {
+	public:
+		/**
+		 * Forward iterator over the tokens.
+		 */
+		class Iterator {
+		public:
+			/**
+			 * Construct the end iterator.
+			 */
+			constexpr Iterator() = default;
+
+			/**
+			 * Construct the iterator pointing to the first token.
+			 *
+			 * @param source: The view to be split.
+			 * @param delimiter: The delimiter.
+			 */
+			constexpr Iterator(BasicStringView<Type> source, Delimiter delimiter) : mRemaining(source), mDelimiter(delimiter), bFinished(false) { advance(); }
+
+			/**
+			 * Get the current token.
+			 */
+			constexpr BasicStringView<Type> operator*() const noexcept { return mToken; }
+
+			/**
+			 * Move to the next token.
+			 */
+			constexpr Iterator& operator++()
+			{
+				advance();
+				return *this;
+			}
+
+			/**
+			 * Is equal to operator.
+			 *
+			 * @param other: The other iterator.
+			 */
+			constexpr bool operator==(const Iterator& other) const noexcept
+			{
+				return bFinished == other.bFinished && (bFinished || mToken.data() == other.mToken.data());
+			}
+
+			/**
+			 * Is not equal to operator.
+			 *
+			 * @param other: The other iterator.
+			 */
+			constexpr bool operator!=(const Iterator& other) const noexcept { return !(*this == other); }
+
+		private:
+			/**
+			 * Cut the next token from the remaining characters.
+			 */
+			constexpr void advance()
+			{
+				if (!bHasRemaining)
+				{
+					bFinished = true;
+					return;
+				}
+
+				const long long index = DelimiterLength(mDelimiter) ? mRemaining.find(mDelimiter) : -1;
+				if (index < 0)
+				{
+					// The last token is the rest of the view.
+					mToken = mRemaining;
+					bHasRemaining = false;
+				}
+				else
+				{
+					mToken = BasicStringView<Type>(mRemaining.data(), static_cast<size_t>(index));
+					mRemaining = mRemaining.subView(index + DelimiterLength(mDelimiter));
+				}
+			}
+
+		private:
+			BasicStringView<Type> mRemaining = {};	// The characters after the current token and its delimiter.
+			BasicStringView<Type> mToken = {};		// The current token.
+			Delimiter mDelimiter = {};				// The delimiter.
+			bool bHasRemaining = true;				// Whether a delimiter followed the current token.
+			bool bFinished = true;					// Whether the iterator is past the last token.
+		};
+
+	public:
+		/**
+		 * Construct the range.
+		 *
+		 * @param source: The view to be split.
+		 * @param delimiter: The delimiter.
+		 */
+		constexpr SplitRange(BasicStringView<Type> source, Delimiter delimiter) noexcept : mSource(source), mDelimiter(delimiter) {}
+
+		/**
+		 * Begin iterator of the tokens.
+		 */
+		constexpr Iterator begin() const { return Iterator(mSource, mDelimiter); }
+
+		/**
+		 * End iterator of the tokens.
+		 */
+		constexpr Iterator end() const noexcept { return Iterator(); }
+
+	private:
+		BasicStringView<Type> mSource;
+		Delimiter mDelimiter;
+	};
+
+public:
+	/**
+	 * Default constructor.
+	 */
+	constexpr BasicStringView() noexcept = default;
+
+	/**
+	 * Construct the view using a number of characters.
+	 *
+	 * @param pString: The characters.
+	 * @param length: The number of characters.
+	 */
+	constexpr BasicStringView(const Type* pString, size_t length) noexcept : pString(pString), length(length) {}
+
+	/**
+	 * Construct the view using a null terminated primitive string.
+	 *
+	 * @param pString: The primitive string. This can be nullptr.
+	 */
+	constexpr BasicStringView(const Type* pString) noexcept : pString(pString), length(GetLength(pString)) {}
+
+	/**
+	 * Construct the view using a standard template string.
+	 *
+	 * @param str: The standard template string.
+	 */
+	BasicStringView(const TypeSTD& str) noexcept : pString(str.data()), length(str.size()) {}
+
+	/**
+	 * Get the characters of the view. These are not null terminated.
+	 */
+	constexpr const Type* data() const noexcept { return pString; }
+
+	/**
+	 * Get the size of the primitive type in bytes.
+	 */
+	static constexpr size_t typeSize() noexcept { return sizeof(Type); }
+
+	/**
+	 * Get the number of characters.
+	 */
+	constexpr size_t size() const noexcept { return length; }
+
+	/**
+	 * Check if the view is empty.
+	 */
+	constexpr bool empty() const noexcept { return length == 0; }
+
+	/**
+	 * Begin iterator method.
+	 */
+	constexpr const Type* begin() const noexcept { return pString; }
+
+	/**
+	 * The end iterator method.
+	 */
+	constexpr const Type* end() const noexcept { return pString + length; }
+
+	/**
+	 * Access a character in a given index.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	constexpr Type at(long long index) const noexcept { return pString[resolveIndex(index)]; }
+
+	/**
+	 * Create a view of a part of this view.
+	 * The view spans View[startIndex] to View[endIndex - 1] inclusive.
+	 *
+	 * @param startIndex: The index of the first character.
+	 * @param endIndex: The index after the last character.
+	 */
+	constexpr BasicStringView<Type> subView(long long startIndex, long long endIndex) const noexcept
+	{
+		const size_t start = resolveIndex(startIndex);
+		return BasicStringView<Type>(pString + start, resolveIndex(endIndex) - start);
+	}
+
+	/**
+	 * Create a view of the characters from an index to the end.
+	 *
+	 * @param startIndex: The index of the first character.
+	 */
+	constexpr BasicStringView<Type> subView(long long startIndex) const noexcept
+	{
+		const size_t start = resolveIndex(startIndex);
+		return BasicStringView<Type>(pString + start, length - start);
+	}
+
+	/**
+	 * Find if a character is present in the view and return its index if found.
+	 * The method returns -1 if the character is not found.
+	 *
+	 * @param character: The character to be searched.
+	 */
+	constexpr long long find(Type character) const
+	{
+		size_t index = 0;
+		if (std::is_constant_evaluated())
+			index = ConstantFind(pString, length, &character, 1);
+		else
+			index = ArrayKernels::Find(pString, length, character);
+
+		return index == length ? -1 : static_cast<long long>(index);
+	}
+
+	/**
+	 * Find if a view is present in this view and return the index of the first character if found.
+	 * The method returns -1 if the view is not found or if it is empty.
+	 *
+	 * @param view: The view to be searched for.
+	 */
+	constexpr long long find(BasicStringView<Type> view) const
+	{
+		if (!view.length || view.length > length)
+			return -1;
+
+		size_t index = 0;
+		if (std::is_constant_evaluated())
+			index = ConstantFind(pString, length, view.pString, view.length);
+		else
+			index = StringKernels::FindString(pString, length, view.pString, view.length);
+
+		return index == length ? -1 : static_cast<long long>(index);
+	}
+
+	/**
+	 * Check if the view starts with another view.
+	 *
+	 * @param view: The prefix.
+	 */
+	constexpr bool startsWith(BasicStringView<Type> view) const
+	{
+		return view.length <= length && BasicStringView<Type>(pString, view.length) == view;
+	}
+
+	/**
+	 * Check if the view ends with another view.
+	 *
+	 * @param view: The suffix.
+	 */
+	constexpr bool endsWith(BasicStringView<Type> view) const
+	{
+		return view.length <= length && BasicStringView<Type>(pString + length - view.length, view.length) == view;
+	}
+
+	/**
+	 * Split the view using a delimiter character.
+	 *
+	 * @param delimiter: The delimiter.
+	 */
+	constexpr SplitRange<Type> split(Type delimiter) const noexcept { return SplitRange<Type>(*this, delimiter); }
+
+	/**
+	 * Split the view using a delimiter view. An empty delimiter does not split the view.
+	 *
+	 * @param delimiter: The delimiter. The characters must outlive the range.
+	 */
+	constexpr SplitRange<BasicStringView<Type>> split(BasicStringView<Type> delimiter) const noexcept { return SplitRange<BasicStringView<Type>>(*this, delimiter); }
+
+	/**
+	 * Generate a hash using the characters.
+	 *
+	 * @tparam Algorithm: The hash algorithm (see Hashing).
+	 * @param seed: The seed.
+	 */
+	template<class Algorithm = Hashing::DefaultHash>
+	size_t hash(uint64_t seed = 0) const noexcept
+	{
+		return static_cast<size_t>(Hashing::HashBytes<Algorithm>(pString, length * typeSize(), seed));
+	}
+
+	/**
+	 * Parse the view as an integer.
+	 * The whole view must be the number. Returns false and leaves the value unchanged if it is not a number or does
+	 * not fit the type.
+	 *
+	 * @tparam Integer: The integer type.
+	 * @param value: The parsed value.
+	 * @param base: The base, from 2 to 36.
+	 */
+	template<class Integer>
+	bool parseInt(Integer& value, int base = 10) const
+	{
+		return NumberConversion::ParseInteger(pString, length, value, base);
+	}
+
+	/**
+	 * Parse the view as a floating point value.
+	 * The whole view must be the number. Returns false and leaves the value unchanged if it is not a number or is
+	 * out of range.
+	 *
+	 * @tparam Float: The floating point type.
+	 * @param value: The parsed value.
+	 */
+	template<class Float>
+	bool parseFloat(Float& value) const
+	{
+		return NumberConversion::ParseFloat(pString, length, value);
+	}
+
+	/**
+	 * Convert the view to the standard template string object.
+	 */
+	TypeSTD toStandard() const { return TypeSTD(pString, length); }
+
+public:
+	/**
+	 * Index operator.
+	 *
+	 * @param index: The index to be accessed.
+	 */
+	constexpr Type operator[](long long index) const noexcept { return at(index); }
+
+	/**
+	 * Is equal operator.
+	 *
+	 * @param other: The other view.
+	 */
+	constexpr bool operator==(BasicStringView<Type> other) const
+	{
+		if (length != other.length)
+			return false;
+
+		if (std::is_constant_evaluated())
+			return ConstantFind(pString, length, other.pString, length) == 0;
+
+		return StringKernels::Equal(pString, other.pString, length);
+	}
+
+	/**
+	 * Is not equal operator.
+	 *
+	 * @param other: The other view.
+	 */
+	constexpr bool operator!=(BasicStringView<Type> other) const { return !(*this == other); }
+
+private:
+	/**
+	 * Get the length of a primitive string.
+	 *
+	 * @param pString: The primitive string. This can be nullptr.
+	 */
+	static constexpr size_t GetLength(const Type* pString) noexcept
+	{
+		if (!pString)
+			return 0;
+
+		if (std::is_constant_evaluated())
+			return std::char_traits<Type>::length(pString);
+
+		return StringKernels::Length(pString);
+	}
+
+	/**
+	 * Find the index of the first occurrence of a needle in a haystack, in constant expressions where the kernels
+	 * cannot be used. Returns haystackLength if the needle is not found.
+	 *
+	 * @param pHaystack: The characters to search in.
+	 * @param haystackLength: The number of characters in the haystack.
+	 * @param pNeedle: The characters to search for.
+	 * @param needleLength: The number of characters in the needle.
+	 */
+	static constexpr size_t ConstantFind(const Type* pHaystack, size_t haystackLength, const Type* pNeedle, size_t needleLength) noexcept
+	{
+		for (size_t index = 0; index + needleLength <= haystackLength; index++)
+		{
+			size_t matched = 0;
+			while (matched < needleLength && pHaystack[index + matched] == pNeedle[matched])
+				matched++;
+
+			if (matched == needleLength)
+				return index;
+		}
+
+		return haystackLength;
+	}
+
+	/**
+	 * Convert a possibly negative index to a character index.
+	 *
+	 * @param index: The index.
+	 */
+	constexpr size_t resolveIndex(long long index) const noexcept
+	{
+		return index < 0 ? length + index : static_cast<size_t>(index);
+	}
+
+private:
+	const Type* pString = nullptr;	// The first character.
+	size_t length = 0;				// The number of characters.
+};
+
+#ifdef USE_WCHAR
+	// String view using the primitive type of the String.
+	using StringView = BasicStringView<wchar_t>;
+
+#else
+	// String view using the primitive type of the String.
+	using StringView = BasicStringView<char>;
+
+#endif // USE_WCHAR
+
+/**
+ * Standard hash specialization, so that views can be used as keys of the standard containers.
+ */
+template<class Type>
+struct std::hash<BasicStringView<Type>> {
+	size_t operator()(BasicStringView<Type> view) const noexcept { return view.hash(); }
+};
+
+/**
+ * Compile time checks of the string view.
+ */
+namespace StringViewChecks {
+	/**
+	 * Count the tokens of a comma separated list at compile time.
+	 */
+	constexpr size_t CountTokens(BasicStringView<char> list)
+	{
+		size_t count = 0;
+		for (const auto token : list.split(','))
+			count += token.size() ? 1 : 0;
+
+		return count;
+	}
+
+	static_assert(BasicStringView<char>("position,normal,,uv").subView(9, -4) == "normal", "subView failed!");
+	static_assert(BasicStringView<char>("vertex.glsl").endsWith(".glsl") && BasicStringView<char>("vertex.glsl").startsWith("vertex"), "Prefix or suffix check failed!");
+	static_assert(BasicStringView<char>("a::b::c").find("::") == 1 && BasicStringView<char>("a::b::c").find('c') == 6, "find failed!");
+	static_assert(CountTokens("position,normal,,uv") == 3, "split failed!");
+}
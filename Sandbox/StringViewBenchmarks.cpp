@@ -0,0 +1,109 @@
+#include "String.h"
+
+#include <benchmark/benchmark.h>
+
+/**
+ * Create a comma separated list of shader attribute names, as a parser would receive it.
+ *
+ * @param count: The number of names.
+ */
+static String CreateAttributeList(size_t count)
+{
+	const String::Type* const pNames[] = { TEXT("position"), TEXT("normal"), TEXT("uv"), TEXT("tangent"), TEXT("color") };
+
+	String list;
+	for (size_t index = 0; index < count; index++)
+	{
+		if (index)
+			list += TEXT(",");
+
+		list += pNames[index % 5];
+	}
+
+	return list;
+}
+
+/**
+ * Tokenize the list using subString, comparing every token against a keyword.
+ */
+static void BM_StringTokenizeSubString(benchmark::State& state)
+{
+	const String list = CreateAttributeList(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		size_t matches = 0;
+		long long start = 0;
+		for (long long index = 0; index <= static_cast<long long>(list.size()); index++)
+		{
+			if (index == static_cast<long long>(list.size()) || list[index] == TEXT(','))
+			{
+				if (list.subString(start, index) == TEXT("normal"))
+					matches++;
+
+				start = index + 1;
+			}
+		}
+
+		benchmark::DoNotOptimize(matches);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StringTokenizeSubString)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+/**
+ * Tokenize the list using a split view, comparing every token against a keyword.
+ */
+static void BM_StringTokenizeSplitView(benchmark::State& state)
+{
+	const String list = CreateAttributeList(static_cast<size_t>(state.range(0)));
+	const StringView keyword = TEXT("normal");
+
+	for (auto _ : state)
+	{
+		size_t matches = 0;
+		for (const StringView token : list.view().split(TEXT(',')))
+			if (token == keyword)
+				matches++;
+
+		benchmark::DoNotOptimize(matches);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StringTokenizeSplitView)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+/**
+ * Tokenize the list using std::basic_string_view for reference.
+ */
+static void BM_StandardStringTokenizeView(benchmark::State& state)
+{
+	const String::TypeSTD list = CreateAttributeList(static_cast<size_t>(state.range(0))).toStandard();
+	const std::basic_string_view<String::Type> keyword = TEXT("normal");
+
+	for (auto _ : state)
+	{
+		size_t matches = 0;
+		std::basic_string_view<String::Type> remaining = list;
+		while (true)
+		{
+			const size_t index = remaining.find(TEXT(','));
+			if (remaining.substr(0, index) == keyword)
+				matches++;
+
+			if (index == remaining.npos)
+				break;
+
+			remaining.remove_prefix(index + 1);
+		}
+
+		benchmark::DoNotOptimize(matches);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StandardStringTokenizeView)->RangeMultiplier(16)->Range(16, 1 << 16);
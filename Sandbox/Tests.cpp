@@ -0,0 +1,1877 @@
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <Windows.h>
+
+	// String.h defines its own TEXT macro.
+	#undef TEXT
+
+#else
+	#include <sys/mman.h>
+	#include <unistd.h>
+
+#endif // _WIN32
+
+#include "ArrayKernels.h"
+#include "FastMap.h"
+#include "Hash.h"
+#include "IntegralVectorMap.h"
+#include "InternedString.h"
+#include "Parallel.h"
+#include "SharedString.h"
+#include "SlotMap.h"
+#include "SmallArray.h"
+#include "SoAArray.h"
+#include "String.h"
+#include "StringBuilder.h"
+#include "StringKernels.h"
+#include "Unicode.h"
+#include "VectorMap.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Minimal test runner.
+ * Tests are registered with TEST_CASE and fail by throwing from TEST_CHECK. RunTests() is called by Client.cpp when
+ * the application is started with "--test".
+ */
+namespace
+{
+	/**
+	 * Registered test.
+	 */
+	struct TestCase {
+		const char* pName = nullptr;
+		void (*pFunction)() = nullptr;
+	};
+
+	/**
+	 * Exception thrown by a failing check.
+	 */
+	struct TestFailure : std::runtime_error {
+		using std::runtime_error::runtime_error;
+	};
+
+	/**
+	 * Get the registered tests.
+	 */
+	std::vector<TestCase>& GetTestCases()
+	{
+		static std::vector<TestCase> testCases;
+		return testCases;
+	}
+
+	/**
+	 * Register a test when constructed.
+	 */
+	struct TestRegistrar {
+		TestRegistrar(const char* pName, void (*pFunction)()) { GetTestCases().push_back({ pName, pFunction }); }
+	};
+
+	/**
+	 * Throw a test failure with the location of the check.
+	 */
+	[[noreturn]] void FailCheck(const char* pCondition, const char* pFile, int line)
+	{
+		char message[512] = {};
+		std::snprintf(message, sizeof(message), "%s:%d: check failed: %s", pFile, line, pCondition);
+		throw TestFailure(message);
+	}
+}
+
+#define TEST_CASE(name)																	\
+	static void name();																	\
+	static const TestRegistrar name##Registrar(#name, name);							\
+	static void name()
+
+#define TEST_CHECK(...)																	\
+	do { if (!(__VA_ARGS__)) FailCheck(#__VA_ARGS__, __FILE__, __LINE__); } while (false)
+
+#define TEST_CHECK_THROWS(expression, exception)										\
+	do {																				\
+		bool bThrown = false;															\
+		try { expression; }																\
+		catch (const exception&) { bThrown = true; }									\
+		if (!bThrown) FailCheck(#expression " throws " #exception, __FILE__, __LINE__);	\
+	} while (false)
+
+/**
+ * Run a function once for every SIMD level, forcing the level through SIMD::LevelOverride(). Levels which are not
+ * supported by the CPU run the highest supported one instead.
+ */
+template<class Function>
+static void ForEachSIMDLevel(Function&& function)
+{
+	struct LevelRestorer {
+		~LevelRestorer() { SIMD::LevelOverride() = SIMD::Level::AVX512; }
+	} restorer;
+
+	for (SIMD::Level level : { SIMD::Level::Scalar, SIMD::Level::SSE42, SIMD::Level::AVX2, SIMD::Level::AVX512 })
+	{
+		SIMD::LevelOverride() = level;
+		function();
+	}
+}
+
+/**
+ * Memory block which is directly followed by an inaccessible page, so reading past its end faults.
+ */
+class GuardedBuffer {
+public:
+	/**
+	 * Construct the buffer.
+	 *
+	 * @param pageCount: The number of accessible pages.
+	 */
+	explicit GuardedBuffer(size_t pageCount)
+	{
+#ifdef _WIN32
+		SYSTEM_INFO info = {};
+		GetSystemInfo(&info);
+		mPageSize = info.dwPageSize;
+		mByteSize = mPageSize * pageCount;
+
+		mpBlock = static_cast<std::byte*>(VirtualAlloc(nullptr, mByteSize + mPageSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+		DWORD oldProtection = 0;
+		VirtualProtect(mpBlock + mByteSize, mPageSize, PAGE_NOACCESS, &oldProtection);
+
+#else
+		mPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		mByteSize = mPageSize * pageCount;
+
+		mpBlock = static_cast<std::byte*>(mmap(nullptr, mByteSize + mPageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+		mprotect(mpBlock + mByteSize, mPageSize, PROT_NONE);
+
+#endif // _WIN32
+	}
+
+	/**
+	 * Default destructor.
+	 */
+	~GuardedBuffer()
+	{
+#ifdef _WIN32
+		VirtualFree(mpBlock, 0, MEM_RELEASE);
+
+#else
+		munmap(mpBlock, mByteSize + mPageSize);
+
+#endif // _WIN32
+	}
+
+	GuardedBuffer(const GuardedBuffer&) = delete;
+	GuardedBuffer& operator=(const GuardedBuffer&) = delete;
+
+	/**
+	 * Get the first accessible byte.
+	 */
+	std::byte* begin() const noexcept { return mpBlock; }
+
+	/**
+	 * Get the first byte of the guard page.
+	 */
+	std::byte* end() const noexcept { return mpBlock + mByteSize; }
+
+	/**
+	 * Get the size of a page.
+	 */
+	size_t pageSize() const noexcept { return mPageSize; }
+
+private:
+	std::byte* mpBlock = nullptr;
+	size_t mByteSize = 0;
+	size_t mPageSize = 0;
+};
+
+/**
+ * Value which counts its live instances and throws from its copy constructor when the copy budget runs out.
+ *
+ * @tparam NothrowMove: Whether the move constructor is noexcept. Containers copy values which may throw while moving.
+ */
+template<bool NothrowMove>
+struct BasicThrowingValue {
+	static inline long long sLiveCount = 0;
+	static inline long long sCopyBudget = -1;
+
+	int value = 0;
+
+	BasicThrowingValue() { sLiveCount++; }
+	explicit BasicThrowingValue(int value) : value(value) { sLiveCount++; }
+	BasicThrowingValue(BasicThrowingValue&& other) noexcept(NothrowMove) : value(other.value) { sLiveCount++; }
+	BasicThrowingValue(const BasicThrowingValue& other) : value(other.value)
+	{
+		if (sCopyBudget == 0)
+			throw std::runtime_error("copy failed");
+
+		sCopyBudget--;
+		sLiveCount++;
+	}
+
+	~BasicThrowingValue() { sLiveCount--; }
+
+	BasicThrowingValue& operator=(const BasicThrowingValue& other) = default;
+};
+
+using ThrowingValue = BasicThrowingValue<true>;
+
+/**
+ * Run all the registered tests.
+ *
+ * @return The number of failed tests.
+ */
+int RunTests()
+{
+	int failures = 0;
+	for (const TestCase& testCase : GetTestCases())
+	{
+		try
+		{
+			testCase.pFunction();
+			std::printf("[ PASSED ] %s\n", testCase.pName);
+		}
+		catch (const std::exception& exception)
+		{
+			std::printf("[ FAILED ] %s\n    %s\n", testCase.pName, exception.what());
+			failures++;
+		}
+	}
+
+	std::printf("%zu tests, %d failed\n", GetTestCases().size(), failures);
+	return failures;
+}
+
+////////// Parallel //////////
+
+TEST_CASE(ParallelForRethrowsTheCallerChunkException)
+{
+	ThreadPool pool(4);
+	std::atomic<size_t> visited = 0;
+
+	// The calling thread always runs the first chunk, so it throws after the other halves were queued.
+	for (int iteration = 0; iteration < 100; iteration++)
+	{
+		visited = 0;
+		TEST_CHECK_THROWS(parallelFor(0, 1 << 16, [&](size_t first, size_t last)
+			{
+				if (first == 0)
+					throw std::logic_error("caller chunk");
+
+				visited.fetch_add(last - first);
+			}, 256, pool), std::logic_error);
+
+		// Every other chunk has finished by the time the exception reaches the caller.
+		TEST_CHECK(visited.load() == (1 << 16) - 256);
+	}
+}
+
+TEST_CASE(ParallelForRethrowsATaskException)
+{
+	ThreadPool pool(4);
+
+	TEST_CHECK_THROWS(parallelFor(0, 1 << 16, [&](size_t first, size_t)
+		{
+			if (first == (1 << 15))
+				throw std::logic_error("task chunk");
+		}, 256, pool), std::logic_error);
+}
+
+TEST_CASE(ParallelReduceMatchesSequentialReduce)
+{
+	ThreadPool pool(4);
+	std::mt19937 random(1);
+
+	for (const size_t count : { 0, 1, 100, 1000, 10007 })
+	{
+		Array<int> values(count);
+		for (int& value : values)
+			value = static_cast<int>(random() % 1000) - 500;
+
+		const int expected = std::accumulate(values.begin(), values.end(), 0);
+		for (const size_t grainSize : { 0, 1, 7, 256, 100000 })
+			TEST_CHECK(parallelReduce(values, 0, [](int sum, int value) { return sum + value; }, grainSize, pool) == expected);
+	}
+}
+
+TEST_CASE(ParallelReduceIntoAnotherTypeCombinesTheChunkResults)
+{
+	ThreadPool pool(4);
+
+	Array<std::string> strings;
+	size_t expected = 0;
+	for (size_t index = 0; index < 1000; index++)
+	{
+		strings.pushBack(std::string(index % 37, 'x'));
+		expected += index % 37;
+	}
+
+	for (const size_t grainSize : { 1, 7, 256, 100000 })
+	{
+		const size_t length = parallelReduce(strings, size_t(0),
+			[](size_t sum, const std::string& string) { return sum + string.size(); },
+			[](size_t first, size_t second) { return first + second; }, grainSize, pool);
+		TEST_CHECK(length == expected);
+	}
+}
+
+TEST_CASE(ParallelSortMatchesStandardSort)
+{
+	ThreadPool pool(4);
+	std::mt19937 random(2);
+
+	for (const size_t count : { 0, 1, 100, 1000, 10007 })
+	{
+		for (const size_t grainSize : { 1, 7, 256, 100000 })
+		{
+			// Few distinct values, so there are many duplicates.
+			Array<int> values(count);
+			for (int& value : values)
+				value = static_cast<int>(random() % 100);
+
+			std::vector<int> expected(values.begin(), values.end());
+			std::sort(expected.begin(), expected.end());
+			parallelSort(values, std::less<int>(), grainSize, pool);
+			TEST_CHECK(std::equal(values.begin(), values.end(), expected.begin(), expected.end()));
+
+			std::sort(expected.begin(), expected.end(), std::greater<int>());
+			parallelSort(values, std::greater<int>(), grainSize, pool);
+			TEST_CHECK(std::equal(values.begin(), values.end(), expected.begin(), expected.end()));
+		}
+	}
+}
+
+TEST_CASE(ParallelScanMatchesInclusiveScan)
+{
+	ThreadPool pool(4);
+	std::mt19937 random(3);
+
+	for (const size_t count : { 0, 1, 100, 1000, 10007 })
+	{
+		for (const size_t grainSize : { 1, 7, 256, 100000 })
+		{
+			Array<int> values(count);
+			for (int& value : values)
+				value = static_cast<int>(random() % 1000) - 500;
+
+			std::vector<int> expected(count);
+			std::inclusive_scan(values.begin(), values.end(), expected.begin());
+
+			Array<int> scanned(count);
+			parallelScan(values.begin(), values.end(), scanned.begin(), 0, std::plus<int>(), grainSize, pool);
+			TEST_CHECK(std::equal(scanned.begin(), scanned.end(), expected.begin(), expected.end()));
+
+			// In place.
+			parallelScan(values, 0, std::plus<int>(), grainSize, pool);
+			TEST_CHECK(std::equal(values.begin(), values.end(), expected.begin(), expected.end()));
+		}
+	}
+}
+
+////////// SmallArray //////////
+
+TEST_CASE(SmallArrayElementsCanBeModifiedThroughIterators)
+{
+	// Both the inline and the heap storage.
+	for (const int count : { 4, 40 })
+	{
+		SmallArray<int, 8> array;
+		for (int value = 0; value < count; value++)
+			array.pushBack(value);
+
+		for (auto& element : array)
+			element *= 2;
+
+		int expected = 0;
+		for (const int element : array)
+		{
+			TEST_CHECK(element == expected);
+			expected += 2;
+		}
+	}
+}
+
+////////// SoAArray //////////
+
+TEST_CASE(SoAArrayPushBackIsExceptionSafe)
+{
+	{
+		SoAArray<int, ThrowingValue, ThrowingValue> array;
+		const ThrowingValue value(1);
+		array.reserve(4);
+
+		// The second field fails to copy, so the first one must be destroyed again.
+		ThrowingValue::sCopyBudget = 1;
+		TEST_CHECK_THROWS(array.pushBack(1, value, value), std::runtime_error);
+		TEST_CHECK(array.size() == 0);
+		TEST_CHECK(ThrowingValue::sLiveCount == 1);
+
+		ThrowingValue::sCopyBudget = -1;
+		array.pushBack(1, value, value);
+		TEST_CHECK(array.size() == 1);
+		TEST_CHECK(ThrowingValue::sLiveCount == 3);
+	}
+
+	TEST_CHECK(ThrowingValue::sLiveCount == 0);
+}
+
+TEST_CASE(SoAArrayReallocateIsExceptionSafe)
+{
+	using MayThrowValue = BasicThrowingValue<false>;
+
+	{
+		SoAArray<int, std::string, MayThrowValue> array;
+		for (int row = 0; row < 100; row++)
+			array.pushBack(row, std::string(40, static_cast<char>('a' + row % 26)), MayThrowValue(row));
+
+		// The last column fails to copy half way through, after the other columns could have been moved.
+		for (const long long copyBudget : { 0, 50, 99 })
+		{
+			MayThrowValue::sCopyBudget = copyBudget;
+			TEST_CHECK_THROWS(array.reserve(array.capacity() * 4), std::runtime_error);
+			MayThrowValue::sCopyBudget = -1;
+
+			TEST_CHECK(array.size() == 100);
+			TEST_CHECK(MayThrowValue::sLiveCount == 100);
+			for (int row = 0; row < 100; row++)
+			{
+				TEST_CHECK(array.column<0>()[row] == row);
+				TEST_CHECK(array.column<1>()[row] == std::string(40, static_cast<char>('a' + row % 26)));
+				TEST_CHECK(array.column<2>()[row].value == row);
+			}
+		}
+
+		array.reserve(array.capacity() * 4);
+		TEST_CHECK(MayThrowValue::sLiveCount == 100);
+		TEST_CHECK(array.column<2>()[99].value == 99);
+	}
+
+	TEST_CHECK(MayThrowValue::sLiveCount == 0);
+}
+
+////////// SlotMap //////////
+
+TEST_CASE(SlotMapDetectsStaleHandles)
+{
+	SlotMap<int> map;
+	const SlotHandle kept = map.insert(1);
+	const SlotHandle erased = map.insert(2);
+
+	TEST_CHECK(map.erase(erased));
+	TEST_CHECK(!map.erase(erased));
+
+	// The next insertion reuses the slot of the erased element.
+	const SlotHandle reused = map.insert(3);
+	TEST_CHECK(reused.index == erased.index);
+	TEST_CHECK(reused.generation != erased.generation);
+
+	TEST_CHECK(!map.contains(erased));
+	TEST_CHECK(map.get(erased) == nullptr);
+	TEST_CHECK(map.contains(reused) && *map.get(reused) == 3);
+	TEST_CHECK(map.contains(kept) && *map.get(kept) == 1);
+	TEST_CHECK(map.size() == 2);
+}
+
+TEST_CASE(SlotMapKeepsOldHandlesStaleWhileChurning)
+{
+	SlotMap<int> map;
+	Array<SlotHandle> oldHandles;
+
+	SlotHandle handle = map.insert(0);
+	for (int value = 1; value < 1000; value++)
+	{
+		oldHandles.pushBack(handle);
+		map.erase(handle);
+		handle = map.insert(value);
+
+		TEST_CHECK(handle.index == oldHandles[0].index);
+	}
+
+	for (const SlotHandle& oldHandle : oldHandles)
+		TEST_CHECK(!map.contains(oldHandle) && map.get(oldHandle) == nullptr);
+
+	TEST_CHECK(*map.get(handle) == 999);
+}
+
+TEST_CASE(SlotMapGenerationSkipsZeroOnWrapAround)
+{
+	TEST_CHECK(NextSlotGeneration(1) == 2);
+	TEST_CHECK(NextSlotGeneration(UINT32_MAX - 1) == UINT32_MAX);
+	TEST_CHECK(NextSlotGeneration(UINT32_MAX) == 1);
+
+	// A handle with the wrapped generation is never null.
+	TEST_CHECK(!SlotHandle{ 0, NextSlotGeneration(UINT32_MAX) }.isNull());
+}
+
+TEST_CASE(SlotMapEmplaceIsExceptionSafe)
+{
+	{
+		SlotMap<ThrowingValue> map;
+		const SlotHandle kept = map.insert(ThrowingValue(1));
+		const SlotHandle erased = map.insert(ThrowingValue(2));
+		TEST_CHECK(map.erase(erased));
+
+		// A failure while reusing a free slot keeps the slot free.
+		const ThrowingValue value(3);
+		ThrowingValue::sCopyBudget = 0;
+		TEST_CHECK_THROWS(map.emplace(value), std::runtime_error);
+		ThrowingValue::sCopyBudget = -1;
+
+		TEST_CHECK(map.size() == 1);
+		TEST_CHECK(map.contains(kept) && map.get(kept)->value == 1);
+		TEST_CHECK(!map.contains(erased));
+
+		const SlotHandle reused = map.emplace(value);
+		TEST_CHECK(reused.index == erased.index);
+		TEST_CHECK(map.contains(reused) && map.get(reused)->value == 3);
+
+		// A failure while adding a new slot drops the slot again.
+		ThrowingValue::sCopyBudget = 0;
+		TEST_CHECK_THROWS(map.emplace(value), std::runtime_error);
+		ThrowingValue::sCopyBudget = -1;
+
+		const SlotHandle added = map.emplace(value);
+		TEST_CHECK(added.index == 2);
+		TEST_CHECK(map.size() == 3);
+		TEST_CHECK(ThrowingValue::sLiveCount == 4);
+	}
+
+	TEST_CHECK(ThrowingValue::sLiveCount == 0);
+}
+
+////////// ArrayKernels //////////
+
+/**
+ * Check ArrayKernels::LowerBound against std::lower_bound on sorted integers of a type, with and without many
+ * duplicates, at unaligned starts, for values at and around every element and for the limits of the type.
+ */
+template<class Integer>
+static void CheckLowerBound()
+{
+	constexpr Integer Min = std::numeric_limits<Integer>::min();
+	constexpr Integer Max = std::numeric_limits<Integer>::max();
+	std::mt19937_64 engine(37);
+
+	for (const size_t count : { 0, 1, 2, 15, 16, 17, 63, 64, 65, 100, 257, 1000, 4099 })
+	{
+		for (const bool bDuplicates : { false, true })
+		{
+			std::vector<Integer> values(count + 3);
+			for (Integer& value : values)
+				value = static_cast<Integer>(bDuplicates ? engine() % 8 : engine());
+
+			if (count > 2)
+			{
+				values[0] = Min;
+				values[1] = Max;
+			}
+
+			std::sort(values.begin(), values.end());
+
+			for (const size_t offset : { 0, 1, 3 })
+			{
+				const Integer* pData = values.data() + offset;
+				const auto check = [&](Integer value)
+					{
+						const size_t expected = std::lower_bound(pData, pData + count, value) - pData;
+						TEST_CHECK(ArrayKernels::LowerBound(pData, count, value) == expected);
+					};
+
+				check(Min);
+				check(Max);
+				for (size_t index = 0; index < count; index++)
+				{
+					check(pData[index]);
+					if (pData[index] != Min)
+						check(static_cast<Integer>(pData[index] - 1));
+
+					if (pData[index] != Max)
+						check(static_cast<Integer>(pData[index] + 1));
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Check an IntegralVectorMap against a std::map through random insertions, erasures and lookups of keys of a type.
+ */
+template<class Key>
+static void CheckIntegralVectorMapAgainstStdMap()
+{
+	std::mt19937_64 engine(41);
+	IntegralVectorMap<Key, int> map;
+	std::map<Key, int> expected;
+
+	for (int operation = 0; operation < 2000; operation++)
+	{
+		// A small range of keys, so the operations often hit existing keys, and the limits of the type.
+		Key key = static_cast<Key>(engine() % 300);
+		if (operation % 97 == 0)
+			key = std::numeric_limits<Key>::min();
+		else if (operation % 89 == 0)
+			key = std::numeric_limits<Key>::max();
+
+		switch (engine() % 4)
+		{
+		case 0:
+		{
+			const auto [where, bInserted] = map.insert({ key, operation });
+			const auto [expectedWhere, bExpectedInserted] = expected.insert({ key, operation });
+			TEST_CHECK(bInserted == bExpectedInserted && where->first == key && where->second == expectedWhere->second);
+			break;
+		}
+
+		case 1:
+			map[key] = operation;
+			expected[key] = operation;
+			break;
+
+		case 2:
+			map.erase(key);
+			expected.erase(key);
+			break;
+
+		default:
+			if (map.lower_bound(key) != map.end())
+			{
+				map.erase(map.lower_bound(key));
+				expected.erase(expected.lower_bound(key));
+			}
+			break;
+		}
+
+		// The lookups are compared by the key they land on.
+		const auto lower = map.lower_bound(key);
+		const auto upper = map.upper_bound(key);
+		const auto expectedLower = expected.lower_bound(key);
+		const auto expectedUpper = expected.upper_bound(key);
+		TEST_CHECK(lower == map.end() ? expectedLower == expected.end() : (expectedLower != expected.end() && lower->first == expectedLower->first));
+		TEST_CHECK(upper == map.end() ? expectedUpper == expected.end() : (expectedUpper != expected.end() && upper->first == expectedUpper->first));
+		TEST_CHECK(map.count(key) == expected.count(key));
+		TEST_CHECK(map.find(key) == map.end() ? !expected.count(key) : map.find(key)->second == expected.at(key));
+	}
+
+	TEST_CHECK(map.size() == expected.size());
+	TEST_CHECK(std::equal(map.begin(), map.end(), expected.begin(), expected.end(),
+		[](const auto& entry, const auto& expectedEntry) { return entry.first == expectedEntry.first && entry.second == expectedEntry.second; }));
+}
+
+TEST_CASE(ArrayKernelsLowerBoundMatchesStandard)
+{
+	ForEachSIMDLevel([]
+		{
+			CheckLowerBound<int8_t>();
+			CheckLowerBound<uint8_t>();
+			CheckLowerBound<int16_t>();
+			CheckLowerBound<uint16_t>();
+			CheckLowerBound<int32_t>();
+			CheckLowerBound<uint32_t>();
+			CheckLowerBound<int64_t>();
+			CheckLowerBound<uint64_t>();
+		});
+}
+
+TEST_CASE(IntegralVectorMapMatchesStdMap)
+{
+	ForEachSIMDLevel([]
+		{
+			CheckIntegralVectorMapAgainstStdMap<int8_t>();
+			CheckIntegralVectorMapAgainstStdMap<uint16_t>();
+			CheckIntegralVectorMapAgainstStdMap<int32_t>();
+			CheckIntegralVectorMapAgainstStdMap<uint64_t>();
+		});
+}
+
+////////// StringKernels //////////
+
+/**
+ * Check StringKernels::Length against std::char_traits for strings which end right before a guard page or which
+ * cross a page boundary, for every length up to a few vector widths.
+ */
+template<class Type>
+static void CheckStringLengthNearPageBoundaries()
+{
+	GuardedBuffer buffer(2);
+	Type* pPageBoundary = reinterpret_cast<Type*>(buffer.begin() + buffer.pageSize());
+	Type* pGuard = reinterpret_cast<Type*>(buffer.end());
+
+	std::mt19937 engine(13);
+	std::uniform_int_distribution<int> distribution(1, 127);
+	for (Type* pCharacter = reinterpret_cast<Type*>(buffer.begin()); pCharacter != pGuard; pCharacter++)
+		*pCharacter = static_cast<Type>(distribution(engine));
+
+	ForEachSIMDLevel([&]
+		{
+			for (size_t length = 0; length <= 200; length++)
+			{
+				// The terminator is the last character before the guard page.
+				Type* pString = pGuard - length - 1;
+				const Type saved = pString[length];
+				pString[length] = Type();
+				TEST_CHECK(StringKernels::Length(pString) == std::char_traits<Type>::length(pString));
+				pString[length] = saved;
+
+				// The string starts shortly before a page boundary and ends after it.
+				for (size_t start = 1; start <= 70; start++)
+				{
+					pString = pPageBoundary - start;
+					const Type previous = pString[length];
+					pString[length] = Type();
+					TEST_CHECK(StringKernels::Length(pString) == std::char_traits<Type>::length(pString));
+					pString[length] = previous;
+				}
+			}
+		});
+}
+
+TEST_CASE(StringKernelsLengthMatchesStandardNearPageBoundaries)
+{
+	CheckStringLengthNearPageBoundaries<char>();
+	CheckStringLengthNearPageBoundaries<char16_t>();
+	CheckStringLengthNearPageBoundaries<char32_t>();
+}
+
+/**
+ * Check StringKernels::FindString against std::basic_string::find with random haystacks from a small alphabet, so
+ * partial and full matches are common. The haystacks end right before a guard page.
+ */
+template<class Type>
+static void CheckFindStringAgainstStandard()
+{
+	GuardedBuffer buffer(1);
+	Type* pGuard = reinterpret_cast<Type*>(buffer.end());
+
+	std::mt19937 engine(17);
+	std::uniform_int_distribution<int> character('a', 'd');
+
+	ForEachSIMDLevel([&]
+		{
+			for (int iteration = 0; iteration < 3000; iteration++)
+			{
+				const size_t haystackLength = engine() % 300;
+				const size_t needleLength = 1 + engine() % 40;
+
+				std::basic_string<Type> haystack(haystackLength, Type());
+				for (Type& element : haystack)
+					element = static_cast<Type>(character(engine));
+
+				// Take half of the needles from the haystack so that they are found.
+				std::basic_string<Type> needle(needleLength, Type());
+				if (needleLength <= haystackLength && engine() % 2)
+					needle = haystack.substr(engine() % (haystackLength - needleLength + 1), needleLength);
+				else
+					for (Type& element : needle)
+						element = static_cast<Type>(character(engine));
+
+				Type* pHaystack = pGuard - haystackLength;
+				std::char_traits<Type>::copy(pHaystack, haystack.data(), haystackLength);
+
+				const size_t expected = haystack.find(needle);
+				const size_t found = StringKernels::FindString(pHaystack, haystackLength, needle.data(), needleLength);
+				TEST_CHECK(found == (expected == std::basic_string<Type>::npos ? haystackLength : expected));
+			}
+		});
+}
+
+TEST_CASE(StringKernelsFindStringMatchesStandard)
+{
+	CheckFindStringAgainstStandard<char>();
+	CheckFindStringAgainstStandard<char16_t>();
+	CheckFindStringAgainstStandard<char32_t>();
+}
+
+////////// Hash //////////
+
+/**
+ * Calculate the chi-squared statistic of hashing 65536 keys into 1024 buckets. The bucket is taken from the low or
+ * the high 10 bits of the hash. The statistic has a mean of 1023 and a standard deviation of about 45 for a uniform
+ * hash.
+ *
+ * @param hash: The function which returns the hash of the key with an index.
+ * @param shift: The number of low bits to skip.
+ */
+template<class Function>
+static double BucketChiSquared(Function&& hash, uint32_t shift)
+{
+	constexpr size_t KeyCount = 1 << 16;
+	constexpr size_t BucketCount = 1 << 10;
+
+	std::vector<size_t> buckets(BucketCount);
+	for (uint64_t index = 0; index < KeyCount; index++)
+		buckets[(hash(index) >> shift) & (BucketCount - 1)]++;
+
+	const double expected = static_cast<double>(KeyCount) / BucketCount;
+	double chiSquared = 0.0;
+	for (const size_t count : buckets)
+		chiSquared += (count - expected) * (count - expected) / expected;
+
+	return chiSquared;
+}
+
+/**
+ * Maximum chi-squared statistic accepted by the distribution checks (six standard deviations above the mean).
+ */
+constexpr double MaximumChiSquared = 1023.0 + 6 * 45.2;
+
+/**
+ * Flip every bit of random keys and record how often every output bit flips with it.
+ *
+ * @param hash: The function which returns the hash of a key of keySize bytes.
+ * @param keySize: The size of the keys in bytes (up to 32).
+ * @param worstBias: Set to the largest distance of a flip probability from 0.5.
+ * @param minimumFlips: Set to the lowest mean number of output bits flipped by an input bit.
+ */
+template<class Function>
+static void MeasureAvalanche(Function&& hash, size_t keySize, double& worstBias, double& minimumFlips)
+{
+	constexpr size_t SampleCount = 10000;
+
+	std::mt19937_64 engine(23);
+	worstBias = 0.0;
+	minimumFlips = 64.0;
+
+	for (size_t inputBit = 0; inputBit < keySize * 8; inputBit++)
+	{
+		size_t flips[64] = {};
+		size_t totalFlips = 0;
+
+		for (size_t sample = 0; sample < SampleCount; sample++)
+		{
+			uint8_t key[32] = {};
+			for (size_t index = 0; index < keySize; index++)
+				key[index] = static_cast<uint8_t>(engine());
+
+			const uint64_t original = hash(key, keySize);
+			key[inputBit / 8] ^= static_cast<uint8_t>(1u << (inputBit % 8));
+			const uint64_t difference = original ^ hash(key, keySize);
+
+			for (size_t outputBit = 0; outputBit < 64; outputBit++)
+				flips[outputBit] += (difference >> outputBit) & 1;
+
+			totalFlips += SIMD::PopCount(difference);
+		}
+
+		for (const size_t count : flips)
+			worstBias = std::max(worstBias, std::abs(static_cast<double>(count) / SampleCount - 0.5));
+
+		minimumFlips = std::min(minimumFlips, static_cast<double>(totalFlips) / SampleCount);
+	}
+}
+
+TEST_CASE(HashWyHashDistributesKeysEvenly)
+{
+	for (const uint32_t shift : { 0u, 54u })
+	{
+		TEST_CHECK(BucketChiSquared([](uint64_t index) { return Hashing::WyHash::Calculate(&index, sizeof(index)); }, shift) < MaximumChiSquared);
+		TEST_CHECK(BucketChiSquared([](uint64_t index)
+			{
+				const std::string key = "key" + std::to_string(index);
+				return Hashing::WyHash::Calculate(key.data(), key.size());
+			}, shift) < MaximumChiSquared);
+	}
+}
+
+TEST_CASE(HashWyHashAvalanches)
+{
+	// With 10000 samples the standard deviation of a flip probability is 0.005.
+	for (const size_t keySize : { 4, 8, 16, 32 })
+	{
+		double worstBias = 0.0, minimumFlips = 0.0;
+		MeasureAvalanche([](const uint8_t* pKey, size_t size) { return Hashing::WyHash::Calculate(pKey, size); }, keySize, worstBias, minimumFlips);
+
+		TEST_CHECK(worstBias < 0.03);
+		TEST_CHECK(minimumFlips > 31.5);
+	}
+}
+
+TEST_CASE(HashFNV1aDistributesKeysEvenlyInTheLowBits)
+{
+	TEST_CHECK(BucketChiSquared([](uint64_t index) { return Hashing::FNV1aHash::Calculate(&index, sizeof(index)); }, 0) < MaximumChiSquared);
+	TEST_CHECK(BucketChiSquared([](uint64_t index)
+		{
+			const std::string key = "key" + std::to_string(index);
+			return Hashing::FNV1aHash::Calculate(key.data(), key.size());
+		}, 0) < MaximumChiSquared);
+}
+
+TEST_CASE(HashFNV1aChangesWithEveryInputBit)
+{
+	// FNV-1a does not avalanche (a flip only propagates towards the high bits through the multiplication), so only
+	// check that no input bit is lost and that every one of them flips a fair number of output bits.
+	for (const size_t keySize : { 4, 8, 16, 32 })
+	{
+		double worstBias = 0.0, minimumFlips = 0.0;
+		MeasureAvalanche([](const uint8_t* pKey, size_t size) { return Hashing::FNV1aHash::Calculate(pKey, size); }, keySize, worstBias, minimumFlips);
+
+		TEST_CHECK(minimumFlips > 8.0);
+	}
+}
+
+TEST_CASE(HashHasherDistributesKeysEvenly)
+{
+	for (const uint32_t shift : { 0u, 54u })
+	{
+		TEST_CHECK(BucketChiSquared([](uint64_t index) { return Hashing::Hasher<uint64_t>()(index); }, shift) < MaximumChiSquared);
+		TEST_CHECK(BucketChiSquared([](uint64_t index) { return Hashing::Hasher<uint32_t>()(static_cast<uint32_t>(index)); }, shift) < MaximumChiSquared);
+		TEST_CHECK(BucketChiSquared([](uint64_t index) { return Hashing::Hasher<double>()(static_cast<double>(index)); }, shift) < MaximumChiSquared);
+		TEST_CHECK(BucketChiSquared([](uint64_t index)
+			{
+				const std::string key = "key" + std::to_string(index);
+				return Hashing::Hasher<String>()(String(key.c_str()));
+			}, shift) < MaximumChiSquared);
+	}
+}
+
+TEST_CASE(HashHasherAvalanches)
+{
+	double worstBias = 0.0, minimumFlips = 0.0;
+	MeasureAvalanche([](const uint8_t* pKey, size_t)
+		{
+			uint64_t key = 0;
+			std::memcpy(&key, pKey, sizeof(key));
+			return Hashing::Hasher<uint64_t>()(key);
+		}, sizeof(uint64_t), worstBias, minimumFlips);
+
+	TEST_CHECK(worstBias < 0.03);
+	TEST_CHECK(minimumFlips > 31.5);
+
+	MeasureAvalanche([](const uint8_t* pKey, size_t)
+		{
+			uint32_t key = 0;
+			std::memcpy(&key, pKey, sizeof(key));
+			return Hashing::Hasher<uint32_t>()(key);
+		}, sizeof(uint32_t), worstBias, minimumFlips);
+
+	TEST_CHECK(worstBias < 0.03);
+	TEST_CHECK(minimumFlips > 31.5);
+}
+
+////////// Number conversion //////////
+
+/**
+ * Check appendInt against std::to_chars and parseInt against std::from_chars for random values of an integer type
+ * in every base.
+ */
+template<class Integer>
+static void CheckIntegerConversions()
+{
+	std::mt19937_64 engine(29);
+
+	for (int base = 2; base <= 36; base++)
+	{
+		for (int iteration = 0; iteration < 500; iteration++)
+		{
+			// Mix full range values with small ones, so every length is covered.
+			Integer value = static_cast<Integer>(engine() >> (engine() % 64));
+			if (iteration < 4)
+				value = iteration < 2 ? std::numeric_limits<Integer>::min() : std::numeric_limits<Integer>::max();
+
+			char expected[NumberConversion::MaxIntegerLength];
+			const size_t expectedLength = std::to_chars(expected, expected + sizeof(expected), value, base).ptr - expected;
+
+			String string;
+			string.appendInt(value, base);
+			TEST_CHECK(string.toStandard() == String::TypeSTD(expected, expectedLength));
+
+			wchar_t wide[NumberConversion::MaxIntegerLength];
+			const size_t wideLength = NumberConversion::FormatInteger(wide, value, base);
+			TEST_CHECK(wideLength == expectedLength && std::equal(wide, wide + wideLength, expected));
+
+			Integer parsed = 0;
+			TEST_CHECK(string.parseInt(parsed, base) && parsed == value);
+			parsed = 0;
+			TEST_CHECK(NumberConversion::ParseInteger(wide, wideLength, parsed, base) && parsed == value);
+		}
+	}
+}
+
+/**
+ * Check parseInt and parseFloat against std::from_chars on random (mostly invalid) character sequences. A parse must
+ * only succeed if from_chars consumes every character, and must then produce the same value.
+ */
+template<class Integer, class Float>
+static void CheckParsingAgainstFromChars()
+{
+	static constexpr char Alphabet[] = "0123456789-+. eEaAfFxXinfnaINFNAN";
+	std::mt19937 engine(31);
+
+	for (int iteration = 0; iteration < 20000; iteration++)
+	{
+		std::string characters(engine() % 24, ' ');
+		for (char& character : characters)
+			character = Alphabet[engine() % (sizeof(Alphabet) - 1)];
+
+		const String string(characters.c_str());
+		const char* pFirst = characters.data();
+		const char* pLast = pFirst + characters.size();
+
+		for (const int base : { 10, 16 })
+		{
+			Integer expected = 0;
+			const auto integerResult = std::from_chars(pFirst, pLast, expected, base);
+			const bool bExpected = integerResult.ec == std::errc() && integerResult.ptr == pLast;
+
+			Integer parsed = 7;
+			TEST_CHECK(string.parseInt(parsed, base) == bExpected);
+			TEST_CHECK(parsed == (bExpected ? expected : 7));
+		}
+
+		Float expected = 0;
+		const auto floatResult = std::from_chars(pFirst, pLast, expected);
+		const bool bExpected = floatResult.ec == std::errc() && floatResult.ptr == pLast;
+
+		Float parsed = 7;
+		TEST_CHECK(string.parseFloat(parsed) == bExpected);
+		if (bExpected)
+			TEST_CHECK(std::memcmp(&parsed, &expected, sizeof(Float)) == 0 || (std::isnan(parsed) && std::isnan(expected)));
+		else
+			TEST_CHECK(parsed == 7);
+	}
+}
+
+/**
+ * Check appendFloat against std::to_chars for random bit patterns (including infinities, NaNs and denormals) and
+ * check that parseFloat gives back the same value.
+ */
+template<class Float, class Bits>
+static void CheckFloatConversions()
+{
+	std::mt19937_64 engine(37);
+
+	for (int iteration = 0; iteration < 20000; iteration++)
+	{
+		const Bits bits = static_cast<Bits>(engine());
+		Float value = 0;
+		std::memcpy(&value, &bits, sizeof(Float));
+
+		char expected[NumberConversion::MaxFloatLength];
+		const size_t expectedLength = std::to_chars(expected, expected + sizeof(expected), value).ptr - expected;
+
+		String string;
+		string.appendFloat(value);
+		TEST_CHECK(string.toStandard() == String::TypeSTD(expected, expectedLength));
+
+		wchar_t wide[NumberConversion::MaxFloatLength];
+		const size_t wideLength = NumberConversion::FormatFloat(wide, value);
+		TEST_CHECK(wideLength == expectedLength && std::equal(wide, wide + wideLength, expected));
+
+		// The shortest representation parses back to the same value. NaN payloads are not kept.
+		Float parsed = 0;
+		TEST_CHECK(string.parseFloat(parsed));
+		TEST_CHECK(std::isnan(value) ? std::isnan(parsed) : std::memcmp(&parsed, &value, sizeof(Float)) == 0);
+	}
+}
+
+TEST_CASE(NumberConversionIntegersMatchCharConv)
+{
+	CheckIntegerConversions<int8_t>();
+	CheckIntegerConversions<uint8_t>();
+	CheckIntegerConversions<int16_t>();
+	CheckIntegerConversions<uint16_t>();
+	CheckIntegerConversions<int32_t>();
+	CheckIntegerConversions<uint32_t>();
+	CheckIntegerConversions<int64_t>();
+	CheckIntegerConversions<uint64_t>();
+}
+
+TEST_CASE(NumberConversionFloatsMatchCharConv)
+{
+	CheckFloatConversions<float, uint32_t>();
+	CheckFloatConversions<double, uint64_t>();
+}
+
+TEST_CASE(NumberConversionParsingMatchesFromChars)
+{
+	CheckParsingAgainstFromChars<int32_t, float>();
+	CheckParsingAgainstFromChars<int64_t, double>();
+	CheckParsingAgainstFromChars<uint64_t, double>();
+}
+
+TEST_CASE(NumberConversionRejectsOverlongWideInput)
+{
+	// Leading zeros make a valid number of any length.
+	std::wstring wide(NumberConversion::ParseBufferLength - 1, L'0');
+	wide += L'7';
+
+	int integer = 0;
+	double number = 0;
+	TEST_CHECK(NumberConversion::ParseInteger(wide.data(), wide.size(), integer) && integer == 7);
+	TEST_CHECK(NumberConversion::ParseFloat(wide.data(), wide.size(), number) && number == 7);
+
+	// One more character is rejected and leaves the values unchanged.
+	wide.insert(wide.begin(), L'0');
+	integer = 1;
+	number = 1;
+	TEST_CHECK(!NumberConversion::ParseInteger(wide.data(), wide.size(), integer) && integer == 1);
+	TEST_CHECK(!NumberConversion::ParseFloat(wide.data(), wide.size(), number) && number == 1);
+
+	// Char input is parsed in place, so it has no limit.
+	const std::string narrow(wide.begin(), wide.end());
+	TEST_CHECK(NumberConversion::ParseInteger(narrow.data(), narrow.size(), integer) && integer == 7);
+}
+
+////////// Unicode //////////
+
+/**
+ * Reference UTF-8 decoder which is written from the definition of the encoding, one code point at a time.
+ * Returns nothing if the bytes are malformed.
+ */
+static std::optional<std::u32string> ReferenceDecodeUtf8(const std::string& utf8)
+{
+	std::u32string codePoints;
+	for (size_t index = 0; index < utf8.size();)
+	{
+		const uint8_t lead = static_cast<uint8_t>(utf8[index]);
+		size_t count = 0;
+		char32_t codePoint = 0, minimum = 0;
+
+		if (lead < 0x80) { count = 1; codePoint = lead; }
+		else if ((lead & 0xE0) == 0xC0) { count = 2; codePoint = lead & 0x1F; minimum = 0x80; }
+		else if ((lead & 0xF0) == 0xE0) { count = 3; codePoint = lead & 0x0F; minimum = 0x800; }
+		else if ((lead & 0xF8) == 0xF0) { count = 4; codePoint = lead & 0x07; minimum = 0x10000; }
+		else return std::nullopt;
+
+		if (index + count > utf8.size())
+			return std::nullopt;
+
+		for (size_t offset = 1; offset < count; offset++)
+		{
+			const uint8_t continuation = static_cast<uint8_t>(utf8[index + offset]);
+			if ((continuation & 0xC0) != 0x80)
+				return std::nullopt;
+
+			codePoint = (codePoint << 6) | (continuation & 0x3F);
+		}
+
+		if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+			return std::nullopt;
+
+		codePoints.push_back(codePoint);
+		index += count;
+	}
+
+	return codePoints;
+}
+
+/**
+ * Reference UTF-16 decoder. Returns nothing if there is an unpaired surrogate.
+ */
+static std::optional<std::u32string> ReferenceDecodeUtf16(const std::u16string& utf16)
+{
+	std::u32string codePoints;
+	for (size_t index = 0; index < utf16.size(); index++)
+	{
+		const char32_t unit = utf16[index];
+		if (unit < 0xD800 || unit > 0xDFFF)
+			codePoints.push_back(unit);
+		else if (unit <= 0xDBFF && index + 1 < utf16.size() && utf16[index + 1] >= 0xDC00 && utf16[index + 1] <= 0xDFFF)
+			codePoints.push_back(0x10000 + ((unit - 0xD800) << 10) + (utf16[++index] - 0xDC00));
+		else
+			return std::nullopt;
+	}
+
+	return codePoints;
+}
+
+/**
+ * Reference UTF-32 validation. Returns nothing if there is a surrogate or a value above U+10FFFF.
+ */
+static std::optional<std::u32string> ReferenceDecodeUtf32(const std::u32string& utf32)
+{
+	for (const char32_t codePoint : utf32)
+		if (codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+			return std::nullopt;
+
+	return utf32;
+}
+
+/**
+ * Reference UTF-8 encoder.
+ */
+static std::string ReferenceEncodeUtf8(const std::u32string& codePoints)
+{
+	std::string utf8;
+	for (const char32_t codePoint : codePoints)
+	{
+		if (codePoint < 0x80)
+			utf8 += static_cast<char>(codePoint);
+		else if (codePoint < 0x800)
+		{
+			utf8 += static_cast<char>(0xC0 | (codePoint >> 6));
+			utf8 += static_cast<char>(0x80 | (codePoint & 0x3F));
+		}
+		else if (codePoint < 0x10000)
+		{
+			utf8 += static_cast<char>(0xE0 | (codePoint >> 12));
+			utf8 += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+			utf8 += static_cast<char>(0x80 | (codePoint & 0x3F));
+		}
+		else
+		{
+			utf8 += static_cast<char>(0xF0 | (codePoint >> 18));
+			utf8 += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+			utf8 += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+			utf8 += static_cast<char>(0x80 | (codePoint & 0x3F));
+		}
+	}
+
+	return utf8;
+}
+
+/**
+ * Reference UTF-16 and UTF-32 encoder.
+ */
+template<class Unit>
+static std::basic_string<Unit> ReferenceEncodeWide(const std::u32string& codePoints)
+{
+	std::basic_string<Unit> wide;
+	for (const char32_t codePoint : codePoints)
+	{
+		if (sizeof(Unit) == 2 && codePoint >= 0x10000)
+		{
+			wide += static_cast<Unit>(0xD800 + ((codePoint - 0x10000) >> 10));
+			wide += static_cast<Unit>(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+		}
+		else
+			wide += static_cast<Unit>(codePoint);
+	}
+
+	return wide;
+}
+
+/**
+ * Create random code points. Long ASCII runs are mixed in, so the vector kernels are used and their ends meet the
+ * multi-byte characters at every offset.
+ */
+static std::u32string CreateRandomCodePoints(std::mt19937& engine)
+{
+	std::u32string codePoints;
+	const size_t count = engine() % 120;
+	while (codePoints.size() < count)
+	{
+		switch (engine() % 5)
+		{
+		case 0:
+			codePoints.append(engine() % 70, static_cast<char32_t>('a' + engine() % 26));
+			break;
+
+		case 1: codePoints += static_cast<char32_t>(engine() % 0x80); break;
+		case 2: codePoints += static_cast<char32_t>(0x80 + engine() % (0x800 - 0x80)); break;
+		case 3: codePoints += static_cast<char32_t>(0xE000 + engine() % (0x10000 - 0xE000)); break;
+		default: codePoints += static_cast<char32_t>(0x10000 + engine() % (0x110000 - 0x10000)); break;
+		}
+	}
+
+	return codePoints;
+}
+
+/**
+ * Corrupt a string of code units: flip, replace, insert or remove a few random units, or truncate it.
+ */
+template<class Unit>
+static void Corrupt(std::basic_string<Unit>& units, std::mt19937& engine, uint32_t maximum)
+{
+	const size_t edits = 1 + engine() % 3;
+	for (size_t edit = 0; edit < edits && !units.empty(); edit++)
+	{
+		const size_t index = engine() % units.size();
+		switch (engine() % 5)
+		{
+		case 0: units[index] = static_cast<Unit>(units[index] ^ (1u << (engine() % (sizeof(Unit) * 8)))); break;
+		case 1: units[index] = static_cast<Unit>(engine() % maximum); break;
+		case 2: units.insert(units.begin() + index, static_cast<Unit>(engine() % maximum)); break;
+		case 3: units.erase(units.begin() + index); break;
+		default: units.resize(index); break;
+		}
+	}
+}
+
+/**
+ * Check the UTF-8 functions and the conversion to a wide code unit type against the reference decoder.
+ */
+template<class Unit>
+static void CheckUtf8ToWide(const std::string& utf8)
+{
+	const std::optional<std::u32string> reference = ReferenceDecodeUtf8(utf8);
+
+	TEST_CHECK(Unicode::ValidateUtf8(utf8.data(), utf8.size()) == reference.has_value());
+
+	const size_t length = Unicode::WideLengthOfUtf8<Unit>(utf8.data(), utf8.size());
+	std::basic_string<Unit> wide(utf8.size(), Unit());
+	const size_t written = Unicode::Utf8ToWide(utf8.data(), utf8.size(), wide.data());
+
+	if (!reference)
+	{
+		TEST_CHECK(length == Unicode::Invalid);
+		TEST_CHECK(written == Unicode::Invalid);
+		return;
+	}
+
+	const std::basic_string<Unit> expected = ReferenceEncodeWide<Unit>(*reference);
+	TEST_CHECK(length == expected.size());
+	TEST_CHECK(written == expected.size());
+	TEST_CHECK(wide.compare(0, written, expected) == 0);
+}
+
+/**
+ * Check the conversion of a wide code unit string to UTF-8 against the reference decoder.
+ */
+template<class Unit>
+static void CheckWideToUtf8(const std::basic_string<Unit>& wide, const std::optional<std::u32string>& reference)
+{
+	const size_t length = Unicode::Utf8LengthOfWide(wide.data(), wide.size());
+	std::string utf8(wide.size() * 4, '\0');
+	const size_t written = Unicode::WideToUtf8(wide.data(), wide.size(), utf8.data());
+
+	if (!reference)
+	{
+		TEST_CHECK(length == Unicode::Invalid);
+		TEST_CHECK(written == Unicode::Invalid);
+		return;
+	}
+
+	const std::string expected = ReferenceEncodeUtf8(*reference);
+	TEST_CHECK(length == expected.size());
+	TEST_CHECK(written == expected.size());
+	TEST_CHECK(utf8.compare(0, written, expected) == 0);
+}
+
+TEST_CASE(UnicodeUtf8MatchesReferenceDecoder)
+{
+	// Lead bytes at the edges of the valid ranges and continuation bytes, which random bytes rarely combine into the
+	// overlong and surrogate forms.
+	static constexpr uint8_t BoundaryBytes[] = { 0x80, 0x8F, 0x90, 0x9F, 0xA0, 0xBF, 0xC0, 0xC1, 0xC2, 0xDF, 0xE0, 0xED, 0xEF, 0xF0, 0xF4, 0xF5, 0xFF };
+
+	ForEachSIMDLevel([]
+		{
+			std::mt19937 engine(41);
+			for (int iteration = 0; iteration < 5000; iteration++)
+			{
+				// Valid UTF-8, corrupted UTF-8 and random bytes.
+				std::string utf8 = ReferenceEncodeUtf8(CreateRandomCodePoints(engine));
+				if (iteration % 3 == 1)
+					Corrupt(utf8, engine, 0x100);
+				else if (iteration % 3 == 2)
+					for (char& byte : utf8)
+						if (engine() % 4 == 0)
+							byte = static_cast<char>(engine() % 2 ? engine() : BoundaryBytes[engine() % std::size(BoundaryBytes)]);
+
+				CheckUtf8ToWide<char16_t>(utf8);
+				CheckUtf8ToWide<char32_t>(utf8);
+			}
+		});
+}
+
+TEST_CASE(UnicodeUtf8RejectsMalformedSequences)
+{
+	// Overlong forms, encoded surrogates, values above U+10FFFF, truncated sequences and stray continuation bytes,
+	// after an ASCII run which is long enough for the vector kernels.
+	const char* malformed[] = {
+		"\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+		"\xED\xA0\x80", "\xED\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF",
+		"\xC3", "\xE2\x82", "\xF0\x9F\x98", "\x80", "\xBF",
+	};
+
+	ForEachSIMDLevel([&]
+		{
+			for (const char* pSequence : malformed)
+			{
+				const std::string utf8 = std::string(64, 'a') + pSequence;
+				TEST_CHECK(!ReferenceDecodeUtf8(utf8));
+
+				CheckUtf8ToWide<char16_t>(utf8);
+				CheckUtf8ToWide<char32_t>(utf8);
+				CheckUtf8ToWide<char16_t>(utf8 + std::string(64, 'b'));
+			}
+		});
+}
+
+TEST_CASE(UnicodeUtf16MatchesReferenceDecoder)
+{
+	ForEachSIMDLevel([]
+		{
+			std::mt19937 engine(43);
+			for (int iteration = 0; iteration < 5000; iteration++)
+			{
+				// Valid UTF-16, corrupted UTF-16 (which produces unpaired surrogates) and random units.
+				std::u16string utf16 = ReferenceEncodeWide<char16_t>(CreateRandomCodePoints(engine));
+				if (iteration % 3 == 1)
+					Corrupt(utf16, engine, 0x10000);
+				else if (iteration % 3 == 2)
+					for (char16_t& unit : utf16)
+						if (engine() % 8 == 0)
+							unit = static_cast<char16_t>(0xD800 + engine() % 0x800);
+
+				CheckWideToUtf8(utf16, ReferenceDecodeUtf16(utf16));
+			}
+		});
+}
+
+TEST_CASE(UnicodeUtf32MatchesReferenceDecoder)
+{
+	ForEachSIMDLevel([]
+		{
+			std::mt19937 engine(47);
+			for (int iteration = 0; iteration < 5000; iteration++)
+			{
+				// Valid UTF-32 and UTF-32 with surrogates or values above U+10FFFF.
+				std::u32string utf32 = CreateRandomCodePoints(engine);
+				if (iteration % 2)
+					Corrupt(utf32, engine, 0x120000);
+
+				CheckWideToUtf8(utf32, ReferenceDecodeUtf32(utf32));
+			}
+		});
+}
+
+////////// SharedString //////////
+
+TEST_CASE(SharedStringCopiesAreIsolatedAcrossThreads)
+{
+	const std::string expected = "a shared string which is long enough to live in a heap allocated buffer";
+	const SharedString original(SharedString::View(expected.c_str()));
+	std::atomic<size_t> failures = 0;
+
+	// Every thread copies the original, modifies the copies (which detaches them) and releases them, while the other
+	// threads do the same with the same buffer.
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < 8; thread++)
+	{
+		threads.emplace_back([&, thread]
+			{
+				for (size_t iteration = 0; iteration < 2000; iteration++)
+				{
+					SharedString copy = original;
+					SharedString copyOfCopy = copy;
+					if (copy.view() != SharedString::View(expected.c_str()))
+						failures++;
+
+					copy.set(0, static_cast<String::Type>('A' + thread));
+					copyOfCopy.append("!", 1);
+					copyOfCopy += copy;
+
+					if (copy[0] != static_cast<String::Type>('A' + thread) || copyOfCopy.size() != 2 * expected.size() + 1)
+						failures++;
+
+					if (original.view() != SharedString::View(expected.c_str()) || copy == original || copyOfCopy == original)
+						failures++;
+				}
+			});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	TEST_CHECK(failures.load() == 0);
+	TEST_CHECK(original.view() == SharedString::View(expected.c_str()));
+	TEST_CHECK(original.useCount() == 1);
+}
+
+////////// StringBuilder //////////
+
+TEST_CASE(StringBuilderMatchesStandardString)
+{
+	std::mt19937 random(4);
+
+	for (const size_t chunkCapacity : { 0, 1, 7, 64, 16 * 1024 })
+	{
+		StringBuilder builder(chunkCapacity);
+
+		// The builder is cleared and reused after every round.
+		for (int round = 0; round < 3; round++)
+		{
+			std::string expected;
+			for (int fragment = 0; fragment < 200; fragment++)
+			{
+				// Single characters, fragments which span chunks and fragments which are larger than a chunk.
+				const size_t count = random() % 4 == 0 ? 1 : random() % (3 * (chunkCapacity ? chunkCapacity : 1) + 2);
+				std::string characters;
+				for (size_t index = 0; index < count; index++)
+					characters.push_back(static_cast<char>('a' + random() % 26));
+
+				if (count == 1)
+					builder += characters[0];
+				else
+					builder.append(characters.data(), characters.size());
+
+				expected += characters;
+			}
+
+			std::string chunks;
+			builder.forEachChunk([&](StringBuilder::View view) { chunks.append(view.data(), view.size()); });
+
+			const String flattened = builder.toString();
+			TEST_CHECK(builder.size() == expected.size());
+			TEST_CHECK(chunks == expected);
+			TEST_CHECK(flattened.size() == expected.size() && std::memcmp(flattened.str(), expected.data(), expected.size()) == 0);
+
+			builder.clear();
+			TEST_CHECK(builder.empty());
+			TEST_CHECK(builder.toString().size() == 0);
+		}
+	}
+}
+
+////////// InternedString //////////
+
+TEST_CASE(InternedStringIsUniqueAcrossThreadsWhileTheTableGrows)
+{
+	constexpr size_t KeyCount = 5000;
+	constexpr size_t ThreadCount = 8;
+
+	std::vector<std::string> keys;
+	for (size_t key = 0; key < KeyCount; key++)
+		keys.push_back("key" + std::to_string(key));
+
+	// The small initial capacity makes the table grow many times while the threads intern.
+	StringPool pool(16);
+	std::vector<std::vector<InternedString>> interned(ThreadCount, std::vector<InternedString>(KeyCount));
+	std::atomic<size_t> failures = 0;
+
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < ThreadCount; thread++)
+	{
+		threads.emplace_back([&, thread]
+			{
+				// Every thread interns all the keys, in its own order.
+				std::vector<size_t> order(KeyCount);
+				for (size_t index = 0; index < KeyCount; index++)
+					order[index] = index;
+
+				std::shuffle(order.begin(), order.end(), std::mt19937(static_cast<unsigned>(thread)));
+
+				for (const size_t key : order)
+				{
+					const StringPool::View view(keys[key].c_str());
+					const InternedString string = pool.intern(view);
+					interned[thread][key] = string;
+
+					if (string.view() != view || pool.find(view) != string)
+						failures++;
+
+					// A key of another thread is either not interned yet or complete.
+					const StringPool::View other(keys[(key * 7 + thread) % KeyCount].c_str());
+					const InternedString found = pool.find(other);
+					if (!found.empty() && found.view() != other)
+						failures++;
+				}
+			});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	TEST_CHECK(failures.load() == 0);
+	TEST_CHECK(pool.size() == KeyCount);
+
+	// Every thread got the same entry, and every key got its own id.
+	std::vector<bool> usedIds(KeyCount + 1, false);
+	for (size_t key = 0; key < KeyCount; key++)
+	{
+		const InternedString string = interned[0][key];
+		for (size_t thread = 1; thread < ThreadCount; thread++)
+			TEST_CHECK(interned[thread][key] == string && interned[thread][key].str() == string.str() && interned[thread][key].id() == string.id());
+
+		TEST_CHECK(string.id() >= 1 && string.id() <= KeyCount && !usedIds[string.id()]);
+		usedIds[string.id()] = true;
+
+		TEST_CHECK(pool.find(StringPool::View(keys[key].c_str())) == string);
+		TEST_CHECK(pool.intern(StringPool::View(keys[key].c_str())) == string);
+	}
+
+	TEST_CHECK(pool.size() == KeyCount);
+	TEST_CHECK(pool.find(StringPool::View("missing")).empty());
+}
+
+////////// VectorMap //////////
+
+/**
+ * Check that a VectorMap has the same entries as a std::map.
+ */
+static void CheckVectorMapEntries(const VectorMap<int, int>& map, const std::map<int, int>& expected)
+{
+	TEST_CHECK(map.size() == expected.size());
+	TEST_CHECK(std::equal(map.begin(), map.end(), expected.begin(), expected.end(),
+		[](const auto& entry, const auto& expectedEntry) { return entry.first == expectedEntry.first && entry.second == expectedEntry.second; }));
+}
+
+/**
+ * Check the lookups of a VectorMap against a std::map, for every key in a range.
+ */
+static void CheckVectorMapLookups(VectorMap<int, int>& map, const std::map<int, int>& expected, int firstKey, int lastKey)
+{
+	CheckVectorMapEntries(map, expected);
+
+	const VectorMap<int, int>& constMap = map;
+	const auto index = [&](auto iterator) { return static_cast<size_t>(iterator - constMap.begin()); };
+	const auto expectedIndex = [&](auto iterator) { return static_cast<size_t>(std::distance(expected.begin(), iterator)); };
+
+	for (int key = firstKey; key <= lastKey; key++)
+	{
+		const size_t lower = expectedIndex(expected.lower_bound(key));
+		const size_t upper = expectedIndex(expected.upper_bound(key));
+		const size_t found = expectedIndex(expected.find(key));
+
+		TEST_CHECK(index(map.lower_bound(key)) == lower && index(constMap.lower_bound(key)) == lower);
+		TEST_CHECK(index(map.upper_bound(key)) == upper && index(constMap.upper_bound(key)) == upper);
+		TEST_CHECK(index(map.find(key)) == found && index(constMap.find(key)) == found);
+		TEST_CHECK(map.count(key) == expected.count(key));
+	}
+}
+
+/**
+ * Insert a batch into a std::map the way the VectorMap bulk operations do with a duplicate policy.
+ */
+template<class Policy>
+static void InsertWithPolicy(std::map<int, int>& map, const std::vector<std::pair<int, int>>& batch, Policy policy)
+{
+	for (const auto& [key, value] : batch)
+	{
+		const auto [where, bInserted] = map.emplace(key, value);
+		int duplicate = value;
+		if (!bInserted)
+			policy(where->second, duplicate);
+	}
+}
+
+TEST_CASE(VectorMapBulkOperationsMatchStdMap)
+{
+	std::mt19937 random(5);
+
+	// A small key range, so the batches are full of duplicates.
+	const auto makeBatch = [&random]()
+		{
+			std::vector<std::pair<int, int>> batch(random() % 200);
+			for (auto& entry : batch)
+				entry = { static_cast<int>(random() % 64), static_cast<int>(random() % 1000) };
+
+			return batch;
+		};
+
+	const auto check = [&](auto policy)
+		{
+			for (int round = 0; round < 50; round++)
+			{
+				VectorMap<int, int> map;
+				std::map<int, int> expected;
+
+				const std::vector<std::pair<int, int>> assigned = makeBatch();
+				map.assignFromUnsorted(assigned.begin(), assigned.end(), policy);
+				InsertWithPolicy(expected, assigned, policy);
+				CheckVectorMapEntries(map, expected);
+
+				const std::vector<std::pair<int, int>> unsorted = makeBatch();
+				map.insertUnsorted(unsorted.begin(), unsorted.end(), policy);
+				InsertWithPolicy(expected, unsorted, policy);
+				CheckVectorMapEntries(map, expected);
+
+				std::vector<std::pair<int, int>> sorted = makeBatch();
+				std::stable_sort(sorted.begin(), sorted.end(), [](const auto& left, const auto& right) { return left.first < right.first; });
+				map.insertSorted(sorted.begin(), sorted.end(), policy);
+				InsertWithPolicy(expected, sorted, policy);
+				CheckVectorMapEntries(map, expected);
+			}
+		};
+
+	check(KeepFirstDuplicate());
+	check(KeepLastDuplicate());
+	check([](int& kept, const int& duplicate) { kept += duplicate; });
+
+	// The range constructors and insert() keep the first entry of a key, like std::map.
+	for (int round = 0; round < 50; round++)
+	{
+		const std::vector<std::pair<int, int>> batch = makeBatch();
+		const std::vector<std::pair<int, int>> inserted = makeBatch();
+
+		VectorMap<int, int> map(batch.begin(), batch.end());
+		std::map<int, int> expected(batch.begin(), batch.end());
+		CheckVectorMapEntries(map, expected);
+
+		map.insert(inserted.begin(), inserted.end());
+		expected.insert(inserted.begin(), inserted.end());
+		CheckVectorMapEntries(map, expected);
+	}
+}
+
+TEST_CASE(VectorMapEraseOfAMissingKeyKeepsTheOthers)
+{
+	for (const bool bFrozen : { false, true })
+	{
+		VectorMap<int, int> map;
+		std::map<int, int> expected;
+		for (int key = 0; key < 100; key += 2)
+		{
+			map[key] = key;
+			expected[key] = key;
+		}
+
+		// Every missing key lies before, between or after the entries.
+		for (int key = -1; key <= 101; key += 2)
+		{
+			if (bFrozen)
+				map.freeze();
+
+			map.erase(key);
+			CheckVectorMapEntries(map, expected);
+		}
+
+		for (int key = 0; key < 100; key += 4)
+		{
+			if (bFrozen)
+				map.freeze();
+
+			map.erase(key);
+			expected.erase(key);
+			CheckVectorMapEntries(map, expected);
+		}
+	}
+}
+
+TEST_CASE(VectorMapFrozenLookupsMatchUnfrozen)
+{
+	std::mt19937 random(6);
+
+	for (const size_t count : { 0, 1, 2, 3, 7, 8, 100, 1000 })
+	{
+		// Even keys, so the odd keys between them are missing.
+		VectorMap<int, int> map;
+		std::map<int, int> expected;
+		while (expected.size() < count)
+		{
+			const int key = static_cast<int>(random() % (count * 8)) * 2;
+			map[key] = key + 1;
+			expected[key] = key + 1;
+		}
+
+		const int lastKey = static_cast<int>(count * 16) + 2;
+		CheckVectorMapLookups(map, expected, -2, lastKey);
+
+		map.freeze();
+		TEST_CHECK(map.isFrozen() == (count != 0));
+		CheckVectorMapLookups(map, expected, -2, lastKey);
+
+		// Every mutation below changes the map, so it drops the frozen layout, and the lookups go on to match.
+		const auto mutate = [&](auto&& mutation)
+			{
+				map.freeze();
+				mutation();
+				TEST_CHECK(!map.isFrozen());
+				CheckVectorMapLookups(map, expected, -2, lastKey);
+			};
+
+		mutate([&] { map.insert({ 1, 1 }); expected.insert({ 1, 1 }); });
+		mutate([&] { map[lastKey] = 0; expected[lastKey] = 0; });
+		mutate([&] { map.erase(1); expected.erase(1); });
+		mutate([&] { map.erase_if([](const auto& entry) { return entry.first % 3 == 0; }); std::erase_if(expected, [](const auto& entry) { return entry.first % 3 == 0; }); });
+
+		const std::vector<std::pair<int, int>> batch = { { 5, 5 }, { lastKey - 3, 0 }, { 5, 6 } };
+		mutate([&] { map.insertUnsorted(batch.begin(), batch.end()); expected.insert(batch.begin(), batch.end()); });
+		mutate([&] { map.clear(); expected.clear(); });
+	}
+}
+
+////////// FastMap //////////
+
+TEST_CASE(HashMapInsertIsExceptionSafe)
+{
+	{
+		HashMap<int, ThrowingValue> map;
+		for (int key = 0; key < 1000; key++)
+		{
+			// Every fourth insertion fails to copy the value, at every point of the table's growth.
+			ThrowingValue::sCopyBudget = key % 4 == 3 ? 0 : -1;
+			if (key % 4 == 3)
+				TEST_CHECK_THROWS(map.Insert(key, ThrowingValue(key)), std::runtime_error);
+			else
+				TEST_CHECK(map.Insert(key, ThrowingValue(key)));
+		}
+
+		ThrowingValue::sCopyBudget = -1;
+		TEST_CHECK(map.Size() == 750);
+		TEST_CHECK(ThrowingValue::sLiveCount == 750);
+
+		for (int key = 0; key < 1000; key++)
+		{
+			const ThrowingValue* pValue = map.Find(key);
+			TEST_CHECK(key % 4 == 3 ? pValue == nullptr : (pValue && pValue->value == key));
+		}
+
+		// The slots of the failed insertions are still free.
+		for (int key = 3; key < 1000; key += 4)
+			TEST_CHECK(map.Insert(key, ThrowingValue(key)));
+
+		TEST_CHECK(map.Size() == 1000);
+		map.Clear();
+		TEST_CHECK(ThrowingValue::sLiveCount == 0);
+	}
+
+	TEST_CHECK(ThrowingValue::sLiveCount == 0);
+}
+
+TEST_CASE(HashMapInsertOfItsOwnValueSurvivesGrowth)
+{
+	// The value is long enough to live on the heap, so reading it after the table was freed is caught by sanitizers.
+	const std::string value(100, 'v');
+
+	HashMap<int, std::string> map;
+	map.Insert(0, value);
+	for (int key = 1; key < 1000; key++)
+		TEST_CHECK(map.Insert(key, map.Get(0)));
+
+	for (int key = 0; key < 1000; key++)
+		TEST_CHECK(map.Find(key) && *map.Find(key) == value);
+
+	// The key of a new entry can refer to a value of the map as well.
+	HashMap<int, int> chain;
+	chain.Get(0) = 1;
+	for (int key = 1; key < 1000; key++)
+		chain.Get(chain.Get(key - 1)) = key + 1;
+
+	TEST_CHECK(chain.Size() == 1000);
+	for (int key = 0; key < 1000; key++)
+		TEST_CHECK(chain.Find(key) && *chain.Find(key) == key + 1);
+}
+
+TEST_CASE(FindIndexMatchesStandardFind)
+{
+	ForEachSIMDLevel([]
+		{
+			std::mt19937_64 engine(43);
+
+			for (const size_t count : { 0, 1, 2, 3, 4, 7, 8, 9, 15, 16, 17, 31, 32, 33, 100, 1000 })
+			{
+				// Every other hash comes from a small range, so some of them are duplicates.
+				std::vector<uint64_t> hashes(count);
+				for (size_t index = 0; index < count; index++)
+					hashes[index] = index % 2 ? engine() % 16 : engine();
+
+				const std::vector<uint64_t> original = hashes;
+
+				// The hits give the first index of their hash.
+				for (const uint64_t hash : original)
+					TEST_CHECK(FindIndex(hashes, hash) == std::find(hashes.begin(), hashes.end(), hash) - hashes.begin());
+
+				for (int miss = 0; miss < 100; miss++)
+				{
+					const uint64_t hash = engine() | (static_cast<uint64_t>(1) << 63);
+					if (std::find(hashes.begin(), hashes.end(), hash) == hashes.end())
+						TEST_CHECK(FindIndex(hashes, hash) == -1);
+				}
+
+				TEST_CHECK(FindIndex(hashes, 16) == -1);
+				TEST_CHECK(hashes == original);
+			}
+		});
+}
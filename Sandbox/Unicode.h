@@ -0,0 +1,885 @@
+#pragma once
+#include "String.h"
+
+#include <type_traits>
+
+/**
+ * Validated transcoding between UTF-8 and UTF-16 or UTF-32.
+ * The encoding of a wide character type is selected by its size: 2 byte types (char16_t, and wchar_t on Windows) use
+ * UTF-16, and 4 byte types (char32_t, and wchar_t elsewhere) use UTF-32. So the same functions convert between the
+ * char and the wchar_t String (see USE_WCHAR) on every platform.
+ *
+ * Malformed input (overlong forms, surrogates encoded in UTF-8, unpaired surrogates, truncated sequences or values
+ * above U+10FFFF) is rejected rather than replaced, and the functions return Invalid.
+ *
+ * Runs of ASCII characters are converted using SSE4.2 or AVX2 kernels which are selected at runtime, and everything
+ * else is decoded one code point at a time. The AVX-512 level uses the AVX2 kernels.
+ */
+namespace Unicode {
+	/**
+	 * Returned by the conversions when the input is malformed.
+	 */
+	constexpr size_t Invalid = ~static_cast<size_t>(0);
+
+	/**
+	 * Check if a code unit is an ASCII character.
+	 *
+	 * @param unit: The code unit.
+	 */
+	template<class Unit>
+	constexpr bool IsAscii(Unit unit) noexcept { return static_cast<std::make_unsigned_t<Unit>>(unit) < 0x80; }
+
+	namespace Scalar {
+		/**
+		 * Get the number of leading ASCII characters.
+		 *
+		 * @param pSource: The code units.
+		 * @param length: The number of code units.
+		 */
+		template<class Unit>
+		size_t AsciiPrefixLength(const Unit* pSource, size_t length)
+		{
+			size_t index = 0;
+			while (index < length && IsAscii(pSource[index])) index++;
+
+			return index;
+		}
+
+		/**
+		 * Convert the leading ASCII characters of UTF-8 to wider code units.
+		 * Returns the number of characters converted.
+		 *
+		 * @param pSource: The UTF-8 bytes.
+		 * @param length: The number of bytes.
+		 * @param pDestination: The wide code units. This must hold length code units.
+		 */
+		template<class Unit>
+		size_t WidenAscii(const char* pSource, size_t length, Unit* pDestination)
+		{
+			size_t index = 0;
+			for (; index < length && IsAscii(pSource[index]); index++)
+				pDestination[index] = static_cast<Unit>(pSource[index]);
+
+			return index;
+		}
+
+		/**
+		 * Convert the leading ASCII characters of wider code units to UTF-8.
+		 * Returns the number of characters converted.
+		 *
+		 * @param pSource: The wide code units.
+		 * @param length: The number of code units.
+		 * @param pDestination: The UTF-8 bytes. This must hold length bytes.
+		 */
+		template<class Unit>
+		size_t NarrowAscii(const Unit* pSource, size_t length, char* pDestination)
+		{
+			size_t index = 0;
+			for (; index < length && IsAscii(pSource[index]); index++)
+				pDestination[index] = static_cast<char>(pSource[index]);
+
+			return index;
+		}
+	}
+
+#ifdef SIMD_X86
+	SIMD_BEGIN_TARGET_SSE42
+
+	/**
+	 * SSE4.2 kernels. These convert whole blocks of 16 bytes, and stop at the first block which is not all ASCII.
+	 */
+	namespace SSE42 {
+		using namespace ArrayKernels::SSE42;
+
+		/**
+		 * Store a register to unaligned memory.
+		 */
+		template<class Type>
+		inline void Store(Type* pData, Register value) { _mm_storeu_si128(reinterpret_cast<Register*>(pData), value); }
+
+		/**
+		 * Get the bits which are set in a lane only if its character is not ASCII.
+		 */
+		template<class Unit>
+		inline Register NonAsciiBits()
+		{
+			if constexpr (sizeof(Unit) == 1) return _mm_set1_epi8(static_cast<char>(0x80));
+			else if constexpr (sizeof(Unit) == 2) return _mm_set1_epi16(static_cast<short>(0xFF80));
+			else return _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+		}
+
+		/**
+		 * Get the number of leading ASCII characters.
+		 */
+		template<class Unit>
+		size_t AsciiPrefixLength(const Unit* pSource, size_t length)
+		{
+			constexpr size_t Lanes = Width / sizeof(Unit);
+			const Register nonAscii = NonAsciiBits<Unit>();
+
+			// Check four blocks at a time, then single blocks.
+			size_t index = 0;
+			for (; index + Lanes * 4 <= length; index += Lanes * 4)
+			{
+				const Register combined = _mm_or_si128(_mm_or_si128(Load(pSource + index), Load(pSource + index + Lanes)),
+					_mm_or_si128(Load(pSource + index + Lanes * 2), Load(pSource + index + Lanes * 3)));
+
+				if (!_mm_testz_si128(combined, nonAscii))
+					break;
+			}
+
+			for (; index + Lanes <= length; index += Lanes)
+				if (!_mm_testz_si128(Load(pSource + index), nonAscii))
+					break;
+
+			return index + Scalar::AsciiPrefixLength(pSource + index, length - index);
+		}
+
+		/**
+		 * Convert the leading ASCII blocks of UTF-8 to wider code units.
+		 */
+		template<class Unit>
+		size_t WidenAscii(const char* pSource, size_t length, Unit* pDestination)
+		{
+			const Register zero = _mm_setzero_si128();
+
+			size_t index = 0;
+			for (; index + Width <= length; index += Width)
+			{
+				const Register block = Load(pSource + index);
+				if (_mm_movemask_epi8(block))
+					break;
+
+				const Register low = _mm_unpacklo_epi8(block, zero);
+				const Register high = _mm_unpackhi_epi8(block, zero);
+
+				Unit* pOutput = pDestination + index;
+				if constexpr (sizeof(Unit) == 2)
+				{
+					Store(pOutput, low);
+					Store(pOutput + 8, high);
+				}
+				else
+				{
+					Store(pOutput, _mm_unpacklo_epi16(low, zero));
+					Store(pOutput + 4, _mm_unpackhi_epi16(low, zero));
+					Store(pOutput + 8, _mm_unpacklo_epi16(high, zero));
+					Store(pOutput + 12, _mm_unpackhi_epi16(high, zero));
+				}
+			}
+
+			return index;
+		}
+
+		/**
+		 * Convert the leading ASCII blocks of wider code units to UTF-8.
+		 */
+		template<class Unit>
+		size_t NarrowAscii(const Unit* pSource, size_t length, char* pDestination)
+		{
+			const Register nonAscii = NonAsciiBits<Unit>();
+
+			size_t index = 0;
+			for (; index + Width <= length; index += Width)
+			{
+				// The characters are below 0x80, so the saturating packs keep them unchanged.
+				const Unit* pInput = pSource + index;
+				Register block;
+				if constexpr (sizeof(Unit) == 2)
+				{
+					const Register first = Load(pInput), second = Load(pInput + 8);
+					if (!_mm_testz_si128(_mm_or_si128(first, second), nonAscii))
+						break;
+
+					block = _mm_packus_epi16(first, second);
+				}
+				else
+				{
+					const Register first = Load(pInput), second = Load(pInput + 4), third = Load(pInput + 8), fourth = Load(pInput + 12);
+					if (!_mm_testz_si128(_mm_or_si128(_mm_or_si128(first, second), _mm_or_si128(third, fourth)), nonAscii))
+						break;
+
+					block = _mm_packus_epi16(_mm_packus_epi32(first, second), _mm_packus_epi32(third, fourth));
+				}
+
+				Store(pDestination + index, block);
+			}
+
+			return index;
+		}
+	}
+
+	SIMD_END_TARGET
+
+	SIMD_BEGIN_TARGET_AVX2
+
+	/**
+	 * AVX2 kernels. These convert whole blocks of 32 bytes, and stop at the first block which is not all ASCII.
+	 */
+	namespace AVX2 {
+		using namespace ArrayKernels::AVX2;
+
+		/**
+		 * Store a register to unaligned memory.
+		 */
+		template<class Type>
+		inline void Store(Type* pData, Register value) { _mm256_storeu_si256(reinterpret_cast<Register*>(pData), value); }
+
+		/**
+		 * Get the bits which are set in a lane only if its character is not ASCII.
+		 */
+		template<class Unit>
+		inline Register NonAsciiBits()
+		{
+			if constexpr (sizeof(Unit) == 1) return _mm256_set1_epi8(static_cast<char>(0x80));
+			else if constexpr (sizeof(Unit) == 2) return _mm256_set1_epi16(static_cast<short>(0xFF80));
+			else return _mm256_set1_epi32(static_cast<int>(0xFFFFFF80));
+		}
+
+		/**
+		 * Get the number of leading ASCII characters.
+		 */
+		template<class Unit>
+		size_t AsciiPrefixLength(const Unit* pSource, size_t length)
+		{
+			constexpr size_t Lanes = Width / sizeof(Unit);
+			const Register nonAscii = NonAsciiBits<Unit>();
+
+			// Check four blocks at a time, then single blocks.
+			size_t index = 0;
+			for (; index + Lanes * 4 <= length; index += Lanes * 4)
+			{
+				const Register combined = _mm256_or_si256(_mm256_or_si256(Load(pSource + index), Load(pSource + index + Lanes)),
+					_mm256_or_si256(Load(pSource + index + Lanes * 2), Load(pSource + index + Lanes * 3)));
+
+				if (!_mm256_testz_si256(combined, nonAscii))
+					break;
+			}
+
+			for (; index + Lanes <= length; index += Lanes)
+				if (!_mm256_testz_si256(Load(pSource + index), nonAscii))
+					break;
+
+			return index + Scalar::AsciiPrefixLength(pSource + index, length - index);
+		}
+
+		/**
+		 * Convert the leading ASCII blocks of UTF-8 to wider code units.
+		 */
+		template<class Unit>
+		size_t WidenAscii(const char* pSource, size_t length, Unit* pDestination)
+		{
+			size_t index = 0;
+			for (; index + Width <= length; index += Width)
+			{
+				const Register block = Load(pSource + index);
+				if (_mm256_movemask_epi8(block))
+					break;
+
+				const __m128i low = _mm256_castsi256_si128(block);
+				const __m128i high = _mm256_extracti128_si256(block, 1);
+
+				Unit* pOutput = pDestination + index;
+				if constexpr (sizeof(Unit) == 2)
+				{
+					Store(pOutput, _mm256_cvtepu8_epi16(low));
+					Store(pOutput + 16, _mm256_cvtepu8_epi16(high));
+				}
+				else
+				{
+					Store(pOutput, _mm256_cvtepu8_epi32(low));
+					Store(pOutput + 8, _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)));
+					Store(pOutput + 16, _mm256_cvtepu8_epi32(high));
+					Store(pOutput + 24, _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+				}
+			}
+
+			return index;
+		}
+
+		/**
+		 * Convert the leading ASCII blocks of wider code units to UTF-8.
+		 */
+		template<class Unit>
+		size_t NarrowAscii(const Unit* pSource, size_t length, char* pDestination)
+		{
+			const Register nonAscii = NonAsciiBits<Unit>();
+
+			size_t index = 0;
+			for (; index + Width <= length; index += Width)
+			{
+				// The characters are below 0x80, so the saturating packs keep them unchanged. The packs work within
+				// the 128 bit lanes, so the result is permuted back into order.
+				const Unit* pInput = pSource + index;
+				Register block;
+				if constexpr (sizeof(Unit) == 2)
+				{
+					const Register first = Load(pInput), second = Load(pInput + 16);
+					if (!_mm256_testz_si256(_mm256_or_si256(first, second), nonAscii))
+						break;
+
+					block = _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), 0xD8);
+				}
+				else
+				{
+					const Register first = Load(pInput), second = Load(pInput + 8), third = Load(pInput + 16), fourth = Load(pInput + 24);
+					if (!_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(first, second), _mm256_or_si256(third, fourth)), nonAscii))
+						break;
+
+					const Register packed = _mm256_packus_epi16(_mm256_packus_epi32(first, second), _mm256_packus_epi32(third, fourth));
+					block = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+				}
+
+				Store(pDestination + index, block);
+			}
+
+			return index;
+		}
+	}
+
+	SIMD_END_TARGET
+
+#endif // SIMD_X86
+
+	/**
+	 * Get the number of leading ASCII characters.
+	 * The implementation is selected at runtime.
+	 */
+	template<class Unit>
+	size_t AsciiPrefixLength(const Unit* pSource, size_t length)
+	{
+#ifdef SIMD_X86
+		switch (SIMD::GetLevel())
+		{
+		case SIMD::Level::AVX512:
+		case SIMD::Level::AVX2:
+			return AVX2::AsciiPrefixLength(pSource, length);
+
+		case SIMD::Level::SSE42:
+			return SSE42::AsciiPrefixLength(pSource, length);
+
+		default:
+			break;
+		}
+
+#endif // SIMD_X86
+
+		return Scalar::AsciiPrefixLength(pSource, length);
+	}
+
+	/**
+	 * Convert leading ASCII characters of UTF-8 to wider code units. This may stop before the end of the ASCII
+	 * characters. Returns the number of characters converted. The implementation is selected at runtime.
+	 */
+	template<class Unit>
+	size_t WidenAscii(const char* pSource, size_t length, Unit* pDestination)
+	{
+#ifdef SIMD_X86
+		switch (SIMD::GetLevel())
+		{
+		case SIMD::Level::AVX512:
+		case SIMD::Level::AVX2:
+			return AVX2::WidenAscii(pSource, length, pDestination);
+
+		case SIMD::Level::SSE42:
+			return SSE42::WidenAscii(pSource, length, pDestination);
+
+		default:
+			break;
+		}
+
+#endif // SIMD_X86
+
+		return Scalar::WidenAscii(pSource, length, pDestination);
+	}
+
+	/**
+	 * Convert leading ASCII characters of wider code units to UTF-8. This may stop before the end of the ASCII
+	 * characters. Returns the number of characters converted. The implementation is selected at runtime.
+	 */
+	template<class Unit>
+	size_t NarrowAscii(const Unit* pSource, size_t length, char* pDestination)
+	{
+#ifdef SIMD_X86
+		switch (SIMD::GetLevel())
+		{
+		case SIMD::Level::AVX512:
+		case SIMD::Level::AVX2:
+			return AVX2::NarrowAscii(pSource, length, pDestination);
+
+		case SIMD::Level::SSE42:
+			return SSE42::NarrowAscii(pSource, length, pDestination);
+
+		default:
+			break;
+		}
+
+#endif // SIMD_X86
+
+		return Scalar::NarrowAscii(pSource, length, pDestination);
+	}
+
+	/**
+	 * Check if the next 8 code units are ASCII. The vector kernels are only called for such runs, as calling them for
+	 * the single spaces and punctuation between non ASCII characters costs more than it saves.
+	 *
+	 * @param pSource: The code units.
+	 * @param remaining: The number of code units available.
+	 */
+	template<class Unit>
+	inline bool StartsAsciiRun(const Unit* pSource, size_t remaining) noexcept
+	{
+		if (remaining < 8)
+			return false;
+
+		std::make_unsigned_t<Unit> combined = 0;
+		for (size_t index = 0; index < 8; index++)
+			combined |= static_cast<std::make_unsigned_t<Unit>>(pSource[index]);
+
+		return combined < 0x80;
+	}
+
+	/**
+	 * Get the number of leading ASCII characters, using the vector kernels only for runs of 8 or more characters.
+	 *
+	 * @param pSource: The code units.
+	 * @param length: The number of code units.
+	 */
+	template<class Unit>
+	inline size_t AsciiRunLength(const Unit* pSource, size_t length)
+	{
+		return StartsAsciiRun(pSource, length) ? AsciiPrefixLength(pSource, length) : Scalar::AsciiPrefixLength(pSource, length);
+	}
+
+	/**
+	 * Decode a multi byte UTF-8 sequence.
+	 * Returns the number of bytes of the sequence, or 0 if it is malformed.
+	 *
+	 * @param pSource: The bytes, starting with a byte which is not ASCII.
+	 * @param remaining: The number of bytes available.
+	 * @param codePoint: The decoded code point.
+	 */
+	inline size_t DecodeUtf8(const uint8_t* pSource, size_t remaining, char32_t& codePoint) noexcept
+	{
+		const uint8_t lead = pSource[0];
+		const auto isContinuation = [pSource](size_t index) { return (pSource[index] & 0xC0) == 0x80; };
+
+		// 0xC0 and 0xC1 could only start overlong forms of ASCII.
+		if (lead < 0xC2)
+			return 0;
+
+		if (lead < 0xE0)
+		{
+			if (remaining < 2 || !isContinuation(1))
+				return 0;
+
+			codePoint = (static_cast<char32_t>(lead & 0x1F) << 6) | (pSource[1] & 0x3F);
+			return 2;
+		}
+
+		if (lead < 0xF0)
+		{
+			if (remaining < 3 || !isContinuation(1) || !isContinuation(2))
+				return 0;
+
+			codePoint = (static_cast<char32_t>(lead & 0x0F) << 12) | (static_cast<char32_t>(pSource[1] & 0x3F) << 6) | (pSource[2] & 0x3F);
+
+			// Reject overlong forms and surrogates.
+			return codePoint < 0x800 || (codePoint >= 0xD800 && codePoint <= 0xDFFF) ? 0 : 3;
+		}
+
+		if (lead < 0xF5)
+		{
+			if (remaining < 4 || !isContinuation(1) || !isContinuation(2) || !isContinuation(3))
+				return 0;
+
+			codePoint = (static_cast<char32_t>(lead & 0x07) << 18) | (static_cast<char32_t>(pSource[1] & 0x3F) << 12)
+				| (static_cast<char32_t>(pSource[2] & 0x3F) << 6) | (pSource[3] & 0x3F);
+
+			// Reject overlong forms and values above U+10FFFF.
+			return codePoint < 0x10000 || codePoint > 0x10FFFF ? 0 : 4;
+		}
+
+		return 0;
+	}
+
+	/**
+	 * Decode a code point from UTF-16 or UTF-32 code units.
+	 * Returns the number of code units of the code point, or 0 if it is malformed.
+	 *
+	 * @param pSource: The code units, starting with a code unit which is not ASCII.
+	 * @param remaining: The number of code units available.
+	 * @param codePoint: The decoded code point.
+	 */
+	template<class Unit>
+	inline size_t DecodeWide(const Unit* pSource, size_t remaining, char32_t& codePoint) noexcept
+	{
+		codePoint = static_cast<char32_t>(static_cast<std::make_unsigned_t<Unit>>(pSource[0]));
+		if (codePoint < 0xD800 || (codePoint > 0xDFFF && codePoint <= 0x10FFFF))
+			return 1;
+
+		// Only a high surrogate followed by a low surrogate is valid, and only in UTF-16.
+		if constexpr (sizeof(Unit) == 2)
+		{
+			if (codePoint <= 0xDBFF && remaining >= 2)
+			{
+				const char32_t low = static_cast<std::make_unsigned_t<Unit>>(pSource[1]);
+				if (low >= 0xDC00 && low <= 0xDFFF)
+				{
+					codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+					return 2;
+				}
+			}
+		}
+
+		return 0;
+	}
+
+	/**
+	 * Encode a code point as UTF-8.
+	 * Returns the number of bytes written.
+	 *
+	 * @param codePoint: The code point. This must be a valid scalar value.
+	 * @param pDestination: The bytes to write to. This must hold 4 bytes.
+	 */
+	inline size_t EncodeUtf8(char32_t codePoint, char* pDestination) noexcept
+	{
+		if (codePoint < 0x80)
+		{
+			pDestination[0] = static_cast<char>(codePoint);
+			return 1;
+		}
+
+		if (codePoint < 0x800)
+		{
+			pDestination[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+			pDestination[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+			return 2;
+		}
+
+		if (codePoint < 0x10000)
+		{
+			pDestination[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+			pDestination[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+			pDestination[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+			return 3;
+		}
+
+		pDestination[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+		pDestination[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+		pDestination[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		pDestination[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+		return 4;
+	}
+
+	/**
+	 * Encode a code point as UTF-16 or UTF-32.
+	 * Returns the number of code units written.
+	 *
+	 * @param codePoint: The code point. This must be a valid scalar value.
+	 * @param pDestination: The code units to write to. This must hold 2 code units.
+	 */
+	template<class Unit>
+	inline size_t EncodeWide(char32_t codePoint, Unit* pDestination) noexcept
+	{
+		if constexpr (sizeof(Unit) == 2)
+		{
+			if (codePoint >= 0x10000)
+			{
+				codePoint -= 0x10000;
+				pDestination[0] = static_cast<Unit>(0xD800 + (codePoint >> 10));
+				pDestination[1] = static_cast<Unit>(0xDC00 + (codePoint & 0x3FF));
+				return 2;
+			}
+		}
+
+		pDestination[0] = static_cast<Unit>(codePoint);
+		return 1;
+	}
+
+	/**
+	 * Check if UTF-8 is well formed.
+	 *
+	 * @param pSource: The bytes.
+	 * @param length: The number of bytes.
+	 */
+	inline bool ValidateUtf8(const char* pSource, size_t length)
+	{
+		const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(pSource);
+		for (size_t read = 0; read < length;)
+		{
+			if (pBytes[read] < 0x80)
+			{
+				read += AsciiRunLength(pSource + read, length - read);
+				continue;
+			}
+
+			char32_t codePoint = 0;
+			const size_t count = DecodeUtf8(pBytes + read, length - read, codePoint);
+			if (!count)
+				return false;
+
+			read += count;
+		}
+
+		return true;
+	}
+
+	/**
+	 * Get the number of UTF-16 or UTF-32 code units needed to hold UTF-8.
+	 * Returns Invalid if the UTF-8 is malformed.
+	 *
+	 * @tparam Unit: The wide code unit type.
+	 * @param pSource: The UTF-8 bytes.
+	 * @param length: The number of bytes.
+	 */
+	template<class Unit>
+	size_t WideLengthOfUtf8(const char* pSource, size_t length)
+	{
+		static_assert(sizeof(Unit) == 2 || sizeof(Unit) == 4, "The code unit must be 2 (UTF-16) or 4 (UTF-32) bytes!");
+
+		const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(pSource);
+		size_t read = 0, units = 0;
+		while (read < length)
+		{
+			if (pBytes[read] < 0x80)
+			{
+				const size_t count = AsciiRunLength(pSource + read, length - read);
+				read += count;
+				units += count;
+				continue;
+			}
+
+			char32_t codePoint = 0;
+			const size_t count = DecodeUtf8(pBytes + read, length - read, codePoint);
+			if (!count)
+				return Invalid;
+
+			read += count;
+			units += sizeof(Unit) == 2 && count == 4 ? 2 : 1;
+		}
+
+		return units;
+	}
+
+	/**
+	 * Get the number of UTF-8 bytes needed to hold UTF-16 or UTF-32.
+	 * Returns Invalid if the input is malformed.
+	 *
+	 * @tparam Unit: The wide code unit type.
+	 * @param pSource: The code units.
+	 * @param length: The number of code units.
+	 */
+	template<class Unit>
+	size_t Utf8LengthOfWide(const Unit* pSource, size_t length)
+	{
+		static_assert(sizeof(Unit) == 2 || sizeof(Unit) == 4, "The code unit must be 2 (UTF-16) or 4 (UTF-32) bytes!");
+
+		size_t read = 0, bytes = 0;
+		while (read < length)
+		{
+			if (IsAscii(pSource[read]))
+			{
+				const size_t count = AsciiRunLength(pSource + read, length - read);
+				read += count;
+				bytes += count;
+				continue;
+			}
+
+			char32_t codePoint = 0;
+			const size_t count = DecodeWide(pSource + read, length - read, codePoint);
+			if (!count)
+				return Invalid;
+
+			read += count;
+			bytes += codePoint < 0x800 ? 2 : (codePoint < 0x10000 ? 3 : 4);
+		}
+
+		return bytes;
+	}
+
+	/**
+	 * Convert UTF-8 to UTF-16 or UTF-32.
+	 * Returns the number of code units written, or Invalid if the UTF-8 is malformed (in which case the contents of
+	 * the destination are unspecified).
+	 *
+	 * @tparam Unit: The wide code unit type.
+	 * @param pSource: The UTF-8 bytes.
+	 * @param length: The number of bytes.
+	 * @param pDestination: The code units to write to. This must hold WideLengthOfUtf8 code units, or simply length
+	 *	code units, which is always enough.
+	 */
+	template<class Unit>
+	size_t Utf8ToWide(const char* pSource, size_t length, Unit* pDestination)
+	{
+		static_assert(sizeof(Unit) == 2 || sizeof(Unit) == 4, "The code unit must be 2 (UTF-16) or 4 (UTF-32) bytes!");
+
+		const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(pSource);
+		size_t read = 0, written = 0;
+		while (read < length)
+		{
+			if (pBytes[read] < 0x80)
+			{
+				if (StartsAsciiRun(pSource + read, length - read))
+				{
+					const size_t count = WidenAscii(pSource + read, length - read, pDestination + written);
+					read += count;
+					written += count;
+				}
+
+				// Copy the ASCII characters which were not converted by the vector kernel.
+				while (read < length && pBytes[read] < 0x80)
+					pDestination[written++] = static_cast<Unit>(pBytes[read++]);
+
+				continue;
+			}
+
+			char32_t codePoint = 0;
+			const size_t count = DecodeUtf8(pBytes + read, length - read, codePoint);
+			if (!count)
+				return Invalid;
+
+			read += count;
+			written += EncodeWide(codePoint, pDestination + written);
+		}
+
+		return written;
+	}
+
+	/**
+	 * Convert UTF-16 or UTF-32 to UTF-8.
+	 * Returns the number of bytes written, or Invalid if the input is malformed (in which case the contents of the
+	 * destination are unspecified).
+	 *
+	 * @tparam Unit: The wide code unit type.
+	 * @param pSource: The code units.
+	 * @param length: The number of code units.
+	 * @param pDestination: The bytes to write to. This must hold Utf8LengthOfWide bytes, or simply 3 * length bytes
+	 *	for UTF-16 and 4 * length bytes for UTF-32, which is always enough.
+	 */
+	template<class Unit>
+	size_t WideToUtf8(const Unit* pSource, size_t length, char* pDestination)
+	{
+		static_assert(sizeof(Unit) == 2 || sizeof(Unit) == 4, "The code unit must be 2 (UTF-16) or 4 (UTF-32) bytes!");
+
+		size_t read = 0, written = 0;
+		while (read < length)
+		{
+			if (IsAscii(pSource[read]))
+			{
+				if (StartsAsciiRun(pSource + read, length - read))
+				{
+					const size_t count = NarrowAscii(pSource + read, length - read, pDestination + written);
+					read += count;
+					written += count;
+				}
+
+				// Copy the ASCII characters which were not converted by the vector kernel.
+				while (read < length && IsAscii(pSource[read]))
+					pDestination[written++] = static_cast<char>(pSource[read++]);
+
+				continue;
+			}
+
+			char32_t codePoint = 0;
+			const size_t count = DecodeWide(pSource + read, length - read, codePoint);
+			if (!count)
+				return Invalid;
+
+			read += count;
+			written += EncodeUtf8(codePoint, pDestination + written);
+		}
+
+		return written;
+	}
+
+	/**
+	 * Convert a UTF-8 view to a wide string, replacing its contents.
+	 * Returns false and leaves the string unchanged if the UTF-8 is malformed.
+	 *
+	 * @param utf8: The UTF-8 view.
+	 * @param string: The wide string.
+	 */
+	template<class Unit>
+	bool FromUtf8(BasicStringView<char> utf8, std::basic_string<Unit>& string)
+	{
+		const size_t length = WideLengthOfUtf8<Unit>(utf8.data(), utf8.size());
+		if (length == Invalid)
+			return false;
+
+		string.resize(length);
+		Utf8ToWide(utf8.data(), utf8.size(), string.data());
+		return true;
+	}
+
+	/**
+	 * Convert a UTF-8 view to a String, replacing its contents. The String is UTF-8 itself unless USE_WCHAR is
+	 * defined, in which case the view is only validated and copied.
+	 * Returns false and leaves the string unchanged if the UTF-8 is malformed.
+	 *
+	 * @param utf8: The UTF-8 view.
+	 * @param string: The string.
+	 */
+	inline bool FromUtf8(BasicStringView<char> utf8, String& string)
+	{
+#ifdef USE_WCHAR
+		const size_t length = WideLengthOfUtf8<String::Type>(utf8.data(), utf8.size());
+		if (length == Invalid)
+			return false;
+
+		string.allocate(length);
+		Utf8ToWide(utf8.data(), utf8.size(), string.begin());
+
+#else
+		if (!ValidateUtf8(utf8.data(), utf8.size()))
+			return false;
+
+		string = String(utf8, string.getMemoryResource());
+
+#endif // USE_WCHAR
+
+		return true;
+	}
+
+	/**
+	 * Convert a view (a String, a wide string or UTF-8) to UTF-8, replacing the contents of a string.
+	 * Returns false and leaves the string unchanged if the view is malformed.
+	 *
+	 * @param view: The view.
+	 * @param utf8: The UTF-8 string.
+	 */
+	template<class Unit>
+	bool ToUtf8(BasicStringView<Unit> view, std::string& utf8)
+	{
+		if constexpr (std::is_same_v<Unit, char>)
+		{
+			if (!ValidateUtf8(view.data(), view.size()))
+				return false;
+
+			utf8.assign(view.data(), view.size());
+		}
+		else
+		{
+			const size_t length = Utf8LengthOfWide(view.data(), view.size());
+			if (length == Invalid)
+				return false;
+
+			utf8.resize(length);
+			WideToUtf8(view.data(), view.size(), utf8.data());
+		}
+
+		return true;
+	}
+
+	/**
+	 * Convert a String to UTF-8, replacing the contents of a string.
+	 * Returns false and leaves the string unchanged if the String is malformed.
+	 *
+	 * @param string: The String.
+	 * @param utf8: The UTF-8 string.
+	 */
+	inline bool ToUtf8(const String& string, std::string& utf8)
+	{
+		return ToUtf8(string.view(), utf8);
+	}
+}
@@ -0,0 +1,163 @@
+#include "Unicode.h"
+
+#include <benchmark/benchmark.h>
+#include <clocale>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/**
+ * Kinds of text used by the benchmarks.
+ */
+enum class TextKind : int64_t {
+	Ascii,		// Source code and identifiers.
+	Latin,		// European text, where about one character in ten takes two bytes.
+	Mixed,		// Asian text, where most characters take three bytes, mixed with ASCII spaces and punctuation.
+};
+
+/**
+ * Create about 1 MiB of UTF-8 text.
+ *
+ * @param kind: The kind of text.
+ */
+static std::string CreateUtf8Text(TextKind kind)
+{
+	std::string text;
+	text.reserve((1 << 20) + 4);
+
+	std::mt19937 engine(static_cast<uint32_t>(kind));
+	while (text.size() < (1 << 20))
+	{
+		char32_t codePoint = static_cast<char32_t>('a' + engine() % 26);
+		if (kind == TextKind::Ascii && engine() % 8 == 0)
+			codePoint = U' ';
+		else if (kind == TextKind::Latin && engine() % 10 == 0)
+			codePoint = 0xC0 + engine() % 0x40;
+		else if (kind == TextKind::Mixed)
+			codePoint = engine() % 4 == 0 ? U' ' : 0x4E00 + engine() % 0x5000;
+
+		char bytes[4];
+		text.append(bytes, Unicode::EncodeUtf8(codePoint, bytes));
+	}
+
+	return text;
+}
+
+/**
+ * Set the instruction set level of a benchmark (the first argument). Returns false if the CPU does not support it.
+ *
+ * @param state: The benchmark state.
+ * @param previous: The variable to store the previous level in.
+ */
+static bool SetLevel(benchmark::State& state, SIMD::Level& previous)
+{
+	previous = SIMD::LevelOverride();
+	SIMD::LevelOverride() = static_cast<SIMD::Level>(state.range(0));
+	if (SIMD::GetLevel() == SIMD::LevelOverride())
+		return true;
+
+	SIMD::LevelOverride() = previous;
+	state.SkipWithError("The instruction set level is not supported by this CPU.");
+	return false;
+}
+
+/**
+ * Arguments: the scalar, SSE4.2 and AVX2 levels with every kind of text.
+ */
+static void TextArguments(benchmark::internal::Benchmark* pBenchmark)
+{
+	pBenchmark->ArgNames({ "level", "text" });
+	for (int64_t level = 0; level <= static_cast<int64_t>(SIMD::Level::AVX2); level++)
+		for (int64_t kind = 0; kind <= static_cast<int64_t>(TextKind::Mixed); kind++)
+			pBenchmark->Args({ level, kind });
+}
+
+/**
+ * Validate UTF-8.
+ */
+static void BM_ValidateUtf8(benchmark::State& state)
+{
+	SIMD::Level previous;
+	if (!SetLevel(state, previous))
+		return;
+
+	const std::string text = CreateUtf8Text(static_cast<TextKind>(state.range(1)));
+	for (auto _ : state)
+		benchmark::DoNotOptimize(Unicode::ValidateUtf8(text.data(), text.size()));
+
+	SIMD::LevelOverride() = previous;
+	state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK(BM_ValidateUtf8)->Apply(TextArguments);
+
+/**
+ * Convert UTF-8 to UTF-16 or UTF-32.
+ */
+template<class Unit>
+static void BM_Utf8ToWide(benchmark::State& state)
+{
+	SIMD::Level previous;
+	if (!SetLevel(state, previous))
+		return;
+
+	const std::string text = CreateUtf8Text(static_cast<TextKind>(state.range(1)));
+	std::vector<Unit> output(text.size());
+	for (auto _ : state)
+		benchmark::DoNotOptimize(Unicode::Utf8ToWide(text.data(), text.size(), output.data()));
+
+	SIMD::LevelOverride() = previous;
+	state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK_TEMPLATE(BM_Utf8ToWide, char16_t)->Apply(TextArguments);
+BENCHMARK_TEMPLATE(BM_Utf8ToWide, char32_t)->Apply(TextArguments);
+
+/**
+ * Convert UTF-16 or UTF-32 to UTF-8.
+ */
+template<class Unit>
+static void BM_WideToUtf8(benchmark::State& state)
+{
+	SIMD::Level previous;
+	if (!SetLevel(state, previous))
+		return;
+
+	const std::string text = CreateUtf8Text(static_cast<TextKind>(state.range(1)));
+	std::basic_string<Unit> wide;
+	Unicode::FromUtf8(text, wide);
+
+	std::vector<char> output(wide.size() * 4);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(Unicode::WideToUtf8(wide.data(), wide.size(), output.data()));
+
+	SIMD::LevelOverride() = previous;
+	state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK_TEMPLATE(BM_WideToUtf8, char16_t)->Apply(TextArguments);
+BENCHMARK_TEMPLATE(BM_WideToUtf8, char32_t)->Apply(TextArguments);
+
+/**
+ * Convert UTF-8 to wchar_t using the C runtime (mbstowcs) for reference.
+ */
+static void BM_StandardUtf8ToWide(benchmark::State& state)
+{
+#ifdef _MSC_VER
+	std::setlocale(LC_ALL, ".UTF8");
+
+#else
+	std::setlocale(LC_ALL, "C.UTF-8");
+
+#endif // _MSC_VER
+
+	const std::string text = CreateUtf8Text(static_cast<TextKind>(state.range(0)));
+	std::vector<wchar_t> output(text.size() + 1);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(std::mbstowcs(output.data(), text.c_str(), output.size()));
+
+	std::setlocale(LC_ALL, "C");
+	state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK(BM_StandardUtf8ToWide)->ArgName("text")->DenseRange(0, static_cast<int64_t>(TextKind::Mixed));
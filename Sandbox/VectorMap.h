@@ -1,7 +1,29 @@
 #pragma once
 
+#include "SIMD.h"
+
 #include <vector>
 #include <algorithm>
+#include <iterator>
+
+/**
+ * Duplicate policy of the VectorMap bulk operations which keeps the value of the first entry with a key (the entry
+ * already in the map, or the first one in the batch). This is how insert() behaves.
+ */
+struct KeepFirstDuplicate
+{
+	template<typename V>
+	void operator()(V& /*kept*/, const V& /*duplicate*/) const {}
+};
+
+/**
+ * Duplicate policy of the VectorMap bulk operations which keeps the value of the last entry with a key.
+ */
+struct KeepLastDuplicate
+{
+	template<typename V>
+	void operator()(V& kept, V& duplicate) const { kept = std::move(duplicate); }
+};
 
 template<typename K, typename V, typename T = std::less<K>, typename A = std::allocator<std::pair<const K, V>>>
 class VectorMap : private T // Empty base optimization
@@ -31,6 +53,13 @@ public:
 			return m_comp(left.first, right.first);
 		}
 
+		// The entries are stored as none_const_value_type, which would otherwise be converted (copied) to value_type
+		// for every comparison.
+		bool operator()(const none_const_value_type& left, const none_const_value_type& right) const
+		{
+			return m_comp(left.first, right.first);
+		}
+
 	private:
 		const key_compare& m_comp;
 	};
@@ -46,10 +75,21 @@ public:
 	typedef const value_type* const_pointer;
 	typedef typename std::allocator_traits<allocator_type>::size_type size_type;
 
+	// Containers of the frozen layout (see freeze()).
+	typedef std::vector<key_type, typename std::allocator_traits<A>::template rebind_alloc<key_type>> frozen_key_container_type;
+	typedef std::vector<size_type, typename std::allocator_traits<A>::template rebind_alloc<size_type>> frozen_index_container_type;
+
 	VectorMap()
 	{
 	}
 
+	explicit VectorMap(const allocator_type& alloc)
+		: m_entries(alloc),
+		m_frozenKeys(alloc),
+		m_frozenIndices(alloc)
+	{
+	}
+
 	explicit VectorMap(const key_compare& comp)
 		: key_compare(comp)
 	{
@@ -57,19 +97,24 @@ public:
 
 	explicit VectorMap(const key_compare& comp, const allocator_type& alloc)
 		: key_compare(comp),
-		m_entries(alloc)
+		m_entries(alloc),
+		m_frozenKeys(alloc),
+		m_frozenIndices(alloc)
 	{
 	}
 
 	VectorMap(const VectorMap& right)
 		: key_compare(right),
-		m_entries(right.m_entries)
+		m_entries(right.m_entries),
+		m_frozenKeys(right.m_frozenKeys),
+		m_frozenIndices(right.m_frozenIndices)
 	{
 	}
 	template<class InputIterator> VectorMap(InputIterator first, InputIterator last);
 	template<class InputIterator> VectorMap(InputIterator first, InputIterator last, const key_compare& comp);
 	template<class InputIterator> VectorMap(InputIterator first, InputIterator last, const key_compare& comp, const allocator_type& alloc);
 	void                                      SwapElementsWithVector(container_type& elementVector);
+	template<class InputIterator, class Policy = KeepFirstDuplicate> void assignFromUnsorted(InputIterator first, InputIterator last, Policy policy = Policy());
 	iterator                                  begin();
 	const_iterator                            begin() const;
 	size_type                                 capacity() const;
@@ -87,10 +132,14 @@ public:
 	template<typename Predicate> void         erase_if(const Predicate& predicate);
 	iterator                                  find(const key_type& key);
 	const_iterator                            find(const key_type& key) const;
+	void                                      freeze();
 	allocator_type                            get_allocator() const;
 	std::pair<iterator, bool>                 insert(const value_type& val);
 	iterator                                  insert(iterator where, const value_type& val);
 	template<class InputIterator> void        insert(InputIterator first, InputIterator last);
+	template<class InputIterator, class Policy = KeepFirstDuplicate> void insertSorted(InputIterator first, InputIterator last, Policy policy = Policy());
+	template<class InputIterator, class Policy = KeepFirstDuplicate> void insertUnsorted(InputIterator first, InputIterator last, Policy policy = Policy());
+	bool                                      isFrozen() const;
 	key_compare                               key_comp() const;
 	iterator                                  lower_bound(const key_type& key);
 	const_iterator                            lower_bound(const key_type& key) const;
@@ -102,6 +151,7 @@ public:
 	void                                      reserve(size_type count);
 	size_type                                 size() const;
 	void                                      swap(VectorMap& other);
+	void                                      unfreeze();
 	iterator                                  upper_bound(const key_type& key);
 	const_iterator                            upper_bound(const key_type& key) const;
 	mapped_type& operator[](const key_type& key);
@@ -112,44 +162,68 @@ public:
 		pSizer->AddObject(m_entries);
 	}
 private:
+	template<class Policy> void               collapseDuplicates(container_type& entries, Policy& policy) const;
+	template<class Policy> void               mergeBatch(container_type& batch, Policy& policy);
+	size_type                                 freezeNode(size_type sortedIndex, size_type node);
+	size_type                                 frozenLowerBound(const key_type& key) const;
+
 	container_type m_entries;
+	frozen_key_container_type m_frozenKeys;			// The keys in Eytzinger order, from index 1. Empty if not frozen.
+	frozen_index_container_type m_frozenIndices;	// The index of the entry of each frozen key.
 };
 
 
 template<typename K, typename V, typename T, typename A>
 template<class InputIterator> VectorMap<K, V, T, A>::VectorMap(InputIterator first, InputIterator last)
 {
-	for (; first != last; ++first)
-		m_entries.push_back(*first);
-	std::sort(m_entries.begin(), m_entries.end(), FirstLess(static_cast<key_compare>(*this)));
+	assignFromUnsorted(first, last);
 }
 
 template<typename K, typename V, typename T, typename A>
 template<class InputIterator> VectorMap<K, V, T, A>::VectorMap(InputIterator first, InputIterator last, const key_compare& comp)
 	: key_compare(comp)
 {
-	for (; first != last; ++first)
-		m_entries.push_back(*first);
-	std::sort(m_entries.begin(), m_entries.end(), FirstLess(static_cast<key_compare>(*this)));
+	assignFromUnsorted(first, last);
 }
 
 template<typename K, typename V, typename T, typename A>
 template<class InputIterator> VectorMap<K, V, T, A>::VectorMap(InputIterator first, InputIterator last, const key_compare& comp, const allocator_type& alloc)
 	: key_compare(comp),
-	m_entries(alloc)
+	m_entries(alloc),
+	m_frozenKeys(alloc),
+	m_frozenIndices(alloc)
 {
-	for (; first != last; ++first)
-		m_entries.push_back(*first);
-	std::sort(m_entries.begin(), m_entries.end(), FirstLess(static_cast<key_compare>(*this)));
+	assignFromUnsorted(first, last);
 }
 
 template<typename K, typename V, typename T, typename A>
 void VectorMap<K, V, T, A >::SwapElementsWithVector(typename VectorMap<K, V, T, A>::container_type& elementVector)
 {
+	unfreeze();
 	m_entries.swap(elementVector);
 	std::sort(m_entries.begin(), m_entries.end(), FirstLess(static_cast<key_compare>(*this)));
 }
 
+/**
+ * Replace the entries with a batch in any order. The batch is sorted once, so this takes O(m log m) for m entries.
+ *
+ * @param first: The first entry of the batch.
+ * @param last: The end of the batch.
+ * @param policy: The duplicate policy, called with the value which is kept and the value of a later entry with the
+ *	same key, in batch order. KeepFirstDuplicate, KeepLastDuplicate, or a function which combines the values.
+ */
+template<typename K, typename V, typename T, typename A>
+template<class InputIterator, class Policy> void VectorMap<K, V, T, A >::assignFromUnsorted(InputIterator first, InputIterator last, Policy policy)
+{
+	unfreeze();
+	m_entries.clear();
+	m_entries.insert(m_entries.end(), first, last);
+
+	// The sort must be stable so that the policy sees the duplicates in batch order.
+	std::stable_sort(m_entries.begin(), m_entries.end(), FirstLess(static_cast<const key_compare&>(*this)));
+	collapseDuplicates(m_entries, policy);
+}
+
 template<typename K, typename V, typename T, typename A>
 typename VectorMap<K, V, T, A>::iterator VectorMap<K, V, T, A >::begin()
 {
@@ -165,6 +239,7 @@ typename VectorMap<K, V, T, A>::const_iterator VectorMap<K, V, T, A >::begin() c
 template<typename K, typename V, typename T, typename A>
 void VectorMap<K, V, T, A >::clear()
 {
+	unfreeze();
 	m_entries.resize(0);
 }
 
@@ -172,6 +247,7 @@ template<typename K, typename V, typename T, typename A>
 void VectorMap<K, V, T, A >::clearAndFreeMemory()
 {
 	//stl::free_container(m_entries);
+	unfreeze();
 	m_entries.clear();
 }
 
@@ -184,7 +260,7 @@ typename VectorMap<K, V, T, A>::size_type VectorMap<K, V, T, A >::capacity() con
 template<typename K, typename V, typename T, typename A>
 typename VectorMap<K, V, T, A>::size_type VectorMap<K, V, T, A >::count(const key_type& key) const
 {
-	return size_type(std::binary_search(m_entries.begin(), m_entries.end(), value_type(key, mapped_type()), static_cast<key_compare>(*this)));
+	return size_type(find(key) != m_entries.end());
 }
 
 template<typename K, typename V, typename T, typename A>
@@ -232,6 +308,7 @@ std::pair<typename VectorMap<K, V, T, A>::const_iterator, typename VectorMap<K,
 template<typename K, typename V, typename T, typename A>
 typename VectorMap<K, V, T, A>::iterator VectorMap<K, V, T, A >::erase(iterator where)
 {
+	unfreeze();
 	return m_entries.erase(where);
 }
 
@@ -239,28 +316,41 @@ template<typename K, typename V, typename T, typename A>
 template<typename Predicate>
 void VectorMap<K, V, T, A >::erase_if(const Predicate& predicate)
 {
+	unfreeze();
+
+	// Removing entries keeps the order of the others, so the entries are still sorted.
 	m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), predicate), m_entries.end());
-	std::sort(m_entries.begin(), m_entries.end(), FirstLess(static_cast<key_compare>(*this)));
 }
 
 template<typename K, typename V, typename T, typename A>
 typename VectorMap<K, V, T, A>::iterator VectorMap<K, V, T, A >::erase(iterator first, iterator last)
 {
+	unfreeze();
 	return m_entries.erase(first, last);
 }
 
 template<typename K, typename V, typename T, typename A>
 void VectorMap<K, V, T, A >::erase(const key_type& key)
 {
-	iterator where = lower_bound(key);
+	iterator where = find(key);
 
 	if (where != m_entries.end())
-		m_entries.erase(where);
+		erase(where);
 }
 
 template<typename K, typename V, typename T, typename A>
 typename VectorMap<K, V, T, A>::iterator VectorMap<K, V, T, A >::find(const key_type& key)
 {
+	// The frozen keys are compared directly, so missing keys do not touch the entries.
+	if (isFrozen())
+	{
+		const size_type node = frozenLowerBound(key);
+		if (node == 0 || key_compare::operator()(key, m_frozenKeys[node]))
+			return m_entries.end();
+
+		return m_entries.begin() + m_frozenIndices[node];
+	}
+
 	iterator it = lower_bound(key);
 	if (it != m_entries.end() && key_compare::operator()(key, (*it).first))
 		it = m_entries.end();
@@ -270,12 +360,50 @@ typename VectorMap<K, V, T, A>::iterator VectorMap<K, V, T, A >::find(const key_
 template<typename K, typename V, typename T, typename A>
 typename VectorMap<K, V, T, A>::const_iterator VectorMap<K, V, T, A >::find(const key_type& key) const
 {
+	// The frozen keys are compared directly, so missing keys do not touch the entries.
+	if (isFrozen())
+	{
+		const size_type node = frozenLowerBound(key);
+		if (node == 0 || key_compare::operator()(key, m_frozenKeys[node]))
+			return m_entries.end();
+
+		return m_entries.begin() + m_frozenIndices[node];
+	}
+
 	const_iterator it = lower_bound(key);
 	if (it != m_entries.end() && key_compare::operator()(key, (*it).first))
 		it = m_entries.end();
 	return it;
 }
 
+/**
+ * Freeze the map for read-mostly use. This copies the keys into an Eytzinger (breadth first) layout, where the
+ * children of the key at index i are at 2i and 2i + 1. The first levels of the search then share a few cache lines,
+ * and the keys four levels below are contiguous and can be prefetched while the current level is compared, so
+ * lookups on large maps take far fewer cache misses than a binary search over the entries.
+ *
+ * The layout takes another key and index per entry. Any insertion or removal unfreezes the map, so the layout is
+ * only worth building for maps which are looked up many times between modifications. Empty maps are not frozen.
+ */
+template<typename K, typename V, typename T, typename A>
+void VectorMap<K, V, T, A >::freeze()
+{
+	unfreeze();
+
+	const size_type count = m_entries.size();
+	if (count == 0)
+		return;
+
+	m_frozenIndices.assign(count + 1, 0);
+	freezeNode(0, 1);
+
+	// Index 0 is not a part of the tree, so it holds a copy of the first key to keep the tree at index 1.
+	m_frozenKeys.reserve(count + 1);
+	m_frozenKeys.push_back(m_entries.front().first);
+	for (size_type node = 1; node <= count; node++)
+		m_frozenKeys.push_back(m_entries[m_frozenIndices[node]].first);
+}
+
 template<typename K, typename V, typename T, typename A>
 typename VectorMap<K, V, T, A>::allocator_type VectorMap<K, V, T, A >::get_allocator() const
 {
@@ -288,7 +416,10 @@ std::pair<typename VectorMap<K, V, T, A>::iterator, bool> VectorMap<K, V, T, A >
 	iterator it = lower_bound(val.first);
 	bool insertionMade = false;
 	if (it == m_entries.end() || key_compare::operator()(val.first, (*it).first))
+	{
+		unfreeze();
 		it = m_entries.insert(it, val), insertionMade = true;
+	}
 	return std::make_pair(it, insertionMade);
 }
 
@@ -301,8 +432,48 @@ typename VectorMap<K, V, T, A>::iterator VectorMap<K, V, T, A >::insert(iterator
 template<typename K, typename V, typename T, typename A>
 template<class InputIterator> void VectorMap<K, V, T, A >::insert(InputIterator first, InputIterator last)
 {
-	for (; first != last; ++first)
-		insert(*first);
+	insertUnsorted(first, last);
+}
+
+/**
+ * Insert a batch which is sorted by key. The batch is merged with the entries in a single pass, so this takes
+ * O(n + m) for n entries and a batch of m entries, rather than O(n * m) when inserting one entry at a time.
+ *
+ * @param first: The first entry of the batch.
+ * @param last: The end of the batch.
+ * @param policy: The duplicate policy, called with the value which is kept and the value of a later entry with the
+ *	same key. Entries already in the map come before the batch.
+ */
+template<typename K, typename V, typename T, typename A>
+template<class InputIterator, class Policy> void VectorMap<K, V, T, A >::insertSorted(InputIterator first, InputIterator last, Policy policy)
+{
+	container_type batch(first, last, m_entries.get_allocator());
+	collapseDuplicates(batch, policy);
+	mergeBatch(batch, policy);
+}
+
+/**
+ * Insert a batch in any order. The batch is sorted once and then merged with the entries in a single pass, so this
+ * takes O(m log m + n) for n entries and a batch of m entries.
+ *
+ * @param first: The first entry of the batch.
+ * @param last: The end of the batch.
+ * @param policy: The duplicate policy, called with the value which is kept and the value of a later entry with the
+ *	same key. Entries already in the map come before the batch, and the batch entries are in batch order.
+ */
+template<typename K, typename V, typename T, typename A>
+template<class InputIterator, class Policy> void VectorMap<K, V, T, A >::insertUnsorted(InputIterator first, InputIterator last, Policy policy)
+{
+	container_type batch(first, last, m_entries.get_allocator());
+	std::stable_sort(batch.begin(), batch.end(), FirstLess(static_cast<const key_compare&>(*this)));
+	collapseDuplicates(batch, policy);
+	mergeBatch(batch, policy);
+}
+
+template<typename K, typename V, typename T, typename A>
+bool VectorMap<K, V, T, A >::isFrozen() const
+{
+	return !m_frozenKeys.empty();
 }
 
 template<typename K, typename V, typename T, typename A>
@@ -314,13 +485,18 @@ typename VectorMap<K, V, T, A>::key_compare VectorMap<K, V, T, A >::key_comp() c
 template<typename K, typename V, typename T, typename A>
 typename VectorMap<K, V, T, A>::iterator VectorMap<K, V, T, A >::lower_bound(const key_type& key)
 {
-	int count = 0;
-	count = m_entries.size();
+	if (isFrozen())
+	{
+		const size_type node = frozenLowerBound(key);
+		return m_entries.begin() + (node ? m_frozenIndices[node] : m_entries.size());
+	}
+
+	size_type count = m_entries.size();
 	iterator first = m_entries.begin();
 	for (; 0 < count; )
 	{
 		// divide and conquer, find half that contains answer
-		int count2 = count / 2;
+		size_type count2 = count / 2;
 		iterator mid = first + count2;
 
 		if (key_compare::operator()(mid->first, key))
@@ -334,13 +510,18 @@ typename VectorMap<K, V, T, A>::iterator VectorMap<K, V, T, A >::lower_bound(con
 template<typename K, typename V, typename T, typename A>
 typename VectorMap<K, V, T, A>::const_iterator VectorMap<K, V, T, A >::lower_bound(const key_type& key) const
 {
-	int count = 0;
-	count = m_entries.size();
+	if (isFrozen())
+	{
+		const size_type node = frozenLowerBound(key);
+		return m_entries.begin() + (node ? m_frozenIndices[node] : m_entries.size());
+	}
+
+	size_type count = m_entries.size();
 	const_iterator first = m_entries.begin();
 	for (; 0 < count; )
 	{
 		// divide and conquer, find half that contains answer
-		int count2 = count / 2;
+		size_type count2 = count / 2;
 		const_iterator mid = first + count2;
 
 		if (key_compare::operator()(mid->first, key))
@@ -397,9 +578,24 @@ template<typename K, typename V, typename T, typename A>
 void VectorMap<K, V, T, A >::swap(VectorMap& other)
 {
 	m_entries.swap(other.m_entries);
+	m_frozenKeys.swap(other.m_frozenKeys);
+	m_frozenIndices.swap(other.m_frozenIndices);
 	std::swap(static_cast<key_compare&>(*this), static_cast<key_compare&>(other));
 }
 
+/**
+ * Drop the frozen layout, if any. The memory of the layout is released.
+ */
+template<typename K, typename V, typename T, typename A>
+void VectorMap<K, V, T, A >::unfreeze()
+{
+	if (isFrozen())
+	{
+		frozen_key_container_type(m_frozenKeys.get_allocator()).swap(m_frozenKeys);
+		frozen_index_container_type(m_frozenIndices.get_allocator()).swap(m_frozenIndices);
+	}
+}
+
 template<typename K, typename V, typename T, typename A>
 typename VectorMap<K, V, T, A>::iterator VectorMap<K, V, T, A >::upper_bound(const key_type& key)
 {
@@ -412,7 +608,7 @@ typename VectorMap<K, V, T, A>::iterator VectorMap<K, V, T, A >::upper_bound(con
 template<typename K, typename V, typename T, typename A>
 typename VectorMap<K, V, T, A>::const_iterator VectorMap<K, V, T, A >::upper_bound(const key_type& key) const
 {
-	iterator upper = lower_bound(key);
+	const_iterator upper = lower_bound(key);
 	if (upper != m_entries.end() && !key_compare::operator()(key, (*upper).first))
 		++upper;
 	return upper;
@@ -425,4 +621,116 @@ typename VectorMap<K, V, T, A>::mapped_type& VectorMap<K, V, T, A >::operator[](
 	if (it == m_entries.end())
 		it = insert(value_type(key, mapped_type())).first;
 	return (*it).second;
-}
\ No newline at end of file
+}
+
+/**
+ * Collapse the entries of a sorted container which have the same key into the first one.
+ *
+ * @param entries: The entries, sorted by key.
+ * @param policy: The duplicate policy.
+ */
+template<typename K, typename V, typename T, typename A>
+template<class Policy> void VectorMap<K, V, T, A >::collapseDuplicates(container_type& entries, Policy& policy) const
+{
+	if (entries.empty())
+		return;
+
+	size_type kept = 0;
+	for (size_type index = 1; index < entries.size(); index++)
+	{
+		if (key_compare::operator()(entries[kept].first, entries[index].first))
+		{
+			if (++kept != index)
+				entries[kept] = std::move(entries[index]);
+		}
+		else
+		{
+			policy(entries[kept].second, entries[index].second);
+		}
+	}
+
+	entries.erase(entries.begin() + kept + 1, entries.end());
+}
+
+/**
+ * Merge a sorted batch without duplicate keys into the entries.
+ * Keys which are already in the map are passed to the policy and dropped from the batch in a single forward pass.
+ * The rest of the batch is then appended and merged in place, which is linear when the merge buffer can be allocated.
+ *
+ * @param batch: The batch, sorted by key and without duplicates. The entries are moved from.
+ * @param policy: The duplicate policy.
+ */
+template<typename K, typename V, typename T, typename A>
+template<class Policy> void VectorMap<K, V, T, A >::mergeBatch(container_type& batch, Policy& policy)
+{
+	iterator existing = m_entries.begin();
+	size_type kept = 0;
+	for (size_type index = 0; index < batch.size(); index++)
+	{
+		while (existing != m_entries.end() && key_compare::operator()(existing->first, batch[index].first))
+			++existing;
+
+		if (existing != m_entries.end() && !key_compare::operator()(batch[index].first, existing->first))
+			policy(existing->second, batch[index].second);
+		else if (kept++ != index)
+			batch[kept - 1] = std::move(batch[index]);
+	}
+
+	if (kept == 0)
+		return;
+
+	unfreeze();
+	const size_type count = m_entries.size();
+	m_entries.insert(m_entries.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.begin() + kept));
+
+	// Batches of keys which are larger than every entry (appending in order) do not need to be merged.
+	const iterator middle = m_entries.begin() + count;
+	if (count != 0 && key_compare::operator()(middle->first, (middle - 1)->first))
+		std::inplace_merge(m_entries.begin(), middle, m_entries.end(), FirstLess(static_cast<const key_compare&>(*this)));
+}
+
+/**
+ * Fill the entry indexes of a subtree of the frozen layout, visiting the nodes in order.
+ * Returns the next entry index. The recursion depth is the height of the tree (log2 of the size).
+ *
+ * @param sortedIndex: The index of the first entry of the subtree.
+ * @param node: The root of the subtree.
+ */
+template<typename K, typename V, typename T, typename A>
+typename VectorMap<K, V, T, A>::size_type VectorMap<K, V, T, A >::freezeNode(size_type sortedIndex, size_type node)
+{
+	if (node >= m_frozenIndices.size())
+		return sortedIndex;
+
+	sortedIndex = freezeNode(sortedIndex, 2 * node);
+	m_frozenIndices[node] = sortedIndex++;
+	return freezeNode(sortedIndex, 2 * node + 1);
+}
+
+/**
+ * Find the node of the frozen layout with the first key which is not less than a key, or 0 if there is none.
+ *
+ * @param key: The key.
+ */
+template<typename K, typename V, typename T, typename A>
+typename VectorMap<K, V, T, A>::size_type VectorMap<K, V, T, A >::frozenLowerBound(const key_type& key) const
+{
+	// The number of keys in a cache line, rounded down to a power of two. The descendants of a node this many
+	// levels down are contiguous, so prefetching them hides the miss of every level after the first few.
+	constexpr size_type KeysPerLine = [] { size_type keys = 1; while (keys * 2 * sizeof(key_type) <= 64) keys *= 2; return keys; }();
+
+	const size_type count = m_entries.size();
+	const key_type* pKeys = m_frozenKeys.data();
+
+	// Walk down the tree without branching on the comparison: go right if the key is larger than the node.
+	size_type node = 1;
+	while (node <= count)
+	{
+		SIMD::Prefetch(reinterpret_cast<uintptr_t>(pKeys) + node * KeysPerLine * sizeof(key_type));
+		node = 2 * node + static_cast<size_type>(key_compare::operator()(pKeys[node], key));
+	}
+
+	// The path ends with a right turn for every key less than the key, after the last left turn at the lower
+	// bound. Dropping the right turns and the left turn gives the node of the lower bound.
+	return node >> (SIMD::CountTrailingZeros(~static_cast<uint64_t>(node)) + 1);
+}
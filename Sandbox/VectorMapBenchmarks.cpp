@@ -0,0 +1,276 @@
+#include "IntegralVectorMap.h"
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include <random>
+
+/**
+ * Create a batch of random keys and values. About 1 key in 20 is a duplicate.
+ *
+ * @param count: The number of entries.
+ * @param seed: The seed of the random engine.
+ */
+static std::vector<std::pair<int, int>> CreateBatch(size_t count, uint32_t seed = 0)
+{
+	std::mt19937 engine(seed);
+	std::uniform_int_distribution<int> distribution(0, static_cast<int>(count * 10));
+
+	std::vector<std::pair<int, int>> batch(count);
+	for (size_t index = 0; index < count; index++)
+		batch[index] = { distribution(engine), static_cast<int>(index) };
+
+	return batch;
+}
+
+/**
+ * Load a vector map one entry at a time. Every insertion moves the entries after it, so this is O(n^2) and is only
+ * run up to 64K entries (1M entries would take minutes).
+ */
+static void BM_VectorMapLoadPerElement(benchmark::State& state)
+{
+	const auto batch = CreateBatch(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		VectorMap<int, int> map;
+		for (const auto& entry : batch)
+			map.insert(entry);
+
+		benchmark::DoNotOptimize(map.begin());
+	}
+
+	state.SetItemsProcessed(state.iterations() * batch.size());
+}
+
+BENCHMARK(BM_VectorMapLoadPerElement)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+/**
+ * Load a vector map using insertUnsorted, which sorts the batch once and merges it.
+ */
+static void BM_VectorMapLoadInsertUnsorted(benchmark::State& state)
+{
+	const auto batch = CreateBatch(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		VectorMap<int, int> map;
+		map.insertUnsorted(batch.begin(), batch.end());
+
+		benchmark::DoNotOptimize(map.begin());
+	}
+
+	state.SetItemsProcessed(state.iterations() * batch.size());
+}
+
+BENCHMARK(BM_VectorMapLoadInsertUnsorted)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+/**
+ * Load a vector map using assignFromUnsorted, which sorts the entries in place without a separate batch.
+ */
+static void BM_VectorMapLoadAssignFromUnsorted(benchmark::State& state)
+{
+	const auto batch = CreateBatch(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		VectorMap<int, int> map;
+		map.assignFromUnsorted(batch.begin(), batch.end());
+
+		benchmark::DoNotOptimize(map.begin());
+	}
+
+	state.SetItemsProcessed(state.iterations() * batch.size());
+}
+
+BENCHMARK(BM_VectorMapLoadAssignFromUnsorted)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+/**
+ * Load a std::map for reference.
+ */
+static void BM_StandardMapLoad(benchmark::State& state)
+{
+	const auto batch = CreateBatch(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		std::map<int, int> map(batch.begin(), batch.end());
+		benchmark::DoNotOptimize(map.begin());
+	}
+
+	state.SetItemsProcessed(state.iterations() * batch.size());
+}
+
+BENCHMARK(BM_StandardMapLoad)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+/**
+ * Merge a batch of 1/16th of the size into a loaded vector map.
+ */
+static void BM_VectorMapMergeBatch(benchmark::State& state)
+{
+	VectorMap<int, int> loaded;
+	const auto entries = CreateBatch(static_cast<size_t>(state.range(0)));
+	loaded.assignFromUnsorted(entries.begin(), entries.end());
+
+	const auto batch = CreateBatch(entries.size() / 16, 1);
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		VectorMap<int, int> map = loaded;
+		state.ResumeTiming();
+
+		map.insertUnsorted(batch.begin(), batch.end());
+		benchmark::DoNotOptimize(map.begin());
+	}
+
+	state.SetItemsProcessed(state.iterations() * batch.size());
+}
+
+BENCHMARK(BM_VectorMapMergeBatch)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+/**
+ * Merge a batch of 1/16th of the size into a loaded std::map for reference.
+ */
+static void BM_StandardMapMergeBatch(benchmark::State& state)
+{
+	const auto entries = CreateBatch(static_cast<size_t>(state.range(0)));
+	const std::map<int, int> loaded(entries.begin(), entries.end());
+
+	const auto batch = CreateBatch(entries.size() / 16, 1);
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		std::map<int, int> map = loaded;
+		state.ResumeTiming();
+
+		map.insert(batch.begin(), batch.end());
+		benchmark::DoNotOptimize(map.begin());
+	}
+
+	state.SetItemsProcessed(state.iterations() * batch.size());
+}
+
+BENCHMARK(BM_StandardMapMergeBatch)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+/**
+ * Look up random keys, half of which are in the map, in the sorted layout (frozen = 0) or the Eytzinger layout
+ * (frozen = 1).
+ */
+static void BM_VectorMapLookup(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	// The keys are even, so the odd queries miss.
+	VectorMap<int64_t, int64_t>::container_type entries(count);
+	for (size_t index = 0; index < count; index++)
+		entries[index] = { static_cast<int64_t>(index) * 2, static_cast<int64_t>(index) };
+
+	VectorMap<int64_t, int64_t> map;
+	map.SwapElementsWithVector(entries);
+	if (state.range(1))
+		map.freeze();
+
+	std::mt19937_64 engine(0);
+	std::vector<int64_t> queries(1 << 12);
+	for (auto& query : queries)
+		query = static_cast<int64_t>(engine() % (count * 2));
+
+	for (auto _ : state)
+	{
+		for (const auto query : queries)
+			benchmark::DoNotOptimize(map.find(query));
+	}
+
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+BENCHMARK(BM_VectorMapLookup)->ArgNames({ "size", "frozen" })->ArgsProduct({ { 1000, 10000, 100000, 1000000, 10000000, 100000000 }, { 0, 1 } });
+
+/**
+ * Set the instruction set level of a benchmark (the first argument). Returns false if the CPU does not support it.
+ *
+ * @param state: The benchmark state.
+ * @param previous: The variable to store the previous level in.
+ */
+static bool SetLevel(benchmark::State& state, SIMD::Level& previous)
+{
+	previous = SIMD::LevelOverride();
+	SIMD::LevelOverride() = static_cast<SIMD::Level>(state.range(0));
+	if (SIMD::GetLevel() == SIMD::LevelOverride())
+		return true;
+
+	SIMD::LevelOverride() = previous;
+	state.SkipWithError("The instruction set level is not supported by this CPU.");
+	return false;
+}
+
+/**
+ * Create random queries for integer keys 0, 2, 4... of which half are in the map.
+ *
+ * @param count: The number of keys in the map.
+ */
+template<class Key>
+static std::vector<Key> CreateQueries(size_t count)
+{
+	std::mt19937_64 engine(0);
+	std::vector<Key> queries(1 << 12);
+	for (auto& query : queries)
+		query = static_cast<Key>(engine() % (count * 2));
+
+	return queries;
+}
+
+/**
+ * Look up integer keys in a vector map, for reference.
+ */
+template<class Key>
+static void BM_VectorMapFindInteger(benchmark::State& state)
+{
+	const size_t count = static_cast<size_t>(state.range(0));
+
+	typename VectorMap<Key, Key>::container_type entries(count);
+	for (size_t index = 0; index < count; index++)
+		entries[index] = { static_cast<Key>(index * 2), static_cast<Key>(index) };
+
+	VectorMap<Key, Key> map;
+	map.SwapElementsWithVector(entries);
+
+	const auto queries = CreateQueries<Key>(count);
+	for (auto _ : state)
+	{
+		for (const auto query : queries)
+			benchmark::DoNotOptimize(map.find(query));
+	}
+
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+BENCHMARK_TEMPLATE(BM_VectorMapFindInteger, int32_t)->ArgName("size")->RangeMultiplier(16)->Range(64, 1 << 20);
+BENCHMARK_TEMPLATE(BM_VectorMapFindInteger, int64_t)->ArgName("size")->RangeMultiplier(16)->Range(64, 1 << 20);
+
+/**
+ * Look up integer keys in an integral vector map at the scalar, SSE4.2, AVX2 and AVX-512 levels.
+ */
+template<class Key>
+static void BM_IntegralVectorMapFind(benchmark::State& state)
+{
+	SIMD::Level previous;
+	if (!SetLevel(state, previous))
+		return;
+
+	const size_t count = static_cast<size_t>(state.range(1));
+
+	std::vector<std::pair<Key, Key>> entries(count);
+	for (size_t index = 0; index < count; index++)
+		entries[index] = { static_cast<Key>(index * 2), static_cast<Key>(index) };
+
+	const IntegralVectorMap<Key, Key> map(entries.begin(), entries.end());
+
+	const auto queries = CreateQueries<Key>(count);
+	for (auto _ : state)
+	{
+		for (const auto query : queries)
+			benchmark::DoNotOptimize(map.find(query));
+	}
+
+	SIMD::LevelOverride() = previous;
+	state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+BENCHMARK_TEMPLATE(BM_IntegralVectorMapFind, int32_t)->ArgNames({ "level", "size" })->ArgsProduct({ { 0, 1, 2, 3 }, { 64, 1024, 16384, 262144, 1 << 20 } });
+BENCHMARK_TEMPLATE(BM_IntegralVectorMapFind, int64_t)->ArgNames({ "level", "size" })->ArgsProduct({ { 0, 1, 2, 3 }, { 64, 1024, 16384, 262144, 1 << 20 } });